@@ -3,27 +3,15 @@
 typedef int Foo;
 typedef int Bar;
 
-ecs_vector_params_t entity_params = {
-    .element_size = sizeof(ecs_entity_t)
-};
-
-void GetChildren(ecs_rows_t *rows) {
-    ecs_vector_t **children = rows->param;
-
-    for (int i = 0; i < rows->count; i ++) {
-        ecs_entity_t *elem = ecs_vector_add(
-            children, 
-            &entity_params);
-        
-        *elem = rows->entities[i];
-    }
-}
-
-void print_children(ecs_world_t *world, const char *parent_id, ecs_vector_t *children) {
-    ecs_entity_t *array = ecs_vector_first(children);
-
-    for (int i = 0; i < ecs_vector_count(children); i ++) {
-        printf("Child found: '%s.%s'\n", parent_id, ecs_get_id(world, array[i]));
+void print_children(ecs_world_t *world, const char *parent_id, ecs_entity_t parent) {
+    /* Only the tables that contain children of the parent are iterated */
+    ecs_children_iter_t it = ecs_children_iter(world, parent);
+
+    while (ecs_children_next(&it)) {
+        for (int i = 0; i < it.rows.count; i ++) {
+            printf("Child found: '%s.%s'\n", 
+                parent_id, ecs_get_id(world, it.rows.entities[i]));
+        }
     }
 }
 
@@ -35,16 +23,10 @@ int main(int argc, char *argv[]) {
     ECS_COMPONENT(world, Foo);
     ECS_COMPONENT(world, Bar);
 
-    ECS_SYSTEM(world, GetChildren, EcsManual, EcsId);
-
     /* Create two parents */
     ecs_entity_t parent_1 = ecs_new(world, 0);
     ecs_entity_t parent_2 = ecs_new(world, 0);
 
-    /* Get type variables for parents so they can be used as filter */
-    ecs_type_t ecs_type(parent_1) = ecs_type_from_entity(world, parent_1);
-    ecs_type_t ecs_type(parent_2) = ecs_type_from_entity(world, parent_2);
-
     /* Create two children for each parent */
     ecs_entity_t child_1_1 = ecs_new_child(world, parent_1, Foo);
     ecs_entity_t child_1_2 = ecs_new_child(world, parent_1, Bar);
@@ -58,27 +40,13 @@ int main(int argc, char *argv[]) {
     ecs_set(world, child_2_1, EcsId, {"child_2_1"});
     ecs_set(world, child_2_2, EcsId, {"child_2_2"});
 
-    /* Create vector to store child entities */
-    ecs_vector_t *children = ecs_vector_new(&entity_params, 0);
-
-    /* Collect children for parent_1 */
-    ecs_run_w_filter(world, GetChildren, 0, 0, 0, 
-        parent_1,
-        &children);
-
-    print_children(world, "parent_1", children);
+    /* Print children for parent_1 */
+    print_children(world, "parent_1", parent_1);
     printf("---\n");
 
-    ecs_vector_clear(children);
-
-    /* Collect children for parent_2 */
-    ecs_run_w_filter(world, GetChildren, 0, 0, 0, 
-        parent_2,
-        &children);
-
-    print_children(world, "parent_2", children);
+    /* Print children for parent_2 */
+    print_children(world, "parent_2", parent_2);
 
     /* Cleanup */
-    ecs_vector_free(children);
     return ecs_fini(world);
 }
@@ -44,6 +44,7 @@ typedef struct ecs_world_t ecs_world_t;
 typedef struct ecs_rows_t ecs_rows_t;
 typedef struct ecs_reference_t ecs_reference_t;
 typedef struct ecs_snapshot_t ecs_snapshot_t;
+typedef struct ecs_query_t ecs_query_t;
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -174,6 +175,7 @@ typedef const char *EcsId;
 /** Component that contains metadata about a component */
 typedef struct EcsComponent {
     uint32_t size;
+    uint32_t alignment;     /* Alignment of columns (0 for default alignment) */
 } EcsComponent;
 
 /** Metadata of an explicitly created type (ECS_TYPE or ecs_new_type) */
@@ -199,6 +201,9 @@ typedef struct EcsPrefab {
 #define ECS_INSTANCEOF ((ecs_entity_t)1 << 63)
 #define ECS_CHILDOF ((ecs_entity_t)1 << 62) 
 
+/* Largest alignment that can be specified for a component */
+#define ECS_MAX_COMPONENT_ALIGNMENT (256)
+
 /** Type handles to builtin components */
 FLECS_EXPORT
 extern ecs_type_t 
@@ -299,6 +304,23 @@ extern ecs_type_t
     (void)ecs_entity(id);\
     (void)ecs_type(id);\
 
+/** Declare a component with aligned storage.
+ * This macro declares a component of which the table columns are aligned to
+ * the provided alignment, which must be a power of two of at most
+ * ECS_MAX_COMPONENT_ALIGNMENT. Columns are padded up to a multiple of the 
+ * alignment, so that the last elements of a column can be processed with a 
+ * full SIMD register.
+ *
+ * Example:
+ * ECS_ALIGNED_COMPONENT(world, Position, 32);
+ */
+#define ECS_ALIGNED_COMPONENT(world, id, alignment) \
+    ECS_ENTITY_VAR(id) = ecs_new_aligned_component(\
+        world, #id, sizeof(id), alignment);\
+    ECS_TYPE_VAR(id) = ecs_type_from_entity(world, ecs_entity(id));\
+    (void)ecs_entity(id);\
+    (void)ecs_type(id);\
+
 /** Declare a tag. 
  * This macro declares a tag with the provided id. Tags are the similar to 
  * components in that they can be added to an entity, but have no C type 
@@ -851,11 +873,12 @@ ecs_entity_t ecs_clone(
     bool copy_value);
 
 /** Delete components of an entity.
- * This operation will delete all components from the specified entity.
+ * This operation will delete all components from the specified entity. The id
+ * of the entity may be recycled by a subsequent call to ecs_new.
  *
  * When the delete operation is invoked upon an already deleted entity, the
- * operation will have no effect, as it will attempt to delete components from
- * an already empty entity.
+ * operation will have no effect. This also applies when the id of the deleted
+ * entity has been recycled, in which case the new entity is left untouched.
  *
  * As a result of a delete operation, EcsOnRemove systems will be invoked if
  * applicable for any of the removed components.
@@ -884,6 +907,22 @@ void ecs_delete_w_filter(
     ecs_world_t *world,
     const ecs_filter_t *filter);
 
+/** Test whether an entity is alive.
+ * The id of a deleted entity may be recycled by a subsequent ecs_new, in which
+ * case the new entity gets a different generation in the upper bits of the id.
+ * This operation returns false for ids that have been deleted, including ids
+ * that have since been recycled with a newer generation. Entities without
+ * components are alive if their id has been issued by the world.
+ *
+ * @param world The world.
+ * @param entity The entity to test.
+ * @return True if the entity is alive, false if it has been deleted.
+ */
+FLECS_EXPORT
+bool ecs_is_alive(
+    ecs_world_t *world,
+    ecs_entity_t entity);
+
 /** Add a type to an entity.
  * This operation will add one or more components (as per the specified type) to
  * an entity. If the entity already contains a subset of the components in the
@@ -1095,6 +1134,27 @@ void* _ecs_get_ptr(
 #define ecs_get(world, entity, type)\
   (*(type*)_ecs_get_ptr(world, entity, T##type))
 
+/** Get pointer to component data that will be modified.
+ * This operation is the same as ecs_get_ptr, except that the returned pointer
+ * may be used to modify the component. Data of components that are shared
+ * through a prefab is not returned. Component data that is shared with a 
+ * snapshot is copied before it is returned, so that the snapshot does not 
+ * change. The component is marked as changed.
+ *
+ * @param world The world.
+ * @param entity Handle to the entity from which to obtain the component data.
+ * @param component The component to retrieve the data for.
+ * @return A pointer to the data, or NULL of the component was not found.
+ */
+FLECS_EXPORT
+void* _ecs_get_mutable(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_type_t type);
+
+#define ecs_get_mutable(world, entity, type)\
+    (type*)_ecs_get_mutable(world, entity, T##type)
+
 /* Set value of component.
  * This function sets the value of a component on the specified entity. If the
  * component does not yet exist, it will be added to the entity.
@@ -1606,6 +1666,114 @@ bool ecs_filter_next(
     ecs_filter_iter_t *iter);
 
 
+////////////////////////////////////////////////////////////////////////////////
+//// Children iterator API
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct ecs_children_iter_t {
+    ecs_entity_t parent;
+    uint32_t index;
+    ecs_rows_t rows;
+} ecs_children_iter_t;
+
+/** Create iterator that iterates the children of a parent.
+ * The world keeps an index of the tables that have the parent in their type,
+ * so only tables with children of the parent are visited. Combined with the
+ * ecs_children_next function an application can iterate over the tables with
+ * children, for which ecs_children_next populates an ecs_rows_t object.
+ *
+ * Children that were created or adopted while iterating are not visited until
+ * the stage has been merged.
+ *
+ * @param world The world.
+ * @param parent The parent for which to iterate the children.
+ * @return An iterator that can be used with ecs_children_next.
+ */
+FLECS_EXPORT
+ecs_children_iter_t ecs_children_iter(
+    ecs_world_t *world,
+    ecs_entity_t parent);
+
+/** Iterate tables with children of a parent.
+ * This operation can be called repeatedly for an iterator until it returns
+ * false, in which case there are no more tables with children. Tables without
+ * entities are skipped.
+ *
+ * When the operation returns true, the children can be accessed through the
+ * "rows" member of the iterator, in the same way as with ecs_filter_next.
+ *
+ * @param iter The iterator.
+ */
+FLECS_EXPORT
+bool ecs_children_next(
+    ecs_children_iter_t *iter);
+
+
+////////////////////////////////////////////////////////////////////////////////
+//// Query API
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct ecs_query_iter_t {
+    ecs_query_t *query;
+    uint32_t index;
+    ecs_rows_t rows;
+} ecs_query_iter_t;
+
+/** Create a query that caches the tables matched by a filter.
+ * Where ecs_filter_iter evaluates the filter against every table in the world
+ * each time it is called, a query matches tables once when it is created, and
+ * is matched with new tables when they are created. Tables with entities are
+ * stored before empty tables, so that iterating a query only visits tables
+ * that have entities.
+ *
+ * Queries are owned by the world, and are freed when the world is deleted, or
+ * by calling ecs_query_free.
+ *
+ * @param world The world.
+ * @param filter The filter.
+ * @return A query that can be iterated with ecs_query_iter.
+ */
+FLECS_EXPORT
+ecs_query_t* ecs_query_new(
+    ecs_world_t *world,
+    const ecs_filter_t *filter);
+
+/** Free a query.
+ *
+ * @param query The query to free.
+ */
+FLECS_EXPORT
+void ecs_query_free(
+    ecs_query_t *query);
+
+/** Create iterator for a query.
+ * Combined with the ecs_query_next function an application can iterate over
+ * the tables matched by the query, for which ecs_query_next populates an
+ * ecs_rows_t object.
+ *
+ * @param query The query to iterate.
+ * @return An iterator that can be used with ecs_query_next.
+ */
+FLECS_EXPORT
+ecs_query_iter_t ecs_query_iter(
+    ecs_query_t *query);
+
+/** Iterate tables matched by a query.
+ * This operation can be called repeatedly for an iterator until it returns
+ * false, in which case there are no more tables with entities. When the
+ * operation returns true, the entities can be accessed through the "rows"
+ * member of the iterator, in the same way as with ecs_filter_next.
+ *
+ * Entities may be deleted while iterating. Tables that are created while
+ * iterating may or may not be visited by the iterator.
+ *
+ * @param iter The iterator.
+ */
+FLECS_EXPORT
+bool ecs_query_next(
+    ecs_query_iter_t *iter);
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //// System API
 ////////////////////////////////////////////////////////////////////////////////
@@ -1657,6 +1825,30 @@ void ecs_set_period(
     ecs_entity_t system,
     float period);
 
+/** Only invoke a system for tables of which the system input changed.
+ * When enabled, a system skips matched tables for which none of the owned
+ * columns the system reads from ([in] and [inout]) were written since the
+ * previous invocation of the system. A column is written when an [out] or
+ * [inout] system runs on it, when a component is set with ecs_set or
+ * ecs_set_w_data, and when entities are added to or moved into the table.
+ *
+ * Writes of the system itself do not cause the system to run again. Tables
+ * for which the system has columns that are not owned (for example components
+ * from a prefab or container) are never skipped.
+ *
+ * This operation is only valid on column systems. If it is invoked on handles
+ * of other systems or entities it will be ignored.
+ *
+ * @param world The world.
+ * @param system The system for which to set the flag.
+ * @param changed_only true to skip unchanged tables, false to run on all tables.
+ */
+FLECS_EXPORT
+void ecs_set_changed_only(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    bool changed_only);
+
 /** Returns the enabled status for a system / entity.
  * This operation will return whether a system is enabled or disabled. Currently
  * only systems can be enabled or disabled, but this operation does not fail
@@ -1850,6 +2042,47 @@ void ecs_snapshot_restore(
     ecs_world_t *world,
     ecs_snapshot_t *snapshot);
 
+/** Create a delta snapshot.
+ * This operation creates a snapshot that only stores the tables that changed
+ * since the previous snapshot was taken. The previous snapshot can be a full
+ * snapshot or another delta snapshot, which allows an application to create a
+ * chain of deltas that starts with a full snapshot. The previous snapshot must
+ * not be filtered.
+ *
+ * A delta snapshot cannot be restored with ecs_snapshot_restore. Use
+ * ecs_snapshot_restore_delta instead.
+ *
+ * @param world The world to snapshot.
+ * @param prev The snapshot that was taken before this snapshot.
+ * @return The delta snapshot.
+ */
+FLECS_EXPORT
+ecs_snapshot_t* ecs_snapshot_take_delta(
+    ecs_world_t *world,
+    const ecs_snapshot_t *prev);
+
+/** Restore a chain of delta snapshots.
+ * This operation restores the world to the state it was in when the last delta
+ * in the chain was taken. The first delta must have been taken with the base 
+ * snapshot as previous snapshot, and each next delta with the delta before it.
+ * If no deltas are provided, the world is restored to the base snapshot.
+ *
+ * Unlike ecs_snapshot_restore, this operation does not consume the snapshots,
+ * so that they can be restored more than once. The snapshots must still be
+ * freed with ecs_snapshot_free.
+ *
+ * @param world The world to restore the snapshots to.
+ * @param base The full snapshot at the start of the chain.
+ * @param deltas The delta snapshots, in the order they were taken.
+ * @param delta_count The number of delta snapshots.
+ */
+FLECS_EXPORT
+void ecs_snapshot_restore_delta(
+    ecs_world_t *world,
+    const ecs_snapshot_t *base,
+    ecs_snapshot_t **deltas,
+    uint32_t delta_count);
+
 /** Copy a snapshot.
  * This operation creates a copy of the provided snapshot. An application can
  * optionally filter the tables to copy.
@@ -1969,6 +2202,42 @@ int ecs_writer_write(
     size_t size,
     ecs_writer_t *writer);
 
+/** Save the world to an image file.
+ * An image contains the same data as the stream produced by ecs_reader_read,
+ * but lays out table columns on page boundaries so that the image can be
+ * loaded with ecs_world_load_image without parsing the column data.
+ *
+ * Images are stored in the native data layout, and can only be loaded on a
+ * platform with the same endianness and type sizes. The file must not be an
+ * image that is currently loaded in a world.
+ *
+ * @param world The world to save.
+ * @param filename The name of the image file.
+ * @return Zero if success, non-zero if failed to write the file.
+ */
+FLECS_EXPORT
+int ecs_world_save_image(
+    ecs_world_t *world,
+    const char *filename);
+
+/** Load an image file into the world.
+ * This operation memory maps an image created by ecs_world_save_image. Table
+ * columns point directly into the mapping, which means that loading time does
+ * not depend on the amount of component data. A column is copied to regular
+ * memory when it is first modified. The mapping is released by ecs_fini.
+ *
+ * The same compatibility rules as for ecs_writer_init apply to the world in
+ * which the image is loaded.
+ *
+ * @param world The world in which to load the image.
+ * @param filename The name of the image file.
+ * @return Zero if success, non-zero if failed to load the image.
+ */
+FLECS_EXPORT
+int ecs_world_load_image(
+    ecs_world_t *world,
+    const char *filename);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 //// Module API
@@ -2431,6 +2700,48 @@ FLECS_EXPORT
 int ecs_enable_console(
 	ecs_world_t* world);
 
+/** Start recording a timeline of the world.
+ * While tracing is enabled, the world records how long frames, phases, system
+ * invocations, worker jobs and merges take. Each thread records its events in
+ * its own ring buffer, which holds the most recent events. The timeline can be
+ * written to a file with ecs_trace_write.
+ *
+ * Starting a trace discards previously recorded events. This operation may only
+ * be invoked outside ecs_progress.
+ *
+ * @param world The world.
+ * @param capacity Number of events stored per thread (0 for default).
+ */
+FLECS_EXPORT
+void ecs_trace_start(
+    ecs_world_t *world,
+    uint32_t capacity);
+
+/** Stop recording a timeline.
+ * Recorded events are kept until tracing is started again, or until the world
+ * is deleted. Events of worker threads are discarded when the number of threads
+ * changes. This operation may only be invoked outside ecs_progress.
+ *
+ * @param world The world.
+ */
+FLECS_EXPORT
+void ecs_trace_stop(
+    ecs_world_t *world);
+
+/** Write recorded timeline to a file.
+ * The file is written in the Chrome Trace Event format, which can be loaded in
+ * chrome://tracing or the Perfetto UI. Each thread is shown as a separate
+ * track. This operation may only be invoked outside ecs_progress.
+ *
+ * @param world The world.
+ * @param filename The file to write to.
+ * @return 0 if success, -1 if the file could not be written.
+ */
+FLECS_EXPORT
+int ecs_trace_write(
+    ecs_world_t *world,
+    const char *filename);
+
 /** Translate C type to entity variable */
 #define ecs_entity(type) E##type
 
@@ -98,6 +98,42 @@ public:
         return m_array;
     }
 
+    /** Pointer to the first element, without bounds checking. For shared
+     * columns this points to the single shared value. */
+    T* data() const {
+        return m_array;
+    }
+
+    /** Pointer to the first element, with a hint to the compiler that the
+     * pointer is aligned to Alignment bytes. This holds for owned columns of 
+     * components declared with that alignment, if the rows start at the 
+     * beginning of the table. */
+    template <std::size_t Alignment = alignof(T)>
+    T* aligned_data() const {
+        ecs_assert(!m_is_shared, ECS_INVALID_PARAMETER, NULL);
+        ecs_assert(((uintptr_t)m_array & (Alignment - 1)) == 0,
+            ECS_INVALID_PARAMETER, NULL);
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<T*>(__builtin_assume_aligned(m_array, Alignment));
+#else
+        return m_array;
+#endif
+    }
+
+    /** Number of elements in the column (1 for shared columns) */
+    std::size_t size() const {
+        return m_is_shared ? 1 : m_count;
+    }
+
+    /** Unchecked iteration over the elements of the column */
+    T* begin() const {
+        return m_array;
+    }
+
+    T* end() const {
+        return m_array + size();
+    }
+
     bool is_set() const {
         return m_array != nullptr;
     }
@@ -883,7 +919,9 @@ public:
         entity_t cur_entity = s_entity;
         type_t cur_type = s_type;
 
-        s_entity = ecs_new_component(world.c_ptr(), name, sizeof(T));
+        /* Types declared with alignas get columns with the same alignment */
+        s_entity = ecs_new_aligned_component(
+            world.c_ptr(), name, sizeof(T), alignof(T));
         s_type = ecs_type_from_entity(world.c_ptr(), s_entity);
         s_name = name;
 
@@ -28,6 +28,7 @@ typedef enum ecs_blob_header_kind_t {
     EcsComponentHeader,
     EcsComponentId,
     EcsComponentSize,
+    EcsComponentAlignment,
     EcsComponentNameLength,
     EcsComponentName,
 
@@ -118,6 +119,7 @@ typedef struct ecs_component_writer_t {
 
     int32_t id;
     size_t size;
+    size_t alignment;
     ecs_name_writer_t name;
 } ecs_component_writer_t;
 
@@ -158,6 +160,12 @@ typedef struct ecs_writer_t {
 #define ECS_ENTITY_FLAGS_MASK ((ecs_entity_t)(ECS_INSTANCEOF | ECS_CHILDOF))
 #define ECS_ENTITY_MASK ((ecs_entity_t)~ECS_ENTITY_FLAGS_MASK)
 
+/* The lower 32 bits of an entity id identify the entity, the next 16 bits hold
+ * a generation that is increased each time the id is recycled. */
+#define ECS_ENTITY_INDEX_MASK ((ecs_entity_t)0xFFFFFFFF)
+#define ECS_GENERATION_MASK ((ecs_entity_t)0xFFFF << 32)
+#define ECS_GENERATION(e) ((uint32_t)(((e) & ECS_GENERATION_MASK) >> 32))
+
 
 ////////////////////////////////////////////////////////////////////////////////
 //// Deprecated names
@@ -207,6 +215,13 @@ ecs_entity_t ecs_new_component(
     const char *id,
     size_t size);
 
+FLECS_EXPORT
+ecs_entity_t ecs_new_aligned_component(
+    ecs_world_t *world,
+    const char *id,
+    size_t size,
+    size_t alignment);
+
 FLECS_EXPORT
 ecs_entity_t ecs_new_system(
     ecs_world_t *world,
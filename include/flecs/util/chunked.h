@@ -74,8 +74,8 @@ ecs_chunked_t* ecs_chunked_copy(
 FLECS_EXPORT
 void ecs_chunked_memory(
     ecs_chunked_t *chunked,
-    uint32_t *allocd,
-    uint32_t *used);
+    uint64_t *allocd,
+    uint64_t *used);
 
 #ifdef __cplusplus
 }
@@ -10,7 +10,6 @@ typedef struct ecs_map_t ecs_map_t;
 typedef struct ecs_map_iter_t {
     ecs_map_t *map;
     uint32_t bucket_index;
-    uint32_t node;
 } ecs_map_iter_t;
 
 FLECS_EXPORT
@@ -25,8 +24,8 @@ void ecs_map_free(
 FLECS_EXPORT
 void ecs_map_memory(
     ecs_map_t *map,
-    uint32_t *total,
-    uint32_t *used);
+    uint64_t *total,
+    uint64_t *used);
 
 FLECS_EXPORT
 uint32_t ecs_map_count(
@@ -70,6 +70,10 @@ typedef
 void* (*ecs_os_api_thread_join_t)(
     ecs_os_thread_t thread);
 
+/* Atomic increment / decrement, returns the new value */
+typedef
+int32_t (*ecs_os_api_ainc_t)(
+    int32_t *value);
 
 /* Mutex */
 typedef
@@ -161,6 +165,10 @@ typedef struct ecs_os_api_t {
     ecs_os_api_thread_new_t thread_new;
     ecs_os_api_thread_join_t thread_join;
 
+    /* Atomic operations */
+    ecs_os_api_ainc_t ainc;
+    ecs_os_api_ainc_t adec;
+
     /* Mutex */
     ecs_os_api_mutex_new_t mutex_new;
     ecs_os_api_mutex_free_t mutex_free;
@@ -226,6 +234,10 @@ void ecs_os_set_api_defaults(void);
 #define ecs_os_thread_new(callback, param) ecs_os_api.thread_new(callback, param)
 #define ecs_os_thread_join(thread) ecs_os_api.thread_join(thread)
 
+/* Atomic operations */
+#define ecs_os_ainc(value) ecs_os_api.ainc(value)
+#define ecs_os_adec(value) ecs_os_api.adec(value)
+
 /* Mutex */
 #define ecs_os_mutex_new() ecs_os_api.mutex_new()
 #define ecs_os_mutex_free(mutex) ecs_os_api.mutex_free(mutex)
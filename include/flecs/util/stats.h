@@ -17,10 +17,52 @@ extern "C" {
 
 /* Type to keep track of memory that is in use vs. allocated */
 typedef struct ecs_memory_stat_t {
-    uint32_t allocd_bytes;            /* Memory allocated */
-    uint32_t used_bytes;              /* Memory in use */
+    uint64_t allocd_bytes;            /* Memory allocated */
+    uint64_t used_bytes;              /* Memory in use */
 } ecs_memory_stat_t;
 
+/* Number of buckets in a timing histogram. The first bucket counts samples
+ * shorter than ECS_HISTOGRAM_RESOLUTION_NS, each next bucket covers twice the
+ * range of the previous one. */
+#define ECS_HISTOGRAM_BUCKET_COUNT (32)
+#define ECS_HISTOGRAM_RESOLUTION_NS (1024)
+
+/* Number of samples after which the counts of a histogram are halved */
+#define ECS_HISTOGRAM_WINDOW (1024)
+
+/* Maximum number of worker threads for which timings are reported */
+#define ECS_STATS_MAX_THREADS (64)
+
+/* Rolling histogram of measured durations. The histogram has a fixed size, and
+ * decays once it has collected ECS_HISTOGRAM_WINDOW samples, so that it
+ * reflects recent samples without storing them. */
+typedef struct ecs_time_histogram_t {
+    uint32_t buckets[ECS_HISTOGRAM_BUCKET_COUNT]; /* Samples per bucket */
+    uint32_t count;                   /* Number of samples in buckets */
+    float max_seconds;                /* Longest sample in current window */
+    float prev_max_seconds;           /* Longest sample in previous window */
+} ecs_time_histogram_t;
+
+/* Latencies computed from a time histogram */
+typedef struct ecs_time_percentiles_t {
+    float p50_seconds;                /* Median */
+    float p99_seconds;                /* 99th percentile */
+    float max_seconds;                /* Longest sample in last two windows */
+} ecs_time_percentiles_t;
+
+/* Add a sample to a time histogram */
+FLECS_EXPORT
+void ecs_time_histogram_record(
+    ecs_time_histogram_t *hist,
+    double seconds);
+
+/* Compute a percentile (between 0 and 1) from a time histogram. The result is
+ * the upper bound of the bucket that contains the percentile. */
+FLECS_EXPORT
+float ecs_time_histogram_percentile(
+    const ecs_time_histogram_t *hist,
+    float percentile);
+
 /* Global statistics on memory allocations */
 typedef struct EcsAllocStats {
     uint64_t malloc_count_total;      /* Total number of times malloc was invoked */
@@ -80,6 +122,7 @@ typedef struct EcsSystemStats {
     uint32_t entities_matched_count;        /* Number of entities matched */
     uint64_t invoke_count_total;            /* Number of times system got invoked */
     float seconds_total;                    /* Total time spent in system */
+    ecs_time_percentiles_t invoke_seconds;  /* Recent time spent per invocation */
     bool is_enabled;                        /* Is system enabled */
     bool is_active;                         /* Is system active */
     bool is_hidden;                         /* Is system hidden */
@@ -112,6 +155,7 @@ typedef struct EcsTableStats {
     ecs_memory_stat_t entity_memory;        /* Memory in use for entity data */
     ecs_memory_stat_t component_memory;     /* Memory in use for table data */
     uint32_t other_memory_bytes;            /* Memory in use for other */
+    double system_seconds_total;            /* Time spent by systems on table */
 } EcsTableStats;
 
 /* World statistics */
@@ -132,10 +176,29 @@ typedef struct EcsWorldStats {
     double fps_hz;                          /* Frames per second (current) */
 } EcsWorldStats;
 
+/* Timing statistics of a thread and its stage */
+typedef struct ecs_thread_time_stat_t {
+    uint64_t jobs_count_total;              /* Number of jobs ran by thread */
+    double jobs_seconds_total;              /* Time spent running jobs */
+    ecs_time_percentiles_t job_seconds;     /* Recent time spent per job */
+    uint64_t merges_count_total;            /* Number of times stage got merged */
+    double merge_seconds_total;             /* Time spent merging stage */
+    ecs_time_percentiles_t merge_seconds;   /* Recent time spent per merge */
+} ecs_thread_time_stat_t;
+
+/* Thread statistics. The main thread only merges its temporary stage, worker
+ * threads run jobs and have their own stage. */
+typedef struct EcsThreadStats {
+    uint32_t threads_count;                 /* Number of worker threads */
+    ecs_thread_time_stat_t main_thread;     /* Statistics of main thread */
+    ecs_thread_time_stat_t threads[ECS_STATS_MAX_THREADS]; /* Worker threads */
+} EcsThreadStats;
+
 /* Stats module component */
 typedef struct FlecsStats {
     ECS_DECLARE_COMPONENT(EcsAllocStats);
     ECS_DECLARE_COMPONENT(EcsWorldStats);
+    ECS_DECLARE_COMPONENT(EcsThreadStats);
     ECS_DECLARE_COMPONENT(EcsMemoryStats);
     ECS_DECLARE_COMPONENT(EcsSystemStats);
     ECS_DECLARE_COMPONENT(EcsColSystemMemoryStats);
@@ -154,6 +217,7 @@ void FlecsStatsImport(
 #define FlecsStatsImportHandles(handles)\
     ECS_IMPORT_COMPONENT(handles, EcsAllocStats);\
     ECS_IMPORT_COMPONENT(handles, EcsWorldStats);\
+    ECS_IMPORT_COMPONENT(handles, EcsThreadStats);\
     ECS_IMPORT_COMPONENT(handles, EcsMemoryStats);\
     ECS_IMPORT_COMPONENT(handles, EcsSystemStats);\
     ECS_IMPORT_COMPONENT(handles, EcsColSystemMemoryStats);\
@@ -8,6 +8,8 @@ extern "C" {
 typedef struct ecs_vector_t ecs_vector_t;
 typedef struct ecs_vector_params_t ecs_vector_params_t;
 
+#define ECS_VECTOR_HEADER_SIZE (16)
+
 typedef int (*EcsComparator)(
     const void* p1,
     const void *p2);
@@ -24,6 +26,7 @@ struct ecs_vector_params_t {
     void *move_ctx;
     void *ctx;
     uint32_t element_size; /* Size of an element */
+    uint32_t alignment; /* Alignment of buffer (0 for default alignment) */
 };
 
 FLECS_EXPORT
@@ -141,14 +144,27 @@ FLECS_EXPORT
 void ecs_vector_memory(
     const ecs_vector_t *array,
     const ecs_vector_params_t *params,
-    uint32_t *allocd,
-    uint32_t *used);
+    uint64_t *allocd,
+    uint64_t *used);
 
 FLECS_EXPORT
 ecs_vector_t* ecs_vector_copy(
     const ecs_vector_t *src,
     const ecs_vector_params_t *params);
 
+FLECS_EXPORT
+ecs_vector_t* ecs_vector_share(
+    ecs_vector_t *array);
+
+FLECS_EXPORT
+bool ecs_vector_is_shared(
+    const ecs_vector_t *array);
+
+FLECS_EXPORT
+ecs_vector_t* ecs_vector_borrow(
+    void *memory,
+    uint32_t count);
+
 #ifdef __cplusplus
 }
 #endif
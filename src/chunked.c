@@ -276,8 +276,8 @@ ecs_chunked_t* ecs_chunked_copy(
 
 void ecs_chunked_memory(
     ecs_chunked_t *chunked,
-    uint32_t *allocd,
-    uint32_t *used)
+    uint64_t *allocd,
+    uint64_t *used)
 {
     if (!chunked) {
         return;
@@ -288,10 +288,10 @@ void ecs_chunked_memory(
     ecs_vector_memory(chunked->sparse, &sparse_param, allocd, used);
     ecs_vector_memory(chunked->free_stack, &free_param, allocd, used);
 
-    uint32_t data_total = chunked->chunk_size * 
+    uint64_t data_total = (uint64_t)chunked->chunk_size * 
         chunked->element_size * ecs_vector_count(chunked->chunks);
 
-    uint32_t data_not_used = ecs_vector_count(chunked->free_stack) * 
+    uint64_t data_not_used = (uint64_t)ecs_vector_count(chunked->free_stack) * 
         chunked->element_size;
 
     if (allocd) {
@@ -32,7 +32,7 @@ ecs_entity_t components_contains(
 
         if (entity & ECS_CHILDOF) {
             entity &= ECS_ENTITY_MASK;
-            ecs_row_t *row = ecs_map_get_ptr(world->main_stage.entity_index, entity);
+            ecs_row_t *row = ecs_ei_get(world->main_stage.entity_index, entity);
             ecs_assert(row != 0, ECS_INTERNAL_ERROR, NULL);
 
             ecs_entity_t component = ecs_type_contains(
@@ -56,7 +56,7 @@ ecs_entity_t ecs_get_entity_for_component(
     ecs_entity_t component)
 {
     if (entity) {
-        ecs_row_t *row = ecs_map_get_ptr(world->main_stage.entity_index, entity);
+        ecs_row_t *row = ecs_ei_get(world->main_stage.entity_index, entity);
         ecs_assert(row != NULL, ECS_INTERNAL_ERROR, NULL);
         type = row->type;
     }
@@ -77,6 +77,82 @@ ecs_entity_t ecs_get_entity_for_component(
     return entity;
 }
 
+/** Map key for a table. Table pointers share their low bits, which the map
+ * uses to select a bucket, so they are mixed before they are used as key. */
+static
+uint64_t table_key(
+    ecs_table_t *table)
+{
+    uint64_t key = (uintptr_t)table;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+}
+
+/** Store the position of a table in the active or inactive tables of a system.
+ * Active tables are stored as index + 1, inactive tables as -(index + 1). */
+static
+void set_table_index(
+    EcsColSystem *system_data,
+    ecs_table_t *table,
+    int32_t index,
+    bool active)
+{
+    if (!system_data->table_index) {
+        system_data->table_index = ecs_map_new(0, sizeof(int32_t));
+    }
+
+    int32_t value = active ? index + 1 : -(index + 1);
+    ecs_map_set(system_data->table_index, table_key(table), &value);
+}
+
+/** Get the position of a table in the active or inactive tables of a system.
+ * Returns -1 if the table is not matched with the system. */
+static
+int32_t get_table_index(
+    EcsColSystem *system_data,
+    ecs_table_t *table,
+    bool *active_out)
+{
+    int32_t *value = NULL;
+    if (system_data->table_index) {
+        value = ecs_map_get_ptr(system_data->table_index, table_key(table));
+    }
+
+    if (!value) {
+        return -1;
+    }
+
+    if (*value > 0) {
+        *active_out = true;
+        return *value - 1;
+    } else {
+        *active_out = false;
+        return -*value - 1;
+    }
+}
+
+/** Remove element from the tables of a system. The last element is moved into
+ * the slot of the removed element, so its stored position is updated. */
+static
+uint32_t remove_table_index(
+    EcsColSystem *system_data,
+    ecs_vector_t *tables,
+    int32_t index,
+    bool active)
+{
+    uint32_t count = ecs_vector_remove_index(
+        tables, &matched_table_params, index);
+
+    if ((uint32_t)index < count) {
+        ecs_matched_table_t *moved = ecs_vector_get(
+            tables, &matched_table_params, index);
+        set_table_index(system_data, moved->table, index, active);
+    }
+
+    return count;
+}
+
 /** Add table to system, compute offsets for system components in table rows */
 static
 void add_table(
@@ -111,8 +187,9 @@ void add_table(
     table_data->components = NULL;
 
     if (column_count) {
-        /* Array that contains the system column to table column mapping */
-        table_data->columns = ecs_os_malloc(sizeof(uint32_t) * column_count);
+        /* Array that contains the system column to table column mapping. Not
+         * all column kinds set the mapping, so initialize it to zero. */
+        table_data->columns = ecs_os_calloc(sizeof(uint32_t), column_count);
         ecs_assert(table_data->columns != NULL, ECS_OUT_OF_MEMORY, NULL);
 
         /* Store the components of the matched table. In the case of OR expressions,
@@ -268,15 +345,7 @@ void add_table(
                     ref->component = component;
                     
                     if (e != ECS_INVALID_ENTITY) {
-                        ecs_entity_info_t info = {.entity = e};
-
-                        ref->cached_ptr = ecs_get_ptr_intern(
-                            world, 
-                            &world->main_stage,
-                            &info,
-                            component,
-                            false,
-                            true);
+                        ref->cached_ptr = ecs_get_ref_ptr(world, e, component);
 
                         ecs_set_watch(world, &world->main_stage, e);                     
                     } else {
@@ -295,6 +364,8 @@ void add_table(
     }
 
     if (table) {
+        set_table_index(system_data, table, 
+            ecs_vector_count(system_data->inactive_tables) - 1, false);
         ecs_table_register_system(world, table, system);
     }
 }
@@ -304,10 +375,14 @@ static
 void remove_table(
     EcsColSystem *system_data,
     ecs_vector_t *tables,
-    int32_t index)
+    int32_t index,
+    bool active)
 {
-    (void)system_data;
-    ecs_vector_remove_index(tables, &matched_table_params, index);
+    ecs_matched_table_t *table_data = ecs_vector_get(
+        tables, &matched_table_params, index);
+
+    ecs_map_remove(system_data->table_index, table_key(table_data->table));
+    remove_table_index(system_data, tables, index, active);
 }
 
 /* Match table with system */
@@ -530,18 +605,101 @@ void order_cascade_tables(
     EcsColSystem *system_data)
 {
     uint32_t i, count = ecs_vector_count(system_data->tables);
-    ecs_entity_t cascade_component = get_cascade_component(system_data);
 
+    /* A container is always stored in a table with a lower depth than its
+     * children, so ordering by the cached table depth guarantees that the
+     * CASCADE component of a container is processed before its children. */
     for (i = 0; i < count; i ++) {
         ecs_matched_table_t *table_data = ecs_vector_get(
             system_data->tables, &matched_table_params, i);
 
-        ecs_type_t type = table_data->table->type;
-        table_data->depth = ecs_type_container_depth(
-            world, type, cascade_component);
+        table_data->depth = ecs_table_depth(world, table_data->table);
     }
 
     ecs_vector_sort(system_data->tables, &matched_table_params, table_compare);
+
+    /* Sorting moved the tables, update their positions */
+    ecs_matched_table_t *tables = ecs_vector_first(system_data->tables);
+    for (i = 0; i < count; i ++) {
+        set_table_index(system_data, tables[i].table, i, true);
+    }
+}
+
+/** Swap two active tables of a system */
+static
+void swap_cascade_tables(
+    EcsColSystem *system_data,
+    ecs_matched_table_t *tables,
+    int32_t index_1,
+    int32_t index_2)
+{
+    ecs_matched_table_t tmp = tables[index_1];
+    tables[index_1] = tables[index_2];
+    tables[index_2] = tmp;
+    set_table_index(system_data, tables[index_1].table, index_1, true);
+    set_table_index(system_data, tables[index_2].table, index_2, true);
+}
+
+/** Find the first table in [from, to) with a depth larger than (upper) or
+ * larger or equal than (!upper) the specified depth */
+static
+int32_t find_cascade_depth(
+    ecs_matched_table_t *tables,
+    int32_t from,
+    int32_t to,
+    int32_t depth,
+    bool upper)
+{
+    while (from < to) {
+        int32_t mid = from + (to - from) / 2;
+        if (tables[mid].depth < depth || (upper && tables[mid].depth == depth)) {
+            from = mid + 1;
+        } else {
+            to = mid;
+        }
+    }
+
+    return from;
+}
+
+/** Move the last active table to its depth position. The table is swapped with
+ * the first table of each group of tables with a larger depth, which moves
+ * that table to the end of its group, so the order of the tables is kept. */
+static
+void insert_cascade_table(
+    EcsColSystem *system_data)
+{
+    ecs_matched_table_t *tables = ecs_vector_first(system_data->tables);
+    int32_t pos = ecs_vector_count(system_data->tables) - 1;
+    int32_t depth = tables[pos].depth;
+
+    while (pos && tables[pos - 1].depth > depth) {
+        int32_t first = find_cascade_depth(
+            tables, 0, pos, tables[pos - 1].depth, false);
+        swap_cascade_tables(system_data, tables, pos, first);
+        pos = first;
+    }
+}
+
+/** Move an active table to the end of the active tables, so that it can be
+ * removed without changing the order of the other tables. The table is swapped
+ * with the last table of each group of tables that follow it. */
+static
+int32_t remove_cascade_table(
+    EcsColSystem *system_data,
+    int32_t pos)
+{
+    ecs_matched_table_t *tables = ecs_vector_first(system_data->tables);
+    int32_t count = ecs_vector_count(system_data->tables);
+
+    while (pos < count - 1) {
+        int32_t last = find_cascade_depth(
+            tables, pos + 1, count, tables[pos + 1].depth, true) - 1;
+        swap_cascade_tables(system_data, tables, pos, last);
+        pos = last;
+    }
+
+    return pos;
 }
 
 /** Match existing tables against system (table is created before system) */
@@ -567,35 +725,16 @@ void match_tables(
     }
 }
 
-/** Check if a table was matched with the system */
-static
-int32_t table_matched(
-    EcsColSystem *system_data,
-    ecs_vector_t *tables,
-    ecs_table_t *table)
-{
-    uint32_t i, count = ecs_vector_count(tables);
-    ecs_matched_table_t *table_data = ecs_vector_first(tables);
-    (void)system_data;
-
-    for (i = 0; i < count; i ++) {
-        if (table_data[i].table == table) {
-            return i;
-        }
-    }
-
-    return -1;
-}
-
 static
 void resolve_cascade_container(
     ecs_world_t *world,
     EcsColSystem *system_data,
+    ecs_vector_t *tables,
     int32_t table_data_index,
     ecs_type_t table_type)
 {
     ecs_matched_table_t *table_data = ecs_vector_get(
-        system_data->tables, &matched_table_params, table_data_index);
+        tables, &matched_table_params, table_data_index);
     
     ecs_assert(table_data->references != 0, ECS_INTERNAL_ERROR, NULL);
 
@@ -617,22 +756,20 @@ void resolve_cascade_container(
 
     /* If container was found, update the reference */
     if (container) {
-        ecs_entity_info_t info = {.entity = container};
         references[ref_index].entity = container;
-        references[ref_index].cached_ptr = ecs_get_ptr_intern(
-            world, &world->main_stage, &info, ref->component, false, true);
+        references[ref_index].cached_ptr = ecs_get_ref_ptr(
+            world, container, ref->component);
     } else {
         references[ref_index].entity = ECS_INVALID_ENTITY;
         references[ref_index].cached_ptr = NULL;
     }
 }
 
-static
-bool should_run(
+bool ecs_col_system_should_run(
     EcsColSystem *system_data,
-    float period,
     float delta_time)
 {
+    float period = system_data->period;
     float time_passed = system_data->time_passed + delta_time;
 
     if (time_passed >= period) {
@@ -650,54 +787,98 @@ bool should_run(
     return true;
 }
 
-/* -- Private API -- */
-
-/* Rematch system with tables after a change happened to a container or prefab */
-void ecs_rematch_system(
+/** Add component to the read and/or write type of system */
+static
+void add_inout_component(
     ecs_world_t *world,
-    ecs_entity_t system)
+    EcsColSystem *system_data,
+    ecs_system_expr_inout_kind_t inout_kind,
+    ecs_entity_t component)
 {
-    EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
-    ecs_assert(system_data != NULL, ECS_INTERNAL_ERROR, 0);
+    if (inout_kind != EcsOut) {
+        system_data->reads = ecs_type_add_intern(
+            world, NULL, system_data->reads, component);
+    }
 
-    ecs_chunked_t *tables = world->main_stage.tables;
-    uint32_t i, count = ecs_chunked_count(tables);
+    if (inout_kind != EcsIn) {
+        system_data->writes = ecs_type_add_intern(
+            world, NULL, system_data->writes, component);
+    }
+}
+
+/** Compute which components are read and written by a system. This is used to
+ * find systems that can run at the same time in multithreaded mode. */
+static
+void compute_inout_types(
+    ecs_world_t *world,
+    EcsColSystem *system_data)
+{
+    ecs_system_column_t *columns = ecs_vector_first(system_data->base.columns);
+    uint32_t i, count = ecs_vector_count(system_data->base.columns);
 
     for (i = 0; i < count; i ++) {
-        /* Is the system currently matched with the table? */
-        ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, i);
-        int32_t match = table_matched(system_data, system_data->tables, table);
+        ecs_system_column_t *column = &columns[i];
+        ecs_system_expr_inout_kind_t inout_kind = column->inout_kind;
 
-        if (match_table(world, table, system, system_data, NULL)) {
-            /* If the table matches, and it is not currently matched, add */
-            if (match == -1) {
-                if (table_matched(system_data, system_data->inactive_tables, table) == -1) {
-                    add_table(world, system, system_data, table);
-                }
+        /* Columns that don't pass component data don't access anything */
+        if (column->oper_kind == EcsOperNot || column->kind == EcsFromEmpty) {
+            continue;
+        }
+
+        if (column->oper_kind == EcsOperOr) {
+            ecs_entity_t *components = ecs_vector_first(column->is.type);
+            uint32_t c, c_count = ecs_vector_count(column->is.type);
 
-            /* If table still matches and has cascade column, reevaluate the
-                * sources of references. This may have changed in case 
-                * components were added/removed to container entities */ 
-            } else if (system_data->base.cascade_by) {
-                resolve_cascade_container(
-                    world, system_data, match, table->type);
+            for (c = 0; c < c_count; c ++) {
+                add_inout_component(
+                    world, system_data, inout_kind, components[c]);
             }
         } else {
-            /* If table no longer matches, remove it */
-            if (match != -1) {
-                remove_table(system_data, system_data->tables, match);
-            } else {
-                /* Make sure the table is removed if it was inactive */
-                match = table_matched(
-                    system_data, system_data->inactive_tables, table);
-                if (match != -1) {
-                    remove_table(
-                        system_data, system_data->inactive_tables, match);
-                }
-            }
+            add_inout_component(
+                world, system_data, inout_kind, column->is.component);
         }
     }
+}
+
+/* Rematch a single table with a system */
+static
+void rematch_table(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    EcsColSystem *system_data,
+    ecs_table_t *table)
+{
+    /* Is the system currently matched with the table? */
+    bool active = false;
+    int32_t match = get_table_index(system_data, table, &active);
+    ecs_vector_t *tables = 
+        active ? system_data->tables : system_data->inactive_tables;
+
+    if (match_table(world, table, system, system_data, NULL)) {
+        /* If the table matches, and it is not currently matched, add */
+        if (match == -1) {
+            add_table(world, system, system_data, table);
 
+        /* If table still matches and has cascade column, reevaluate the
+         * sources of references. This may have changed in case 
+         * components were added/removed to container entities */ 
+        } else if (system_data->base.cascade_by) {
+            resolve_cascade_container(
+                world, system_data, tables, match, table->type);
+        }
+    } else if (match != -1) {
+        /* If table no longer matches, remove it */
+        remove_table(system_data, tables, match, active);
+    }
+}
+
+/* Reorder tables and reevaluate constraints after rematching */
+static
+void rematch_finalize(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    EcsColSystem *system_data)
+{
     /* If the system has a CASCADE column and modifications were made, 
      * reorder the system tables so that the depth order is preserved */
     if (system_data->base.cascade_by) {
@@ -710,20 +891,80 @@ void ecs_rematch_system(
         ecs_check_column_constraints(world, (EcsSystem*)system_data), false);
 }
 
-/** Revalidate references after a realloc occurred in a table */
-void ecs_revalidate_system_refs(
+/* -- Private API -- */
+
+/* Rematch system with tables after a change happened to a container or prefab */
+void ecs_rematch_system(
     ecs_world_t *world,
     ecs_entity_t system)
 {
     EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
     ecs_assert(system_data != NULL, ECS_INTERNAL_ERROR, 0);
 
-    if (!system_data->base.has_refs) {
-        return;
+    ecs_chunked_t *tables = world->main_stage.tables;
+    uint32_t i, count = ecs_chunked_count(tables);
+
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, i);
+        rematch_table(world, system, system_data, table);
     }
 
-    uint32_t i, count = ecs_vector_count(system_data->tables);
-    ecs_matched_table_t *table_data = ecs_vector_first(system_data->tables);
+    rematch_finalize(world, system, system_data);
+}
+
+/* Rematch system with a subset of the tables, which is used when the change
+ * only affects the tables that refer to a specific container or prefab */
+void ecs_rematch_system_w_tables(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    ecs_vector_t *tables)
+{
+    EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
+    ecs_assert(system_data != NULL, ECS_INTERNAL_ERROR, 0);
+
+    ecs_table_t **buffer = ecs_vector_first(tables);
+    uint32_t i, count = ecs_vector_count(tables);
+
+    for (i = 0; i < count; i ++) {
+        rematch_table(world, system, system_data, buffer[i]);
+    }
+
+    rematch_finalize(world, system, system_data);
+}
+
+/* Test if system has a column that uses the entity as a fixed source */
+bool ecs_system_refers_to(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    ecs_entity_t entity)
+{
+    if (system == entity) {
+        return true;
+    }
+
+    EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
+    ecs_assert(system_data != NULL, ECS_INTERNAL_ERROR, 0);
+
+    ecs_system_column_t *columns = ecs_vector_first(system_data->base.columns);
+    uint32_t i, count = ecs_vector_count(system_data->base.columns);
+
+    for (i = 0; i < count; i ++) {
+        if (columns[i].kind == EcsFromEntity && columns[i].source == entity) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/** Revalidate references of the matched tables in a vector */
+static
+void revalidate_table_refs(
+    ecs_world_t *world,
+    ecs_vector_t *tables)
+{
+    uint32_t i, count = ecs_vector_count(tables);
+    ecs_matched_table_t *table_data = ecs_vector_first(tables);
 
     for (i = 0; i < count; i ++) {
         if (!table_data[i].references) {
@@ -735,13 +976,30 @@ void ecs_revalidate_system_refs(
 
         for (r = 0; r < ref_count; r ++) {
             ecs_reference_t ref = refs[r];
-            ecs_entity_info_t info = {.entity = ref.entity};
-            refs[r].cached_ptr = ecs_get_ptr_intern(
-                world, &world->main_stage, &info, ref.component, false, true);
+            refs[r].cached_ptr = ecs_get_ref_ptr(
+                world, ref.entity, ref.component);
         }            
     }
 }
 
+/** Revalidate references after the storage of a referenced table moved */
+void ecs_revalidate_system_refs(
+    ecs_world_t *world,
+    ecs_entity_t system)
+{
+    EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
+    ecs_assert(system_data != NULL, ECS_INTERNAL_ERROR, 0);
+
+    if (!system_data->base.has_refs) {
+        return;
+    }
+
+    /* Inactive tables are revalidated too, as they may be activated before
+     * the next time references are revalidated */
+    revalidate_table_refs(world, system_data->tables);
+    revalidate_table_refs(world, system_data->inactive_tables);
+}
+
 /** Match new table against system (table is created after system) */
 void ecs_col_system_notify_of_table(
     ecs_world_t *world,
@@ -756,30 +1014,6 @@ void ecs_col_system_notify_of_table(
     }
 }
 
-/** Get index of table in system's matched tables */
-static
-int32_t get_table_param_index(
-    ecs_world_t *world,
-    EcsColSystem *system_data,
-    ecs_table_t *table,
-    ecs_vector_t *tables)
-{
-    uint32_t i, count = ecs_vector_count(tables);
-    ecs_matched_table_t *table_data = ecs_vector_first(tables);
-    (void)world;
-    (void)system_data;
-
-    for (i = 0; i < count; i ++) {
-        if (table_data[i].table == table) {
-            break;
-        }
-    }
-
-    ecs_assert(i != count, ECS_INTERNAL_ERROR, NULL);
-
-    return i;
-}
-
 /** Table activation happens when a table was or becomes empty. Deactivated
  * tables are not considered by the system in the main loop. */
 void ecs_system_activate_table(
@@ -803,10 +1037,27 @@ void ecs_system_activate_table(
         dst_array = system_data->inactive_tables;
     }
 
-    int32_t i = get_table_param_index(world, system_data, table, src_array);
+    bool is_active = false;
+    int32_t i = get_table_index(system_data, table, &is_active);
+    ecs_assert(i != -1, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(is_active != active, ECS_INTERNAL_ERROR, NULL);
 
-    uint32_t src_count = ecs_vector_move_index(
-        &dst_array, src_array, &matched_table_params, i);
+    /* Keep the depth order of the active tables of a CASCADE system */
+    if (!active && system_data->base.cascade_by) {
+        i = remove_cascade_table(system_data, i);
+    }
+
+    /* Append table to the destination, and move the last table of the source
+     * into the slot of the table, which only updates two positions */
+    ecs_matched_table_t *dst_elem = ecs_vector_add(
+        &dst_array, &matched_table_params);
+    *dst_elem = *(ecs_matched_table_t*)ecs_vector_get(
+        src_array, &matched_table_params, i);
+    set_table_index(
+        system_data, table, ecs_vector_count(dst_array) - 1, active);
+
+    uint32_t src_count = remove_table_index(
+        system_data, src_array, i, !active);
 
     if (active) {
         uint32_t dst_count = ecs_vector_count(dst_array);
@@ -815,6 +1066,13 @@ void ecs_system_activate_table(
                 world, system, kind, true);
         }
         system_data->tables = dst_array;
+
+        if (system_data->base.cascade_by) {
+            ecs_matched_table_t *table_data = ecs_vector_get(
+                dst_array, &matched_table_params, dst_count - 1);
+            table_data->depth = ecs_table_depth(world, table);
+            insert_cascade_table(system_data);
+        }
     } else {
         if (src_count == 0) {
             ecs_world_activate_system(
@@ -837,8 +1095,7 @@ ecs_entity_t ecs_new_col_system(
 
     ecs_entity_t result = _ecs_new(world, world->t_col_system);
 
-    EcsId *id_data = ecs_get_ptr(world, result, EcsId);
-    *id_data = id;
+    ecs_set(world, result, EcsId, {id});
 
     EcsColSystem *system_data = ecs_get_ptr(world, result, EcsColSystem);
     memset(system_data, 0, sizeof(EcsColSystem));
@@ -871,6 +1128,8 @@ ecs_entity_t ecs_new_col_system(
 
     ecs_system_compute_and_families(world, &system_data->base);
 
+    compute_inout_types(world, system_data);
+
     ecs_system_init_base(world, &system_data->base);
 
     if (system_data->base.needs_tables) {
@@ -918,6 +1177,53 @@ ecs_entity_t ecs_new_col_system(
     return result;
 }
 
+/** A table changed for a system if an owned column the system reads from was
+ * written after the previous invocation of the system. Changes to components
+ * of other entities are not tracked, so tables with references always run. */
+static
+bool table_changed(
+    EcsColSystem *system_data,
+    ecs_matched_table_t *table,
+    ecs_table_column_t *table_data,
+    uint64_t since_tick)
+{
+    if (!since_tick || table->references) {
+        return true;
+    }
+
+    ecs_system_column_t *buffer = ecs_vector_first(system_data->base.columns);
+    uint32_t i, count = ecs_vector_count(system_data->base.columns);
+    bool has_input = false;
+
+    for (i = 0; i < count; i ++) {
+        int32_t column = table->columns[i];
+        if (column <= 0 || buffer[i].inout_kind == EcsOut) {
+            continue;
+        }
+
+        if (table_data[column].changed > since_tick) {
+            return true;
+        }
+
+        has_input = true;
+    }
+
+    /* A system that doesn't read from the table can't skip it */
+    return !has_input;
+}
+
+void ecs_col_system_begin_run(
+    ecs_world_t *world,
+    EcsColSystem *system_data)
+{
+    /* Columns written by the system are stamped with run_tick, so that the
+     * next invocation doesn't see them as changed. Writes after the system
+     * get a higher tick. */
+    system_data->since_tick = system_data->run_tick;
+    system_data->run_tick = ++ world->change_tick;
+    world->change_tick ++;
+}
+
 ecs_entity_t ecs_run_intern(
     ecs_world_t *world,
     ecs_world_t *real_world,
@@ -945,6 +1251,10 @@ ecs_entity_t ecs_run_intern(
     float period = system_data->period;
     bool measure_time = real_world->measure_system_time;
 
+    /* Jobs of the same system run in parallel, and are measured per thread.
+     * Only invocations that cover all tables are measured per table. */
+    bool measure_tables = measure_time && world == real_world;
+
     ecs_matched_table_t *tables = ecs_vector_first(system_data->tables);
     uint32_t i, table_count = ecs_vector_count(system_data->tables);
 
@@ -952,8 +1262,9 @@ ecs_entity_t ecs_run_intern(
         return 0;
     }
 
-    if (period) {
-        if (!should_run(system_data, period, delta_time)) {
+    /* Jobs of periodic systems are only prepared when the system should run */
+    if (period && world == real_world) {
+        if (!ecs_col_system_should_run(system_data, delta_time)) {
             return 0;
         }
     }
@@ -963,6 +1274,22 @@ ecs_entity_t ecs_run_intern(
         ecs_os_get_time(&time_start);
     }
 
+    ecs_trace_buffer_t *trace = ecs_trace_get_buffer(world);
+    ecs_time_t trace_start;
+    int32_t trace_tables = 0, trace_rows = 0;
+    if (trace) {
+        ecs_os_get_time(&trace_start);
+    }
+
+    /* Jobs share the change ticks set when the jobs were prepared */
+    if (world == real_world) {
+        ecs_col_system_begin_run(real_world, system_data);
+    }
+
+    uint64_t since_tick = system_data->since_tick;
+    uint64_t run_tick = system_data->run_tick;
+    bool changed_only = system_data->changed_only;
+
     uint32_t column_count = ecs_vector_count(system_data->base.columns);
     ecs_entity_t interrupted_by = 0;
     ecs_system_action_t action = system_data->base.action;
@@ -1029,6 +1356,15 @@ ecs_entity_t ecs_run_intern(
                 continue;
             }
 
+            if (changed_only && 
+                !table_changed(system_data, table, table_data, since_tick)) 
+            {
+                continue;
+            }
+
+            ecs_system_detach_columns(real_world, &system_data->base, 
+                world_table, table_data, table->columns, run_tick);
+
             ecs_entity_t *entity_buffer = 
                     ecs_vector_first(table_data[0].data);
             info.entities = &entity_buffer[first];            
@@ -1046,11 +1382,20 @@ ecs_entity_t ecs_run_intern(
         info.components = table->components;
         info.offset = first;
         info.count = count;
-        
-        action(&info);
+
+        if (measure_tables && world_table) {
+            ecs_time_t table_start;
+            ecs_os_get_time(&table_start);
+            action(&info);
+            world_table->time_spent += ecs_time_measure(&table_start);
+        } else {
+            action(&info);
+        }
 
         info.frame_offset += count;
         info.table_offset ++;
+        trace_tables ++;
+        trace_rows += count;
 
         if (info.interrupted_by) {
             interrupted_by = info.interrupted_by;
@@ -1059,11 +1404,20 @@ ecs_entity_t ecs_run_intern(
     }
 
     if (measure_time) {
-        system_data->base.time_spent += ecs_time_measure(&time_start);
+        double t = ecs_time_measure(&time_start);
+        system_data->base.time_spent += t;
+        if (measure_tables) {
+            ecs_time_histogram_record(&system_data->base.time_histogram, t);
+        }
     }
     
     system_data->base.invoke_count ++;
 
+    if (trace) {
+        ecs_trace_push_system(
+            trace, system, trace_start, trace_tables, trace_rows);
+    }
+
     return interrupted_by;
 }
 
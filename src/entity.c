@@ -3,6 +3,7 @@
 
 static
 void copy_column(
+    ecs_world_t *world,
     ecs_table_column_t *new_column,
     int32_t new_index,
     ecs_table_column_t *old_column,
@@ -15,6 +16,9 @@ void copy_column(
     if (size) {
         ecs_vector_params_t param = {.element_size = new_column->size};
 
+        ecs_table_detach_column(world, new_column);
+        new_column->changed = world->change_tick;
+
         if (old_index < 0) old_index *= -1;
         
         void *dst = ecs_vector_get(new_column->data, &param, new_index - 1);
@@ -29,6 +33,7 @@ void copy_column(
 
 static
 void copy_row(
+    ecs_world_t *world,
     ecs_type_t new_type,
     ecs_table_column_t *new_columns,
     int32_t new_index,
@@ -61,7 +66,8 @@ void copy_row(
         }
 
         if (new_component == old_component) {
-            copy_column(&new_columns[i_new + 1], new_index, &old_columns[i_old + 1], old_index);
+            copy_column(world, &new_columns[i_new + 1], new_index, 
+                &old_columns[i_old + 1], old_index);
             i_new ++;
             i_old ++;
         } else if (new_component < old_component) {
@@ -101,14 +107,43 @@ void* get_row_ptr(
     }
 }
 
+/* Same as get_row_ptr, but for data that can be written to. A column that is
+ * shared with a snapshot is copied before it is returned. */
+static
+void* get_mutable_row_ptr(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_table_column_t *columns,
+    int32_t index,
+    ecs_entity_t component,
+    bool is_changed)
+{
+    int16_t column_index = ecs_type_index_of(table->type, component);
+    if (column_index == -1) {
+        return NULL;
+    }
+
+    ecs_table_column_t *column = &columns[column_index + 1];
+    if (column->size) {
+        ecs_table_detach_column(world, column);
+        ecs_table_bump_version(world, table);
+    }
+
+    if (is_changed) {
+        column->changed = world->change_tick;
+    }
+
+    return get_row_ptr(table->type, columns, index, component);
+}
+
 static
 ecs_row_t row_from_stage(
     ecs_stage_t *stage,
     ecs_entity_t entity)
 {
-    ecs_row_t row;
-    if (ecs_map_has(stage->entity_index, entity, &row)) {
-        return row;
+    ecs_row_t *row = ecs_ei_get(stage->entity_index, entity);
+    if (row) {
+        return *row;
     } else {
         return (ecs_row_t){0, 0};
     }
@@ -120,11 +155,11 @@ bool stage_has_entity(
     ecs_entity_t entity,
     ecs_row_t *row_out)
 {
-    ecs_row_t row;
+    ecs_row_t *row = ecs_ei_get(stage->entity_index, entity);
 
-    if (ecs_map_has(stage->entity_index, entity, &row)) {
-        if (row.index) {
-            *row_out = row;
+    if (row) {
+        if (row->index) {
+            *row_out = *row;
             return true;
         } else {
             return false;
@@ -265,6 +300,92 @@ bool notify_post_merge(
     return result;
 }
 
+static
+bool notify_after_commit(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_entity_info_t *info,
+    uint32_t offset,
+    uint32_t limit,
+    ecs_type_t to_add_id,
+    bool do_set);
+
+static
+ecs_entity_t new_entity_handle(
+    ecs_world_t *world);
+
+/** Create the children of a prefab for a set of instances. Space for all
+ * children is reserved at once, and each child is inserted directly in the
+ * table of its final type (the type of the builder op with the instance as
+ * parent), with its EcsId already set. This replaces creating the child in the
+ * table of the builder op type, followed by an adopt and a set, which would
+ * each move the child to another table. */
+static
+void instantiate_children(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    EcsPrefabBuilder *builder,
+    ecs_entity_t *instances,
+    uint32_t limit)
+{
+    ecs_ei_t *entity_index = stage->entity_index;
+    int32_t i, count = ecs_vector_count(builder->ops);
+    ecs_builder_op_t *ops = ecs_vector_first(builder->ops);
+
+    ecs_ei_grow(entity_index, count * limit);
+
+    uint32_t j;
+    for (j = 0; j < limit; j ++) {
+        ecs_entity_t parent = instances[j] | ECS_CHILDOF;
+        ecs_type_t parent_type = ecs_type_find_intern(world, stage, &parent, 1);
+
+        for (i = 0; i < count; i ++) {
+            ecs_builder_op_t *op = &ops[i];
+
+            /* Children can reuse the ids of deleted entities */
+            ecs_entity_t child = new_entity_handle(world);
+            ecs_assert(!world->max_handle || child <= world->max_handle, 
+                ECS_OUT_OF_RANGE, NULL);
+
+            /* The type of an op does not always contain EcsId */
+            ecs_type_t op_type = ecs_type_merge_intern(
+                world, stage, op->type, ecs_type(EcsId), 0);
+            int16_t id_column = ecs_type_index_of(op_type, EEcsId);
+
+            ecs_type_t type = ecs_type_merge_intern(
+                world, stage, op_type, parent_type, 0);
+
+            ecs_table_t *table = ecs_world_get_table(world, stage, type);
+            ecs_table_column_t *columns = ecs_table_get_columns(
+                world, stage, table);
+
+            uint32_t index = ecs_table_insert(world, table, columns, child);
+            ecs_ei_set(entity_index, child, 
+                &((ecs_row_t){.type = type, .index = index}));
+
+            /* Parents are stored after components in a type, so the column of
+             * EcsId is the same as in the type of the builder op */
+            EcsId *ids = ecs_vector_first(columns[id_column + 1].data);
+            ids[index - 1] = op->id;
+
+            ecs_entity_info_t info = {
+                .entity = child,
+                .type = type,
+                .table = table,
+                .columns = columns,
+                .index = index
+            };
+
+            /* Invoke OnAdd systems and copy components from the prefab of the
+             * child, which instantiates its children if it has any */
+            notify_after_commit(world, stage, &info, 0, 1, type, true);
+
+            notify_pre_merge(world, stage, info.table, info.columns, 
+                info.index - 1, 1, ecs_type(EcsId), world->type_sys_set_index);
+        }
+    }
+}
+
 static
 ecs_type_t instantiate_prefab(
     ecs_world_t *world,
@@ -275,12 +396,11 @@ ecs_type_t instantiate_prefab(
     uint32_t limit,
     ecs_type_t modified)
 {
-    ecs_type_t prefab_type = prefab_info->type;
     ecs_table_column_t *prefab_columns = prefab_info->table->columns;
     ecs_table_column_t *entity_columns = ecs_table_get_columns(world, stage, entity_info->table);
     ecs_entity_t *entity_ids = ecs_vector_first(entity_columns[0].data);
 
-    EcsPrefabBuilder *builder = get_row_ptr(prefab_type, 
+    EcsPrefabBuilder *builder = get_row_ptr(prefab_info->table->type, 
         prefab_columns, prefab_info->index, EEcsPrefabBuilder);
 
     /* If the current entity is not a prefab itself, and the prefab
@@ -290,17 +410,24 @@ ecs_type_t instantiate_prefab(
             int32_t i, count = ecs_vector_count(builder->ops);
             ecs_builder_op_t *ops = ecs_vector_first(builder->ops);
 
-            for (i = 0; i < count; i ++) {
-                ecs_builder_op_t *op = &ops[i];
-                ecs_entity_t child = _ecs_new_w_count(
-                    world, op->type, limit);
-
-                uint32_t j;
-                for (j = 0; j < limit; j ++) {
-                    uint32_t index = entity_info->index + j - 1;
-                    ecs_entity_t entity = entity_ids[index];
-                    ecs_adopt(world, child + j, entity);
-                    ecs_set(world, child + j, EcsId, {op->id});
+            /* While iterating, children are created with regular operations
+             * so that they are staged */
+            if (!world->in_progress) {
+                instantiate_children(world, stage, builder, 
+                    &entity_ids[entity_info->index - 1], limit);
+            } else {
+                for (i = 0; i < count; i ++) {
+                    ecs_builder_op_t *op = &ops[i];
+                    ecs_entity_t child = _ecs_new_w_count(
+                        world, op->type, limit);
+
+                    uint32_t j;
+                    for (j = 0; j < limit; j ++) {
+                        uint32_t index = entity_info->index + j - 1;
+                        ecs_entity_t entity = entity_ids[index];
+                        ecs_adopt(world, child + j, entity);
+                        ecs_set(world, child + j, EcsId, {op->id});
+                    }
                 }
             }
         }
@@ -427,6 +554,7 @@ ecs_type_t copy_from_prefab(
             }
             
             ecs_table_column_t *dst_column = &columns[dst_col_index + 1];
+            ecs_table_detach_column(world, dst_column);
             void *dst_column_data = ecs_vector_first(dst_column->data);
             void *dst_ptr = ECS_OFFSET(
                 dst_column_data, size * (info->index - 1 + offset));
@@ -543,20 +671,22 @@ bool notify_after_commit(
 }
 
 /** Commit an entity with a specified type to a table (probably the most 
- * important function in flecs). */
+ * important function in flecs). If the table for the type is already known,
+ * it can be passed in as dst_table, which saves a table lookup. */
 static
 uint32_t commit(
     ecs_world_t *world,
     ecs_stage_t *stage,
     ecs_entity_info_t *info,
     ecs_type_t type,
+    ecs_table_t *dst_table,
     ecs_type_t to_add,
     ecs_type_t to_remove,
     bool do_set)
 {
     ecs_table_t *new_table = NULL, *old_table;
     ecs_table_column_t *new_columns = NULL, *old_columns;
-    ecs_map_t *entity_index = stage->entity_index;
+    ecs_ei_t *entity_index = stage->entity_index;
     ecs_type_t old_type = NULL;
     int32_t new_index = 0, old_index = 0;
     bool in_progress = world->in_progress;
@@ -633,8 +763,9 @@ uint32_t commit(
          * is merged, which will invoke commit again. */
 
         if (stage->range_check_enabled) {
-            ecs_assert(!world->max_handle || entity <= world->max_handle, ECS_OUT_OF_RANGE, 0);
-            ecs_assert(entity >= world->min_handle, ECS_OUT_OF_RANGE, 0);
+            ecs_entity_t index = entity & ECS_ENTITY_INDEX_MASK;
+            ecs_assert(!world->max_handle || index <= world->max_handle, ECS_OUT_OF_RANGE, 0);
+            ecs_assert(index >= world->min_handle, ECS_OUT_OF_RANGE, 0);
         }
     }
 
@@ -645,12 +776,27 @@ uint32_t commit(
      * component from, for example, a container. */
     if (info->is_watched) {
         world->should_match = true;
+        world->should_resolve = true;
+        world->ref_version ++;
+
+        /* Only the tables that refer to the entity need to be rematched. Staged
+         * changes are recorded when the stage is merged. */
+        if (!in_progress) {
+            ecs_entity_t *elem = ecs_vector_add(
+                &world->match_entities, &handle_arr_params);
+            *elem = entity;
+        }
     }
 
     /* If the new type contains components (that is, it is not 0) obtain the new
      * table and new columns. */
     if (type) {
-        new_table = ecs_world_get_table(world, stage, type);
+        if (dst_table) {
+            ecs_assert(dst_table->type == type, ECS_INTERNAL_ERROR, NULL);
+            new_table = dst_table;
+        } else {
+            new_table = ecs_world_get_table(world, stage, type);
+        }
 
         /* This operation will automatically obtain components from the stage if
          * the application is iterating. */
@@ -664,7 +810,7 @@ uint32_t commit(
     /* Copy components from old table to new table, only if the entity was not
      * empty, and will not be empty */
     if (old_type && type) {
-        copy_row(new_table->type, new_columns, new_index, 
+        copy_row(world, new_table->type, new_columns, new_index, 
             old_type, old_columns, old_index);
     }
 
@@ -677,14 +823,14 @@ uint32_t commit(
             new_row.index *= -1;
         }
 
-        ecs_map_set(entity_index, entity, &new_row);
+        ecs_ei_set(entity_index, entity, &new_row);
     } else {
         if (in_progress) {
             /* The entity must be kept in the stage index because otherwise the
              * merge doesn't know that it needs to merge data for the entity */
-            ecs_map_set(entity_index, entity, &((ecs_row_t){0, 0}));
+            ecs_ei_set(entity_index, entity, &((ecs_row_t){0, 0}));
         } else {
-            ecs_map_remove(entity_index, entity);
+            ecs_ei_remove(entity_index, entity);
         }
     }
 
@@ -712,6 +858,16 @@ uint32_t commit(
         if (old_type) {
             ecs_table_delete(world, NULL, old_table, old_columns, old_index);
         }
+
+        /* Parents are watched. If a parent moved to a table with a different
+         * depth, the depth of the tables with its children is out of date. */
+        if (info->is_watched || info->index < 0) {
+            if (!old_table || !new_table || old_table->depth < 0 ||
+                old_table->depth != new_table->depth)
+            {
+                ecs_table_invalidate_depth(world, entity);
+            }
+        }
     }
 
     uint32_t last_count = ++ stage->commit_count;
@@ -783,8 +939,8 @@ void* get_ptr_from_prefab(
 
         ecs_entity_info_t prefab_info = {.entity = prefab};
         if (populate_info(world, &world->main_stage, &prefab_info)) {
-            ptr = get_row_ptr(prefab_info.table->type, prefab_info.columns, 
-                prefab_info.index, component);
+            ptr = get_row_ptr(prefab_info.table->type, 
+                prefab_info.columns, prefab_info.index, component);
             
             if (!ptr) {
                 ptr = get_ptr_from_prefab(
@@ -815,7 +971,8 @@ void* ecs_get_ptr_intern(
 
     if (world->in_progress && stage != &world->main_stage) {
         if (populate_info(world, stage, info)) {
-            ptr = get_row_ptr(info->table->type, info->columns, info->index, component);
+            ptr = get_row_ptr(info->table->type, info->columns, 
+                info->index, component);
         }
 
         if (!ptr && search_prefab) {
@@ -862,6 +1019,37 @@ void* ecs_get_ptr_intern(
     return ptr;
 }
 
+/* Systems cache pointers to components of entities they reference. The table
+ * that stores the component is flagged, so that only moving the storage of
+ * flagged tables requires systems to resolve their references again. */
+void* ecs_get_ref_ptr(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_entity_t component)
+{
+    ecs_entity_info_t info = {.entity = entity};
+    void *ptr = ecs_get_ptr_intern(
+        world, &world->main_stage, &info, component, false, false);
+
+    if (!ptr && info.type) {
+        ecs_entity_t prefab = ecs_find_entity_in_prefabs(
+            world, entity, info.type, component, 0);
+
+        if (prefab) {
+            info = (ecs_entity_info_t){.entity = prefab};
+            ptr = ecs_get_ptr_intern(
+                world, &world->main_stage, &info, component, false, false);
+        }
+    }
+
+    if (ptr) {
+        ecs_assert(info.table != NULL, ECS_INTERNAL_ERROR, NULL);
+        info.table->flags |= EcsTableIsReferenced;
+    }
+
+    return ptr;
+}
+
 ecs_type_t ecs_notify(
     ecs_world_t *world,
     ecs_stage_t *stage,
@@ -932,7 +1120,7 @@ void ecs_merge_entity(
     }
 
     int32_t new_index = commit(
-        world, &world->main_stage, &info, type, 0, to_remove, false);
+        world, &world->main_stage, &info, type, NULL, 0, to_remove, false);
     
     if (type && staged_type) {
         ecs_table_t *new_table = ecs_world_get_table(world, &world->main_stage, type);
@@ -943,8 +1131,248 @@ void ecs_merge_entity(
         ecs_map_has(stage->data_stage, (uintptr_t)staged_row.type, &staged_columns);
         ecs_assert(staged_columns != NULL, ECS_INTERNAL_ERROR, NULL);
 
-        copy_row( new_table->type, new_table->columns, new_index,
+        copy_row(world, new_table->type, new_table->columns, new_index,
                 staged_table->type, staged_columns, staged_row.index); 
+
+        /* Values set in the stage are copied to the same table if the type of
+         * the entity did not change */
+        new_table->version ++;
+    }
+}
+
+/** Staged entity that is merged together with the other staged entities that
+ * move between the same tables. */
+typedef struct ecs_merge_row_t {
+    ecs_entity_t entity;        /* Staged entity */
+    ecs_type_t old_type;        /* Type of entity in main stage (if any) */
+    ecs_table_t *old_table;     /* Table to delete entity from after merge */
+    int32_t old_index;          /* Row of entity in main stage table */
+    ecs_type_t staged_type;     /* Type of entity in stage */
+    int32_t staged_index;       /* Row of entity in staged columns */
+} ecs_merge_row_t;
+
+static const ecs_vector_params_t merge_row_params = {
+    .element_size = sizeof(ecs_merge_row_t)
+};
+
+/** Order merged rows by staged type and main stage type */
+static
+int compare_merge_group(
+    const void *p1,
+    const void *p2)
+{
+    const ecs_merge_row_t *r1 = p1, *r2 = p2;
+
+    if (r1->staged_type != r2->staged_type) {
+        return (uintptr_t)r1->staged_type < (uintptr_t)r2->staged_type ? -1 : 1;
+    }
+
+    if (r1->old_type != r2->old_type) {
+        return (uintptr_t)r1->old_type < (uintptr_t)r2->old_type ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/** Order merged rows by main stage table, and by descending row index so that
+ * deleting a row never moves a row that still has to be deleted. */
+static
+int compare_merge_delete(
+    const void *p1,
+    const void *p2)
+{
+    const ecs_merge_row_t *r1 = p1, *r2 = p2;
+
+    if (r1->old_table != r2->old_table) {
+        return (uintptr_t)r1->old_table < (uintptr_t)r2->old_table ? -1 : 1;
+    }
+
+    return r2->old_index - r1->old_index;
+}
+
+/** Check if a staged entity can be merged together with other entities. Only
+ * entities that add or set components are merged in bulk. Entities that remove
+ * components or are watched require notifications, and are merged one by
+ * one with ecs_merge_entity. */
+static
+bool prepare_merge_row(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_entity_t entity,
+    ecs_row_t *staged_row,
+    ecs_merge_row_t *row_out)
+{
+    if (!staged_row->type || staged_row->index <= 0) {
+        return false;
+    }
+
+    if (ecs_map_get_ptr(stage->remove_merge, entity)) {
+        return false;
+    }
+
+    ecs_row_t old_row = {0};
+    if (stage_has_entity(&world->main_stage, entity, &old_row)) {
+        if (old_row.index < 0) {
+            return false;
+        }
+    }
+
+    row_out->entity = entity;
+    row_out->old_type = old_row.type;
+    row_out->old_table = NULL;
+    row_out->old_index = old_row.index;
+    row_out->staged_type = staged_row->type;
+    row_out->staged_index = staged_row->index;
+
+    return true;
+}
+
+/** Merge staged entities that have the same staged type and the same table in
+ * the main stage. The entities end up in the same table, which is grown once
+ * for the entire group. Rows are removed from the old table afterwards. */
+static
+void merge_group(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_merge_row_t *rows,
+    int32_t count)
+{
+    ecs_stage_t *main_stage = &world->main_stage;
+    ecs_type_t old_type = rows[0].old_type;
+    ecs_type_t staged_type = rows[0].staged_type;
+    ecs_table_t *old_table = NULL;
+    int32_t i;
+
+    if (old_type) {
+        old_table = ecs_world_get_table(world, stage, old_type);
+        ecs_assert(old_table != NULL, ECS_INTERNAL_ERROR, NULL);
+    }
+
+    ecs_type_t type = ecs_type_merge_intern(
+        world, stage, old_type, staged_type, NULL);
+    ecs_assert(type != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_table_t *staged_table = ecs_world_get_table(world, stage, staged_type);
+    ecs_table_column_t *staged_columns = NULL;
+    ecs_map_has(stage->data_stage, (uintptr_t)staged_type, &staged_columns);
+    ecs_assert(staged_columns != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    /* If the type did not change, only the staged values have to be copied */
+    if (type == old_type) {
+        for (i = 0; i < count; i ++) {
+            copy_row(world, old_type, old_table->columns, rows[i].old_index,
+                staged_table->type, staged_columns, rows[i].staged_index);
+        }
+
+        old_table->version ++;
+        return;
+    }
+
+    ecs_table_t *new_table = ecs_world_get_table(world, main_stage, type);
+    ecs_assert(new_table != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_table_column_t *new_columns = ecs_table_get_columns(
+        world, main_stage, new_table);
+    ecs_assert(new_columns != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    int32_t new_index = ecs_table_grow(
+        world, new_table, new_columns, count, 0);
+
+    ecs_entity_t *entities = ecs_vector_first(new_columns[0].data);
+    entities = &entities[new_index - 1];
+
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t entity = rows[i].entity;
+        entities[i] = entity;
+
+        if (old_table) {
+            copy_row(world, type, new_columns, new_index + i, 
+                old_type, old_table->columns, rows[i].old_index);
+
+            /* Entity is deleted from the old table after all groups are 
+             * merged */
+            rows[i].old_table = old_table;
+        } else if (main_stage->range_check_enabled) {
+            ecs_entity_t index = entity & ECS_ENTITY_INDEX_MASK;
+            ecs_assert(!world->max_handle || index <= world->max_handle, 
+                ECS_OUT_OF_RANGE, 0);
+            ecs_assert(index >= world->min_handle, ECS_OUT_OF_RANGE, 0);
+        }
+
+        copy_row(world, type, new_columns, new_index + i, 
+            staged_table->type, staged_columns, rows[i].staged_index);
+
+        ecs_ei_set(main_stage->entity_index, entity, 
+            &((ecs_row_t){.type = type, .index = new_index + i}));
+    }
+
+    new_table->version ++;
+    main_stage->commit_count ++;
+    world->valid_schedule = false;
+}
+
+void ecs_merge_entities(
+    ecs_world_t *world,
+    ecs_stage_t *stage)
+{
+    ecs_vector_clear(stage->merge_rows);
+    ecs_vector_clear(stage->merge_entities);
+
+    /* Split staged entities in entities that can be merged per table, and
+     * entities that need to be merged one by one */
+    ecs_ei_iter_t it = ecs_ei_iter(stage->entity_index);
+    while (ecs_ei_hasnext(&it)) {
+        ecs_entity_t entity;
+        ecs_row_t *row = ecs_ei_next(&it, &entity);
+        ecs_merge_row_t merge_row;
+
+        if (prepare_merge_row(world, stage, entity, row, &merge_row)) {
+            ecs_merge_row_t *elem = ecs_vector_add(
+                &stage->merge_rows, &merge_row_params);
+            *elem = merge_row;
+        } else {
+            ecs_entity_t *elem = ecs_vector_add(
+                &stage->merge_entities, &handle_arr_params);
+            *elem = entity;
+        }
+    }
+
+    /* Move entities that go from the same table to the same table at once.
+     * Rows are not yet deleted from the old tables, so that the row indices
+     * of all merge rows remain valid while the groups are merged. */
+    ecs_vector_sort(stage->merge_rows, &merge_row_params, compare_merge_group);
+
+    ecs_merge_row_t *rows = ecs_vector_first(stage->merge_rows);
+    int32_t i, count = ecs_vector_count(stage->merge_rows);
+
+    for (i = 0; i < count; ) {
+        int32_t last = i + 1;
+        while (last < count && !compare_merge_group(&rows[i], &rows[last])) {
+            last ++;
+        }
+
+        merge_group(world, stage, &rows[i], last - i);
+        i = last;
+    }
+
+    /* Delete moved entities from their old tables */
+    ecs_vector_sort(stage->merge_rows, &merge_row_params, compare_merge_delete);
+
+    for (i = 0; i < count; i ++) {
+        if (rows[i].old_table) {
+            ecs_table_delete(
+                world, NULL, rows[i].old_table, NULL, rows[i].old_index);
+        }
+    }
+
+    /* Merge remaining entities */
+    ecs_entity_t *entities = ecs_vector_first(stage->merge_entities);
+    count = ecs_vector_count(stage->merge_entities);
+
+    for (i = 0; i < count; i ++) {
+        ecs_row_t *row = ecs_ei_get(stage->entity_index, entities[i]);
+        ecs_assert(row != NULL, ECS_INTERNAL_ERROR, NULL);
+        ecs_merge_entity(world, stage, entities[i], *row);
     }
 }
 
@@ -965,7 +1393,7 @@ void ecs_set_watch(
         row.type = NULL;
     }
 
-    ecs_map_set(stage->entity_index, entity, &row);
+    ecs_ei_set(stage->entity_index, entity, &row);
 }
 
 bool ecs_components_contains_component(
@@ -1011,15 +1439,67 @@ void ecs_add_remove_intern(
     ecs_assert(!world->is_merging, ECS_INVALID_WHILE_MERGING, NULL);
     
     ecs_type_t dst_type = 0;
+    ecs_table_t *dst_table = NULL;
 
     if (populate_info(world, stage, info)) {
-        dst_type = ecs_type_merge_intern(
-            world, stage, info->table->type, to_add, to_remove);
+        /* When adding or removing a single component outside of progress, the
+         * destination table can be found by following the table edges */
+        if (!world->in_progress) {
+            if (to_add && !to_remove && ecs_vector_count(to_add) == 1) {
+                dst_table = ecs_table_traverse_add(
+                    world, stage, info->table, to_add);
+            } else if (to_remove && !to_add && ecs_vector_count(to_remove) == 1) {
+                dst_table = ecs_table_traverse_remove(
+                    world, stage, info->table, to_remove);
+            }
+        }
+
+        if (dst_table) {
+            dst_type = dst_table->type;
+        } else {
+            dst_type = ecs_type_merge_intern(
+                world, stage, info->table->type, to_add, to_remove);
+        }
     } else {
         dst_type = to_add;
     }
 
-    commit(world, stage, info, dst_type, to_add, to_remove, do_set);
+    commit(world, stage, info, dst_type, dst_table, to_add, to_remove, do_set);
+}
+
+void ecs_release_entity(
+    ecs_world_t *world,
+    ecs_entity_t entity)
+{
+    ecs_ei_t *entity_index = world->main_stage.entity_index;
+
+    /* Ids above the last issued handle will be handed out by the counter at
+     * some point, so they cannot be recycled as well */
+    if ((entity & ECS_ENTITY_INDEX_MASK) <= world->last_handle) {
+        ecs_ei_delete(entity_index, entity);
+    } else {
+        ecs_ei_remove(entity_index, entity);
+    }
+}
+
+/** Obtain a new entity id. Ids of deleted entities are recycled when possible,
+ * which is only done from the main thread while not iterating, and when no
+ * entity range is set. */
+static
+ecs_entity_t new_entity_handle(
+    ecs_world_t *world)
+{
+    ecs_entity_t entity = 0;
+
+    if (!world->in_progress && !world->min_handle && !world->max_handle) {
+        entity = ecs_ei_recycle(world->main_stage.entity_index);
+    }
+
+    if (!entity) {
+        entity = ++ world->last_handle;
+    }
+
+    return entity;
 }
 
 /* -- Public functions -- */
@@ -1034,7 +1514,7 @@ ecs_entity_t _ecs_new(
 
     ecs_assert(!world->is_merging, ECS_INVALID_WHILE_MERGING, NULL);
 
-    ecs_entity_t entity = ++ world->last_handle;
+    ecs_entity_t entity = new_entity_handle(world);
 
     ecs_assert(!world->max_handle || entity <= world->max_handle, 
         ECS_OUT_OF_RANGE, NULL);
@@ -1044,7 +1524,7 @@ ecs_entity_t _ecs_new(
             .entity = entity
         };
 
-        commit(world, stage, &info, type, type, 0, true);
+        commit(world, stage, &info, type, NULL, type, 0, true);
     }
 
     return entity;
@@ -1085,6 +1565,7 @@ bool has_unset_columns(
 
 static
 void copy_column_data(
+    ecs_world_t *world,
     ecs_type_t type,
     ecs_table_column_t *columns,
     uint32_t start_row,
@@ -1108,6 +1589,8 @@ void copy_column_data(
 
         uint32_t size = columns[column + 1].size;
         if (size) { 
+            ecs_table_detach_column(world, &columns[column + 1]);
+            columns[column + 1].changed = world->change_tick;
             void *column_data = ecs_vector_first(columns[column + 1].data);
 
             memcpy(
@@ -1224,7 +1707,7 @@ uint32_t update_entity_index(
     int32_t src_first_contiguous_row = 0;
 
     /* Obtain the entity index in the current stage */
-    ecs_map_t *entity_index = stage->entity_index;
+    ecs_ei_t *entity_index = stage->entity_index;
     ecs_entity_t e;
 
     /* We need to commit each entity individually in order to populate
@@ -1253,14 +1736,14 @@ uint32_t update_entity_index(
 
             /* Ensure that the last issued handle will always be ahead of the
              * entities created by this operation */
-            if (e > world->last_handle) {
-                world->last_handle = e + 1;
+            if ((e & ECS_ENTITY_INDEX_MASK) > world->last_handle) {
+                world->last_handle = (e & ECS_ENTITY_INDEX_MASK) + 1;
             }                            
         } else {
             e = i + start_entity;
         }
 
-        ecs_row_t *row_ptr = ecs_map_get_ptr(entity_index, e);
+        ecs_row_t *row_ptr = ecs_ei_get_mut(entity_index, e);
         if (row_ptr) {
             src_row = row_ptr->index;
             uint8_t is_monitored = 1 - (src_row < 0) * 2;
@@ -1320,7 +1803,7 @@ uint32_t update_entity_index(
                     }
 
                     if (has_unset) {
-                        copy_row(type, columns, dst_row + 1, 
+                        copy_row(world, type, columns, dst_row + 1, 
                             old_table->type, old_columns, row_ptr->index);
                     }
 
@@ -1341,7 +1824,7 @@ uint32_t update_entity_index(
                     /* If we're not at the top of the table, simply swap the
                      * next entity with the one that we want at this row. */
                     if (row_count > (dst_start_row + i)) {
-                        ecs_table_swap(stage, table, columns, 
+                        ecs_table_swap(world, stage, table, columns, 
                             src_row, dst_start_row + i, row_ptr, NULL);
 
                     /* We are at the top of the table and the entity is in
@@ -1360,14 +1843,14 @@ uint32_t update_entity_index(
                         /* First, swap the entity preceding the start of the
                          * added entities with the entity that we want at
                          * the end of the block */
-                        ecs_table_swap(stage, table, columns, 
+                        ecs_table_swap(world, stage, table, columns, 
                             src_row, dst_start_row - 1, row_ptr, NULL);
 
                         /* Now move back the whole block back one position, 
                          * while moving the entity before the start to the 
                          * row right after the block */
                         ecs_table_move_back_and_swap(
-                            stage, table, columns, dst_start_row, i);
+                            world, stage, table, columns, dst_start_row, i);
 
                         dst_start_row --;
                         dst_first_contiguous_row --;
@@ -1384,7 +1867,7 @@ uint32_t update_entity_index(
                 .type = type, .index = dst_start_row + i + 1
             };
 
-            ecs_map_set(entity_index, e, &new_row);
+            ecs_ei_set(entity_index, e, &new_row);
 
             if (data->entities) {
                 ecs_table_insert(world, table, columns, e);
@@ -1512,15 +1995,14 @@ ecs_entity_t set_w_data_intern(
         uint32_t start_row = 0;
 
         /* Obtain the entity index in the current stage */
-        ecs_map_t *entity_index = stage->entity_index;
+        ecs_ei_t *entity_index = stage->entity_index;
 
         /* Grow world entity index only if no entity ids are provided. If ids
          * are provided, it is possible that they already appear in the entity
          * index, in which case they will be overwritten. */
-        uint32_t cur_index_count = ecs_map_count(entity_index);
         if (!data->entities) {
             start_row = ecs_table_grow(world, table, columns, count, result) - 1;
-            ecs_map_grow(entity_index, cur_index_count + count);
+            ecs_ei_grow(entity_index, count);
         }
 
         /* Obtain list of entities */
@@ -1530,7 +2012,7 @@ ecs_entity_t set_w_data_intern(
          * row_count number of rows, which will give a perf boost the first time
          * the entities are inserted. */
         if (!entities) {
-            ecs_table_dim(table, columns, count);
+            ecs_table_dim(world, table, columns, count);
             entities = ecs_vector_first(columns[0].data);
             ecs_assert(entities != NULL, ECS_INTERNAL_ERROR, NULL);
         }
@@ -1560,7 +2042,7 @@ ecs_entity_t set_w_data_intern(
          * entities are nicely ordered in the destination table, we can copy the
          * data into each column with a single memcpy. */
         if (data->columns) {
-            copy_column_data(type, columns, start_row, data);
+            copy_column_data(world, type, columns, start_row, data);
         }
 
         /* Invoke OnSet systems */
@@ -1680,6 +2162,12 @@ void ecs_delete(
     ecs_stage_t *stage = ecs_get_stage(&world);
     bool in_progress = world->in_progress;
 
+    /* Deleting an id that has already been deleted (and possibly recycled)
+     * must not affect the entity that currently uses the id */
+    if (!ecs_is_alive(world, entity)) {
+        return;
+    }
+
     if (!in_progress) {
         if (stage_has_entity(&world->main_stage, entity, &row)) {
             ecs_entity_info_t info = {
@@ -1689,10 +2177,10 @@ void ecs_delete(
                 .table = ecs_world_get_table(world, stage, row.type)
             };
 
-            commit(world, stage, &info, 0, 0, row.type, false);
-
-            ecs_map_remove(world->main_stage.entity_index, entity);
+            commit(world, stage, &info, 0, NULL, 0, row.type, false);
         }
+
+        ecs_release_entity(world, entity);
     } else {
         /* Mark components of the entity in the main stage as removed. This will
          * ensure that subsequent calls to ecs_has, ecs_get and ecs_is_empty will
@@ -1703,7 +2191,11 @@ void ecs_delete(
 
         /* Remove the entity from the staged index. Any added components while
          * in progress will be discarded as a result. */
-        ecs_map_set(stage->entity_index, entity, &((ecs_row_t){0, 0}));
+        ecs_ei_set(stage->entity_index, entity, &((ecs_row_t){0, 0}));
+
+        /* The id is released for recycling when the stage is merged */
+        ecs_entity_t *elem = ecs_vector_add(&stage->delete_merge, &handle_arr_params);
+        *elem = entity;
     }
 }
 
@@ -1737,7 +2229,11 @@ void ecs_delete_w_filter_intern(
         ecs_entity_t *array = ecs_vector_first(entities);
         uint32_t j, row_count = ecs_vector_count(entities);
         for (j = 0; j < row_count; j ++) {
-            ecs_map_remove(world->main_stage.entity_index, array[j]);
+            if (is_delete) {
+                ecs_release_entity(world, array[j]);
+            } else {
+                ecs_ei_remove(world->main_stage.entity_index, array[j]);
+            }
         }
 
         /* Both filters passed, clear table */
@@ -1763,6 +2259,28 @@ void ecs_clear_w_filter(
     ecs_delete_w_filter_intern(world, filter, false);
 }
 
+bool ecs_is_alive(
+    ecs_world_t *world,
+    ecs_entity_t entity)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_get_stage(&world);
+
+    if (!entity) {
+        return false;
+    }
+
+    ecs_ei_t *entity_index = world->main_stage.entity_index;
+    if (!ecs_ei_is_alive(entity_index, entity)) {
+        return false;
+    }
+
+    /* Entities without components are not stored in the entity index. Such
+     * entities are alive if their id has been issued. */
+    return ecs_ei_get(entity_index, entity) != NULL ||
+        (entity & ECS_ENTITY_INDEX_MASK) <= world->last_handle;
+}
+
 void _ecs_add_remove_w_filter(
     ecs_world_t *world,
     ecs_type_t to_add,
@@ -1839,17 +2357,17 @@ ecs_entity_t copy_from_stage(
 
         ecs_assert(!dst_entity, ECS_INTERNAL_ERROR, NULL);
 
-        dst_entity = ++ world->last_handle;
+        dst_entity = new_entity_handle(world);
         new_type = src_info.type;
 
         ecs_entity_info_t info = {
             .entity = dst_entity
         };
 
-        commit(world, stage, &info, new_type, src_info.type, 0, false);
+        commit(world, stage, &info, new_type, NULL, src_info.type, 0, false);
 
         if (copy_value) {
-            copy_row(info.table->type, info.columns, info.index,
+            copy_row(world, info.table->type, info.columns, info.index,
                 src_info.type, src_info.columns, src_info.index);
 
             ecs_notify(
@@ -1879,7 +2397,7 @@ ecs_entity_t ecs_clone(
     }
 
     if (!result) {
-        result = ++ world->last_handle;
+        result = new_entity_handle(world);
     }
 
     return result;
@@ -2005,10 +2523,40 @@ void* _ecs_get_ptr(
     /* Get only accepts types that hold a single component */
     ecs_entity_t component = ecs_type_to_entity(world_arg, type);
 
+    /* The returned pointer can be used to modify the component, so data owned
+     * by the entity must not be shared with a snapshot */
     ecs_entity_info_t info = {.entity = entity};
+    if (ecs_get_ptr_intern(world, stage, &info, component, false, false)) {
+        return get_mutable_row_ptr(world, info.table, info.columns, 
+            info.index, component, false);
+    }
+
+    info = (ecs_entity_info_t){.entity = entity};
     return ecs_get_ptr_intern(world, stage, &info, component, false, true);
 }
 
+void* _ecs_get_mutable(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_type_t type)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_world_t *world_arg = world;
+    ecs_stage_t *stage = ecs_get_stage(&world);
+
+    ecs_entity_t component = ecs_type_to_entity(world_arg, type);
+
+    /* Only return data owned by the entity, as writing to a shared component
+     * would modify the base */
+    ecs_entity_info_t info = {.entity = entity};
+    if (!ecs_get_ptr_intern(world, stage, &info, component, false, false)) {
+        return NULL;
+    }
+
+    return get_mutable_row_ptr(
+        world, info.table, info.columns, info.index, component, true);
+}
+
 static
 ecs_entity_t _ecs_set_ptr_intern(
     ecs_world_t *world,
@@ -2035,6 +2583,10 @@ ecs_entity_t _ecs_set_ptr_intern(
         }
     }
 
+    /* The column may be shared with a snapshot */
+    dst = get_mutable_row_ptr(
+        world, info.table, info.columns, info.index, component, true);
+
 #ifndef NDEBUG
     ecs_entity_info_t cinfo = {.entity = component};
     EcsComponent *cdata = ecs_get_ptr_intern(
@@ -2336,26 +2888,66 @@ uint32_t _ecs_count(
     });
 }
 
-ecs_entity_t ecs_new_component(
+static
+ecs_entity_t new_component(
     ecs_world_t *world,
     const char *id,
-    size_t size)
+    size_t size,
+    size_t alignment)
 {
     ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
     assert(world->magic == ECS_WORLD_MAGIC);
 
     ecs_entity_t result = ecs_lookup(world, id);
     if (result) {
+#ifndef NDEBUG
+        /* Alignment can only be set before the component is used in tables */
+        EcsComponent *component = ecs_get_ptr(world, result, EcsComponent);
+        ecs_assert(component != NULL, ECS_INTERNAL_ERROR, NULL);
+        ecs_assert(!alignment || component->alignment == alignment, 
+            ECS_INVALID_PARAMETER, id);
+#endif
         return result;
     }
 
+    /* Set the alignment together with the size, so that tables created for the
+     * component from here on use the alignment for their columns */
     result = _ecs_new(world, world->t_component);
-    ecs_set(world, result, EcsComponent, {.size = size});
+    ecs_set(world, result, EcsComponent, {
+        .size = size, 
+        .alignment = alignment
+    });
     ecs_set(world, result, EcsId, {id});
 
     return result;
 }
 
+ecs_entity_t ecs_new_component(
+    ecs_world_t *world,
+    const char *id,
+    size_t size)
+{
+    return new_component(world, id, size, 0);
+}
+
+ecs_entity_t ecs_new_aligned_component(
+    ecs_world_t *world,
+    const char *id,
+    size_t size,
+    size_t alignment)
+{
+    ecs_assert(!(alignment & (alignment - 1)), ECS_INVALID_PARAMETER, id);
+    ecs_assert(alignment <= ECS_MAX_COMPONENT_ALIGNMENT, 
+        ECS_INVALID_PARAMETER, id);
+
+    /* The default alignment of columns is sufficient for small alignments */
+    if (alignment <= ECS_VECTOR_HEADER_SIZE) {
+        alignment = 0;
+    }
+
+    return new_component(world, id, size, alignment);
+}
+
 /* -- Debug functionality -- */
 
 void ecs_dbg_entity(
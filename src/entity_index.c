@@ -0,0 +1,498 @@
+#include "flecs_private.h"
+
+static ecs_vector_params_t dense_param = {.element_size = sizeof(ecs_entity_t)};
+static ecs_vector_params_t free_param = {.element_size = sizeof(uint32_t)};
+
+static
+bool is_paged(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    return ei->paged && 
+        !(entity & ~(ECS_ENTITY_INDEX_MASK | ECS_GENERATION_MASK));
+}
+
+/** Get page for entity, or NULL if the page has not been allocated */
+static
+ecs_ei_page_t* get_page(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    uint32_t page_index = 
+        (uint32_t)(entity & ECS_ENTITY_INDEX_MASK) >> ECS_ENTITY_PAGE_BITS;
+    if (page_index >= ei->page_count) {
+        return NULL;
+    }
+
+    return ei->pages[page_index];
+}
+
+/** Make sure that a page is not shared with a copy of the index */
+static
+ecs_ei_page_t* detach_page(
+    ecs_ei_t *ei,
+    uint32_t page_index)
+{
+    ecs_ei_page_t *page = ei->pages[page_index];
+    if (page && page->refcount) {
+        page->refcount --;
+        page = ecs_os_memdup(page, sizeof(ecs_ei_page_t));
+        ecs_assert(page != NULL, ECS_OUT_OF_MEMORY, NULL);
+        page->refcount = 0;
+        ei->pages[page_index] = page;
+    }
+
+    return page;
+}
+
+/** Get page for entity that can be modified, or NULL if the page does not 
+ * exist */
+static
+ecs_ei_page_t* get_page_mut(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    uint32_t page_index = 
+        (uint32_t)(entity & ECS_ENTITY_INDEX_MASK) >> ECS_ENTITY_PAGE_BITS;
+    if (page_index >= ei->page_count) {
+        return NULL;
+    }
+
+    return detach_page(ei, page_index);
+}
+
+/** Make sure that a vector is not shared with a copy of the index */
+static
+void detach_vector(
+    ecs_vector_t **vector,
+    const ecs_vector_params_t *params)
+{
+    if (ecs_vector_is_shared(*vector)) {
+        ecs_vector_t *result = ecs_vector_copy(*vector, params);
+        ecs_vector_free(*vector);
+        *vector = result;
+    }
+}
+
+/** Get page for entity, allocate it if it does not exist yet */
+static
+ecs_ei_page_t* get_or_create_page(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    uint32_t page_index = 
+        (uint32_t)(entity & ECS_ENTITY_INDEX_MASK) >> ECS_ENTITY_PAGE_BITS;
+
+    if (page_index >= ei->page_count) {
+        uint32_t page_count = ei->page_count ? ei->page_count : 1;
+        while (page_count <= page_index) {
+            page_count *= 2;
+        }
+
+        ei->pages = ecs_os_realloc(
+            ei->pages, page_count * sizeof(ecs_ei_page_t*));
+        ecs_assert(ei->pages != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+        memset(&ei->pages[ei->page_count], 0,
+            (page_count - ei->page_count) * sizeof(ecs_ei_page_t*));
+
+        ei->page_count = page_count;
+    }
+
+    ecs_ei_page_t *page = detach_page(ei, page_index);
+    if (!page) {
+        page = ecs_os_calloc(sizeof(ecs_ei_page_t), 1);
+        ecs_assert(page != NULL, ECS_OUT_OF_MEMORY, NULL);
+        ei->pages[page_index] = page;
+    }
+
+    return page;
+}
+
+static
+uint32_t page_offset(
+    ecs_entity_t entity)
+{
+    return (uint32_t)entity & (ECS_ENTITY_PAGE_SIZE - 1);
+}
+
+/** Test if the slot of the entity stores this generation of the id. A slot
+ * stores one generation at a time, other generations are stored in the map. */
+static
+bool in_page(
+    ecs_ei_page_t *page,
+    ecs_entity_t entity)
+{
+    uint32_t offset = page_offset(entity);
+    return page->dense[offset] && 
+        page->generation[offset] == ECS_GENERATION(entity);
+}
+
+static
+void free_pages(
+    ecs_ei_t *ei)
+{
+    uint32_t i;
+    for (i = 0; i < ei->page_count; i ++) {
+        ecs_ei_page_t *page = ei->pages[i];
+        if (page && page->refcount) {
+            page->refcount --;
+        } else {
+            ecs_os_free(page);
+        }
+    }
+
+    ecs_os_free(ei->pages);
+    ei->pages = NULL;
+    ei->page_count = 0;
+}
+
+/* -- Private functions -- */
+
+ecs_ei_t* ecs_ei_new(
+    bool paged)
+{
+    ecs_ei_t *result = ecs_os_calloc(sizeof(ecs_ei_t), 1);
+    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    result->map = ecs_map_new(0, sizeof(ecs_row_t));
+    result->paged = paged;
+
+    return result;
+}
+
+void ecs_ei_free(
+    ecs_ei_t *ei)
+{
+    free_pages(ei);
+    ecs_vector_free(ei->dense);
+    ecs_vector_free(ei->free);
+    ecs_map_free(ei->map);
+    ecs_os_free(ei);
+}
+
+void ecs_ei_clear(
+    ecs_ei_t *ei)
+{
+    detach_vector(&ei->dense, &dense_param);
+    detach_vector(&ei->free, &free_param);
+
+    uint32_t i, count = ecs_vector_count(ei->dense);
+    ecs_entity_t *entities = ecs_vector_first(ei->dense);
+
+    /* Only reset the rows that are in use, pages stay allocated */
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = entities[i];
+        ecs_ei_page_t *page = get_page_mut(ei, e);
+        uint32_t offset = page_offset(e);
+        page->rows[offset] = (ecs_row_t){0, 0};
+        page->dense[offset] = 0;
+    }
+
+    ecs_vector_clear(ei->dense);
+    ecs_vector_clear(ei->free);
+    ecs_map_clear(ei->map);
+}
+
+ecs_row_t* ecs_ei_get(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    if (is_paged(ei, entity)) {
+        ecs_ei_page_t *page = get_page(ei, entity);
+        if (page && in_page(page, entity)) {
+            return &page->rows[page_offset(entity)];
+        }
+    }
+
+    return ecs_map_get_ptr(ei->map, entity);
+}
+
+ecs_row_t* ecs_ei_get_mut(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    if (is_paged(ei, entity)) {
+        ecs_ei_page_t *page = get_page(ei, entity);
+        if (page && in_page(page, entity)) {
+            page = get_page_mut(ei, entity);
+            return &page->rows[page_offset(entity)];
+        }
+    }
+
+    return ecs_map_get_ptr(ei->map, entity);
+}
+
+ecs_row_t* ecs_ei_set(
+    ecs_ei_t *ei,
+    ecs_entity_t entity,
+    const ecs_row_t *row)
+{
+    if (is_paged(ei, entity)) {
+        ecs_ei_page_t *page = get_page(ei, entity);
+        uint32_t offset = page_offset(entity);
+
+        if (page && in_page(page, entity)) {
+            page = get_page_mut(ei, entity);
+            page->rows[offset] = *row;
+            return &page->rows[offset];
+        }
+
+        /* If the slot is used by another generation of the id, or if the id
+         * was stored in the map while the slot was in use, use the map */
+        if ((!page || !page->dense[offset]) && 
+            !ecs_map_get_ptr(ei->map, entity)) 
+        {
+            page = get_or_create_page(ei, entity);
+
+            detach_vector(&ei->dense, &dense_param);
+            ecs_entity_t *elem = ecs_vector_add(&ei->dense, &dense_param);
+            *elem = entity;
+            page->dense[offset] = ecs_vector_count(ei->dense);
+
+            /* Take the generation of the id. If the id was deleted, this
+             * revives it, and recycle will skip it in the free list. */
+            page->generation[offset] = ECS_GENERATION(entity);
+            page->rows[offset] = *row;
+            return &page->rows[offset];
+        }
+    }
+
+    return ecs_map_set(ei->map, entity, row);
+}
+
+void ecs_ei_remove(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    if (is_paged(ei, entity)) {
+        ecs_ei_page_t *page = get_page(ei, entity);
+        if (!page || !in_page(page, entity)) {
+            ecs_map_remove(ei->map, entity);
+            return;
+        }
+
+        uint32_t offset = page_offset(entity);
+        uint32_t dense = page->dense[offset];
+
+        page = get_page_mut(ei, entity);
+        detach_vector(&ei->dense, &dense_param);
+
+        /* Move last entity in dense array to the slot of the removed entity */
+        ecs_entity_t *entities = ecs_vector_first(ei->dense);
+        uint32_t last = ecs_vector_count(ei->dense) - 1;
+        ecs_entity_t moved = entities[last];
+        if (moved != entity) {
+            entities[dense - 1] = moved;
+            get_page_mut(ei, moved)->dense[page_offset(moved)] = dense;
+        }
+
+        ecs_vector_remove_last(ei->dense);
+
+        page->rows[offset] = (ecs_row_t){0, 0};
+        page->dense[offset] = 0;
+    } else {
+        ecs_map_remove(ei->map, entity);
+    }
+}
+
+void ecs_ei_delete(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    if (!is_paged(ei, entity)) {
+        ecs_map_remove(ei->map, entity);
+        return;
+    }
+
+    ecs_ei_page_t *page = get_or_create_page(ei, entity);
+    uint32_t offset = page_offset(entity);
+    uint32_t generation = page->generation[offset];
+
+    /* Deleting an id that is already deleted or recycled has no effect on the
+     * slot, but the id may have been stored in the map */
+    if (generation != ECS_GENERATION(entity)) {
+        ecs_map_remove(ei->map, entity);
+        return;
+    }
+
+    ecs_ei_remove(ei, entity);
+
+    /* Remove may have detached the page from a copy of the index */
+    page = get_page_mut(ei, entity);
+    page->generation[offset] = 
+        ((generation + 1) & (ECS_GENERATION_MASK >> 32)) | ECS_ENTITY_DELETED;
+
+    detach_vector(&ei->free, &free_param);
+    uint32_t *elem = ecs_vector_add(&ei->free, &free_param);
+    *elem = (uint32_t)(entity & ECS_ENTITY_INDEX_MASK);
+}
+
+ecs_entity_t ecs_ei_recycle(
+    ecs_ei_t *ei)
+{
+    uint32_t index;
+
+    detach_vector(&ei->free, &free_param);
+
+    while (ecs_vector_pop(ei->free, &free_param, &index)) {
+        ecs_ei_page_t *page = get_page_mut(ei, index);
+        uint32_t offset = page_offset(index);
+        uint32_t generation = page->generation[offset];
+
+        /* If the id was revived by setting it after it was deleted, it is no
+         * longer available for recycling */
+        if (generation & ECS_ENTITY_DELETED) {
+            generation &= ~ECS_ENTITY_DELETED;
+
+            /* Skip generations that are in use as ids in the map */
+            ecs_entity_t result = ((ecs_entity_t)generation << 32) | index;
+            while (ecs_map_get_ptr(ei->map, result)) {
+                generation = (generation + 1) & (ECS_GENERATION_MASK >> 32);
+                result = ((ecs_entity_t)generation << 32) | index;
+            }
+
+            page->generation[offset] = generation;
+            return result;
+        }
+    }
+
+    return 0;
+}
+
+bool ecs_ei_is_alive(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    if (!is_paged(ei, entity)) {
+        return ecs_map_get_ptr(ei->map, entity) != NULL;
+    }
+
+    ecs_ei_page_t *page = get_page(ei, entity);
+    if (!page) {
+        return ECS_GENERATION(entity) == 0 || 
+            ecs_map_get_ptr(ei->map, entity) != NULL;
+    }
+
+    return page->generation[page_offset(entity)] == ECS_GENERATION(entity) ||
+        ecs_map_get_ptr(ei->map, entity) != NULL;
+}
+
+uint32_t ecs_ei_count(
+    ecs_ei_t *ei)
+{
+    return ecs_vector_count(ei->dense) + ecs_map_count(ei->map);
+}
+
+void ecs_ei_grow(
+    ecs_ei_t *ei,
+    uint32_t count)
+{
+    if (ei->paged) {
+        uint32_t size = ecs_vector_count(ei->dense) + count;
+        if (size > ecs_vector_size(ei->dense)) {
+            detach_vector(&ei->dense, &dense_param);
+            ecs_vector_set_size(&ei->dense, &dense_param, size);
+        }
+    } else {
+        ecs_map_grow(ei->map, ecs_map_count(ei->map) + count);
+    }
+}
+
+ecs_ei_t* ecs_ei_copy(
+    ecs_ei_t *ei)
+{
+    ecs_ei_t *result = ecs_os_memdup(ei, sizeof(ecs_ei_t));
+    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    /* Pages and vectors are shared with the copy, and are copied by the index
+     * that modifies them first */
+    if (ei->page_count) {
+        result->pages = ecs_os_memdup(
+            ei->pages, ei->page_count * sizeof(ecs_ei_page_t*));
+        ecs_assert(result->pages != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+        uint32_t i;
+        for (i = 0; i < ei->page_count; i ++) {
+            if (ei->pages[i]) {
+                ei->pages[i]->refcount ++;
+            }
+        }
+    }
+
+    result->dense = ecs_vector_share(ei->dense);
+    result->free = ecs_vector_share(ei->free);
+    result->map = ecs_map_copy(ei->map);
+
+    return result;
+}
+
+void ecs_ei_memory(
+    ecs_ei_t *ei,
+    uint64_t *allocd,
+    uint64_t *used)
+{
+    if (!ei) {
+        return;
+    }
+
+    uint32_t i, page_count = 0;
+    for (i = 0; i < ei->page_count; i ++) {
+        if (ei->pages[i]) {
+            page_count ++;
+        }
+    }
+
+    if (allocd) {
+        *allocd += sizeof(ecs_ei_t) + ei->page_count * sizeof(ecs_ei_page_t*) +
+            page_count * sizeof(ecs_ei_page_t);
+    }
+
+    if (used) {
+        *used += (uint64_t)ecs_vector_count(ei->dense) *
+            (sizeof(ecs_row_t) + sizeof(uint32_t) * 2);
+    }
+
+    ecs_vector_memory(ei->dense, &dense_param, allocd, used);
+    ecs_vector_memory(ei->free, &free_param, allocd, used);
+    ecs_map_memory(ei->map, allocd, used);
+}
+
+ecs_ei_iter_t ecs_ei_iter(
+    ecs_ei_t *ei)
+{
+    return (ecs_ei_iter_t){
+        .ei = ei,
+        .index = 0,
+        .map_iter = ecs_map_iter(ei->map)
+    };
+}
+
+bool ecs_ei_hasnext(
+    ecs_ei_iter_t *it)
+{
+    if (it->index < ecs_vector_count(it->ei->dense)) {
+        return true;
+    }
+
+    return ecs_map_hasnext(&it->map_iter);
+}
+
+ecs_row_t* ecs_ei_next(
+    ecs_ei_iter_t *it,
+    ecs_entity_t *entity_out)
+{
+    ecs_ei_t *ei = it->ei;
+
+    if (it->index < ecs_vector_count(ei->dense)) {
+        ecs_entity_t *entities = ecs_vector_first(ei->dense);
+        ecs_entity_t e = entities[it->index ++];
+        if (entity_out) {
+            *entity_out = e;
+        }
+
+        return &get_page(ei, e)->rows[page_offset(e)];
+    }
+
+    return ecs_map_next_w_key(&it->map_iter, entity_out);
+}
@@ -59,3 +59,61 @@ bool ecs_filter_next(
 
     return false;
 }
+
+ecs_children_iter_t ecs_children_iter(
+    ecs_world_t *world,
+    ecs_entity_t parent)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(parent != 0, ECS_INVALID_PARAMETER, NULL);
+
+    return (ecs_children_iter_t){
+        .parent = parent,
+        .index = 0,
+        .rows = {
+            .world = world
+        }
+    };
+}
+
+bool ecs_children_next(
+    ecs_children_iter_t *iter)
+{
+    /* The iterator may be used from a worker thread, the index is stored in
+     * the actual world */
+    ecs_world_t *world = iter->rows.world;
+    ecs_get_stage(&world);
+
+    /* Look up the tables each time, as the vector may be reallocated when the
+     * application creates tables while iterating */
+    ecs_vector_t *tables = NULL;
+    if (!ecs_map_has(
+        world->component_tables, iter->parent | ECS_CHILDOF, &tables))
+    {
+        return false;
+    }
+
+    ecs_table_t **buffer = ecs_vector_first(tables);
+    uint32_t i, count = ecs_vector_count(tables);
+
+    for (i = iter->index; i < count; i ++) {
+        ecs_table_t *table = buffer[i];
+        uint32_t entity_count = ecs_table_count(table);
+
+        if (!entity_count) {
+            continue;
+        }
+
+        ecs_rows_t *rows = &iter->rows;
+        rows->table = table;
+        rows->table_columns = table->columns;
+        rows->count = entity_count;
+        rows->entities = ecs_vector_first(table->columns[0].data);
+        iter->index = ++i;
+        return true;
+    }
+
+    iter->index = count;
+
+    return false;
+}
@@ -14,6 +14,11 @@ void ecs_merge_entity(
     ecs_entity_t entity,
     ecs_row_t staged_row);
 
+/* Merge all staged entities with main stage */
+void ecs_merge_entities(
+    ecs_world_t *world,
+    ecs_stage_t *stage);
+
 /* Get prefab from type, even if type was introduced while in progress */
 ecs_entity_t ecs_get_prefab_from_type(
     ecs_world_t *world,
@@ -57,6 +62,12 @@ void* ecs_get_ptr_intern(
     bool staged_only,
     bool search_prefab);
 
+/* Get pointer to a component that is cached by a system */
+void* ecs_get_ref_ptr(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_entity_t component);
+
 ecs_entity_t ecs_get_entity_for_component(
     ecs_world_t *world,
     ecs_entity_t entity,
@@ -67,6 +78,11 @@ void ecs_clear_w_filter(
     ecs_world_t *world,
     const ecs_filter_t *filter);
 
+/* Remove deleted entity from the entity index, and recycle its id if possible */
+void ecs_release_entity(
+    ecs_world_t *world,
+    ecs_entity_t entity);
+
 /* -- World API -- */
 
 /* Get (or create) table from type */
@@ -87,6 +103,10 @@ void ecs_world_activate_system(
     EcsSystemKind kind,
     bool active);
 
+/* Rematch systems and queries with tables if watched entities changed */
+void ecs_world_rematch(
+    ecs_world_t *world);
+
 /* Get current thread-specific stage */
 ecs_stage_t *ecs_get_stage(
     ecs_world_t **world_ptr);
@@ -96,6 +116,27 @@ ecs_vector_t** ecs_system_array(
     ecs_world_t *world,
     EcsSystemKind kind);
 
+/* -- Query API -- */
+
+/* Match queries with new table */
+void ecs_queries_notify_of_table(
+    ecs_world_t *world,
+    ecs_table_t *table);
+
+/* Rematch queries with tables, or with all tables if tables is NULL */
+void ecs_queries_rematch(
+    ecs_world_t *world,
+    ecs_vector_t *tables);
+
+/* Move table to the range of tables that is iterated by the query */
+void ecs_query_activate_table(
+    ecs_query_t *query,
+    ecs_table_t *table);
+
+/* Free all queries of world */
+void ecs_queries_fini(
+    ecs_world_t *world);
+
 /* -- Stage API -- */
 
 /* Initialize stage data structures */
@@ -113,6 +154,131 @@ void ecs_stage_merge(
     ecs_world_t *world,
     ecs_stage_t *stage);
 
+/* -- Image API -- */
+
+/* Release memory of images loaded into the world */
+void ecs_image_fini(
+    ecs_world_t *world);
+
+/* -- Name index API -- */
+
+/* Register entity with name, for each parent in type */
+void ecs_name_index_add(
+    ecs_map_t *index,
+    ecs_entity_t entity,
+    ecs_type_t type,
+    const char *name);
+
+/* Unregister entity with name, for each parent in type */
+void ecs_name_index_remove(
+    ecs_map_t *index,
+    ecs_entity_t entity,
+    ecs_type_t type,
+    const char *name);
+
+/* Register all named entities in table */
+void ecs_name_index_add_table(
+    ecs_map_t *index,
+    ecs_table_t *table);
+
+/* Free all entries of name index */
+void ecs_name_index_clear(
+    ecs_map_t *index);
+
+/* Rebuild main stage name index from tables */
+void ecs_name_index_rebuild(
+    ecs_world_t *world);
+
+/* Merge name index of stage with main stage */
+void ecs_name_index_merge(
+    ecs_world_t *world,
+    ecs_stage_t *stage);
+
+/* Find entity by name, with optional parent */
+ecs_entity_t ecs_name_index_lookup(
+    ecs_world_t *world,
+    ecs_entity_t parent,
+    const char *name);
+
+/* -- Entity index API -- */
+
+/* Create entity index. A paged index stores rows directly indexed by id */
+ecs_ei_t* ecs_ei_new(
+    bool paged);
+
+/* Free entity index */
+void ecs_ei_free(
+    ecs_ei_t *ei);
+
+/* Remove all entities from entity index */
+void ecs_ei_clear(
+    ecs_ei_t *ei);
+
+/* Get row for entity, or NULL if entity is not in index */
+ecs_row_t* ecs_ei_get(
+    ecs_ei_t *ei,
+    ecs_entity_t entity);
+
+/* Get row for entity that can be modified, or NULL if entity is not in index */
+ecs_row_t* ecs_ei_get_mut(
+    ecs_ei_t *ei,
+    ecs_entity_t entity);
+
+/* Set row for entity */
+ecs_row_t* ecs_ei_set(
+    ecs_ei_t *ei,
+    ecs_entity_t entity,
+    const ecs_row_t *row);
+
+/* Remove entity from index */
+void ecs_ei_remove(
+    ecs_ei_t *ei,
+    ecs_entity_t entity);
+
+/* Remove entity from index and make its id available for recycling */
+void ecs_ei_delete(
+    ecs_ei_t *ei,
+    ecs_entity_t entity);
+
+/* Obtain id of deleted entity with increased generation, or 0 if none */
+ecs_entity_t ecs_ei_recycle(
+    ecs_ei_t *ei);
+
+/* Test if the generation of an id matches its current generation */
+bool ecs_ei_is_alive(
+    ecs_ei_t *ei,
+    ecs_entity_t entity);
+
+/* Return number of entities in index */
+uint32_t ecs_ei_count(
+    ecs_ei_t *ei);
+
+/* Preallocate space for count additional entities */
+void ecs_ei_grow(
+    ecs_ei_t *ei,
+    uint32_t count);
+
+/* Create a copy of an entity index */
+ecs_ei_t* ecs_ei_copy(
+    ecs_ei_t *ei);
+
+/* Obtain memory usage of entity index */
+void ecs_ei_memory(
+    ecs_ei_t *ei,
+    uint64_t *allocd,
+    uint64_t *used);
+
+/* Iterate entities in index */
+ecs_ei_iter_t ecs_ei_iter(
+    ecs_ei_t *ei);
+
+bool ecs_ei_hasnext(
+    ecs_ei_iter_t *it);
+
+ecs_row_t* ecs_ei_next(
+    ecs_ei_iter_t *it,
+    ecs_entity_t *entity_out);
+
 /* -- Type utility API -- */
 
 ecs_type_t ecs_type_find_intern(
@@ -156,12 +322,6 @@ int16_t ecs_type_index_of(
     ecs_type_t type,
     ecs_entity_t component);
 
-/* Get number of containers (parents) for a type */
-int32_t ecs_type_container_depth(
-   ecs_world_t *world,
-   ecs_type_t type,
-   ecs_entity_t component);
-
 /** Utility to iterate over prefabs in type */
 int32_t ecs_type_get_prefab(
     ecs_type_t type,
@@ -183,11 +343,35 @@ void ecs_table_init(
     ecs_stage_t *stage,
     ecs_table_t *table);
 
+/* Get hierarchy depth of table, computed from the tables of its parents */
+int32_t ecs_table_depth(
+    ecs_world_t *world,
+    ecs_table_t *table);
+
+/* Invalidate cached depth of tables with children of parent */
+void ecs_table_invalidate_depth(
+    ecs_world_t *world,
+    ecs_entity_t parent);
+
 /* Evaluate table for special columns */
 void ecs_table_eval_columns(
     ecs_world_t *world,
     ecs_table_t *table);
 
+/* Find table that results from adding a single component to table */
+ecs_table_t* ecs_table_traverse_add(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_table_t *table,
+    ecs_type_t to_add);
+
+/* Find table that results from removing a single component from table */
+ecs_table_t* ecs_table_traverse_remove(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_table_t *table,
+    ecs_type_t to_remove);
+
 /* Allocate a set of columns for a type */
 ecs_table_column_t *ecs_table_get_columns(
     ecs_world_t *world,
@@ -199,6 +383,24 @@ void ecs_table_register_system(
     ecs_table_t *table,
     ecs_entity_t system);    
 
+/* Make sure column data is not shared with a snapshot before modifying it */
+void ecs_table_detach_column(
+    ecs_world_t *world,
+    ecs_table_column_t *column);
+
+/* Increase the version of a table after its data has been written. Safe to call
+ * from worker threads. */
+void ecs_table_bump_version(
+    ecs_world_t *world,
+    ecs_table_t *table);
+
+/* Detach all columns of table (or stage) and mark the table as changed. Must be
+ * called before the rows of a table are modified. */
+void ecs_table_detach(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_table_column_t *columns);
+
 /* Insert row into table (or stage) */
 uint32_t ecs_table_insert(
     ecs_world_t *world,
@@ -216,6 +418,7 @@ uint32_t ecs_table_grow(
 
 /* Dimension array to have n rows (doesn't add entities) */
 int16_t ecs_table_dim(
+    ecs_world_t *world,
     ecs_table_t *table,
     ecs_table_column_t *columns,
     uint32_t count);
@@ -224,6 +427,11 @@ int16_t ecs_table_dim(
 uint64_t ecs_table_count(
     ecs_table_t *table);
 
+/* Recompute memory of table columns, and update memory totals of world */
+void ecs_table_update_memory(
+    ecs_world_t *world,
+    ecs_table_t *table);
+
 /* Return size of table row */
 uint32_t ecs_table_row_size(
     ecs_table_t *table);
@@ -276,6 +484,17 @@ void ecs_table_replace_columns(
     ecs_table_t *table,
     ecs_table_column_t *columns);
     
+/* Remove entities in table from the entity index */
+void ecs_table_unregister_entities(
+    ecs_world_t *world,
+    ecs_table_t *table);
+
+/* Register entities in table in the entity index, after its columns have been
+ * replaced with deserialized data */
+void ecs_table_register_entities(
+    ecs_world_t *world,
+    ecs_table_t *table);
+
 /* Merge data of one table into another table */
 void ecs_table_merge(
     ecs_world_t *world,
@@ -283,6 +502,7 @@ void ecs_table_merge(
     ecs_table_t *old_table);
 
 void ecs_table_swap(
+    ecs_world_t *world,
     ecs_stage_t *stage,
     ecs_table_t *table,
     ecs_table_column_t *columns,
@@ -292,6 +512,7 @@ void ecs_table_swap(
     ecs_row_t *row_ptr_2);
 
 void ecs_table_move_back_and_swap(
+    ecs_world_t *world,
     ecs_stage_t *stage,
     ecs_table_t *table,
     ecs_table_column_t *columns,
@@ -300,6 +521,17 @@ void ecs_table_move_back_and_swap(
 
 /* -- System API -- */
 
+/* Detach table columns that a system does not only read from, and mark the
+ * table as changed if the system writes to it. Written columns are stamped
+ * with the provided change tick. */
+void ecs_system_detach_columns(
+    ecs_world_t *world,
+    EcsSystem *system_data,
+    ecs_table_t *table,
+    ecs_table_column_t *table_columns,
+    int32_t *columns,
+    uint64_t tick);
+
 void ecs_system_init_base(
     ecs_world_t *world,
     EcsSystem *base_data);
@@ -362,6 +594,16 @@ void ecs_system_activate_table(
     ecs_table_t *table,
     bool active);
 
+/* Advance time of a periodic column system, return true if it should run */
+bool ecs_col_system_should_run(
+    EcsColSystem *system_data,
+    float delta_time);
+
+/* Start a new invocation of a column system by advancing its change ticks */
+void ecs_col_system_begin_run(
+    ecs_world_t *world,
+    EcsColSystem *system_data);
+
 /* Internal function to run a system */
 ecs_entity_t ecs_run_intern(
     ecs_world_t *world,
@@ -406,6 +648,18 @@ void ecs_rematch_system(
     ecs_world_t *world,
     ecs_entity_t system);
 
+/* Trigger rematch of system for a subset of the tables */
+void ecs_rematch_system_w_tables(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    ecs_vector_t *tables);
+
+/* Test if system has a column that uses the entity as a fixed source */
+bool ecs_system_refers_to(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    ecs_entity_t entity);
+
 /* Re-resolve references of system after table realloc */
 void ecs_revalidate_system_refs(
     ecs_world_t *world,
@@ -419,6 +673,39 @@ void ecs_measure_system_time(
     ecs_world_t *world,
     bool enable);
 
+/* -- Trace API -- */
+
+/* Allocate (if needed) and reset a trace buffer */
+void ecs_trace_buffer_init(
+    ecs_world_t *world,
+    ecs_trace_buffer_t *buffer);
+
+/* Free the events of a trace buffer */
+void ecs_trace_buffer_free(
+    ecs_trace_buffer_t *buffer);
+
+/* Get the trace buffer of the calling thread, NULL if tracing is disabled */
+ecs_trace_buffer_t* ecs_trace_get_buffer(
+    ecs_world_t *world);
+
+/* Record a span that started at start and ends now */
+void ecs_trace_push(
+    ecs_trace_buffer_t *buffer,
+    ecs_trace_kind_t kind,
+    const char *name,
+    ecs_time_t start,
+    int32_t arg_1,
+    int32_t arg_2);
+
+/* Record a span of a system. The name of the system is looked up when the 
+ * trace is written, as the system can be renamed or deleted before that. */
+void ecs_trace_push_system(
+    ecs_trace_buffer_t *buffer,
+    ecs_entity_t system,
+    ecs_time_t start,
+    int32_t arg_1,
+    int32_t arg_2);
+
 /* -- Worker API -- */
 
 /* Compute schedule based on current number of entities matching system */
@@ -426,6 +713,12 @@ void ecs_schedule_jobs(
     ecs_world_t *world,
     ecs_entity_t system);
 
+/* Test if system accesses data written by (or writes data accessed by) systems
+ * in the current batch of jobs */
+bool ecs_jobs_conflict(
+    ecs_world_t *world,
+    ecs_entity_t system);
+
 /* Prepare jobs */
 void ecs_prepare_jobs(
     ecs_world_t *world,
@@ -0,0 +1,713 @@
+#include "flecs_private.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define ECS_IMAGE_MAGIC (0x4d494345) /* "ECIM" */
+#define ECS_IMAGE_VERSION (1)
+
+/* Column blocks start on a page boundary, so that a mapped column only shares
+ * pages with the data before it if it is modified. */
+#define ECS_IMAGE_PAGE_SIZE (4096)
+
+/* The table directory is aligned so that the 64 bit values in its entries can
+ * be read directly from the mapped image. All entries have a size that is a
+ * multiple of this alignment. */
+#define ECS_IMAGE_ALIGNMENT (8)
+
+/* An image is laid out as follows:
+ *  - header
+ *  - component segment, as produced by ecs_reader_read
+ *  - table directory, with one ecs_image_table_t per table, aligned to
+ *    ECS_IMAGE_ALIGNMENT
+ *  - column blocks, each aligned to ECS_IMAGE_PAGE_SIZE
+ *
+ * A column block starts with ECS_VECTOR_HEADER_SIZE bytes that are reserved
+ * for the vector header, followed by the column data. Blocks of name (EcsId)
+ * columns contain an offset to the name for each row, followed by the names.
+ *
+ * Images store data in the native layout, and can only be loaded on platforms
+ * with the same endianness and type sizes as where they were saved. */
+typedef struct ecs_image_header_t {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entity_size;           /* Sanity check for ecs_entity_t size */
+    uint32_t table_count;
+    uint64_t component_offset;      /* Offset of component segment */
+    uint64_t component_size;        /* Size of component segment */
+    uint64_t table_offset;          /* Offset of table directory */
+    uint64_t size;                  /* Total size, to detect truncated files */
+} ecs_image_header_t;
+
+/* Table in the directory. Followed by the type of the table, and one
+ * ecs_image_column_t for each column (type count + 1) */
+typedef struct ecs_image_table_t {
+    int32_t type_count;
+    int32_t row_count;
+} ecs_image_table_t;
+
+typedef struct ecs_image_column_t {
+    int32_t size;                   /* Element size, 0 if column has no data */
+    int32_t is_name;                /* Column stores names */
+    uint64_t offset;                /* Offset of column block */
+} ecs_image_column_t;
+
+static const ecs_vector_params_t image_arr_params = {
+    .element_size = sizeof(ecs_image_t)
+};
+
+static
+uint64_t image_align(
+    uint64_t offset,
+    uint64_t alignment)
+{
+    return ((offset + alignment - 1) / alignment) * alignment;
+}
+
+/* Same tables as the ones serialized by the table reader */
+static
+bool image_table_is_serialized(
+    ecs_table_t *table)
+{
+    return table->columns &&
+        ecs_vector_count(table->columns[0].data) &&
+        !(table->flags & EcsTableHasBuiltins);
+}
+
+static
+bool image_column_is_name(
+    ecs_table_t *table,
+    int32_t column)
+{
+    if (!column) {
+        return false;
+    }
+
+    ecs_entity_t *type_array = ecs_vector_first(table->type);
+    return type_array[column - 1] == EEcsId;
+}
+
+static
+uint64_t image_column_block_size(
+    ecs_table_t *table,
+    int32_t column)
+{
+    ecs_table_column_t *col = &table->columns[column];
+    int32_t i, count = ecs_vector_count(table->columns[0].data);
+
+    if (image_column_is_name(table, column)) {
+        EcsId *names = ecs_vector_first(col->data);
+        uint64_t result = count * sizeof(int32_t);
+        for (i = 0; i < count; i ++) {
+            if (names[i]) {
+                result += strlen(names[i]) + 1;
+            }
+        }
+        return result;
+    } else if (col->size) {
+        return ECS_VECTOR_HEADER_SIZE + (uint64_t)col->size * count;
+    } else {
+        return 0;
+    }
+}
+
+static
+int image_write_padding(
+    FILE *f,
+    uint64_t *offset,
+    uint64_t to)
+{
+    static const char zeros[ECS_IMAGE_PAGE_SIZE] = {0};
+
+    ecs_assert(to >= *offset, ECS_INTERNAL_ERROR, NULL);
+
+    size_t pad = to - *offset;
+    if (pad && fwrite(zeros, 1, pad, f) != pad) {
+        return -1;
+    }
+
+    *offset = to;
+
+    return 0;
+}
+
+static
+int image_write(
+    FILE *f,
+    uint64_t *offset,
+    const void *data,
+    size_t size)
+{
+    if (size && fwrite(data, 1, size, f) != size) {
+        return -1;
+    }
+
+    *offset += size;
+
+    return 0;
+}
+
+static
+int image_write_components(
+    ecs_world_t *world,
+    FILE *f,
+    uint64_t *offset)
+{
+    ecs_reader_t reader = ecs_reader_init(world);
+    int32_t buffer;
+
+    /* Read one element at a time, so that the reader stops at the end of the
+     * component segment. */
+    while (reader.state == EcsComponentSegment) {
+        size_t read = ecs_reader_read((char*)&buffer, sizeof(int32_t), &reader);
+        if (!read) {
+            break;
+        }
+
+        if (image_write(f, offset, &buffer, read)) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static
+int image_write_table_record(
+    FILE *f,
+    uint64_t *offset,
+    ecs_table_t *table,
+    uint64_t *block_offset)
+{
+    int32_t type_count = ecs_vector_count(table->type);
+    ecs_image_table_t record = {
+        .type_count = type_count,
+        .row_count = ecs_vector_count(table->columns[0].data)
+    };
+
+    ecs_assert(!(*offset % ECS_IMAGE_ALIGNMENT), ECS_INTERNAL_ERROR, NULL);
+
+    if (image_write(f, offset, &record, sizeof(record))) {
+        return -1;
+    }
+
+    if (image_write(f, offset, ecs_vector_first(table->type),
+        type_count * sizeof(ecs_entity_t)))
+    {
+        return -1;
+    }
+
+    int32_t i;
+    for (i = 0; i < type_count + 1; i ++) {
+        uint64_t block_size = image_column_block_size(table, i);
+        ecs_image_column_t column = {
+            .size = table->columns[i].size,
+            .is_name = image_column_is_name(table, i)
+        };
+
+        if (block_size) {
+            column.offset = *block_offset;
+            *block_offset = image_align(
+                *block_offset + block_size, ECS_IMAGE_PAGE_SIZE);
+        }
+
+        if (image_write(f, offset, &column, sizeof(column))) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static
+int image_write_table_data(
+    FILE *f,
+    uint64_t *offset,
+    ecs_table_t *table)
+{
+    int32_t type_count = ecs_vector_count(table->type);
+    int32_t count = ecs_vector_count(table->columns[0].data);
+    int32_t i, row;
+
+    for (i = 0; i < type_count + 1; i ++) {
+        ecs_table_column_t *column = &table->columns[i];
+
+        if (!image_column_block_size(table, i)) {
+            continue;
+        }
+
+        if (image_write_padding(
+            f, offset, image_align(*offset, ECS_IMAGE_PAGE_SIZE)))
+        {
+            return -1;
+        }
+
+        if (image_column_is_name(table, i)) {
+            EcsId *names = ecs_vector_first(column->data);
+            int32_t name_offset = count * sizeof(int32_t);
+
+            for (row = 0; row < count; row ++) {
+                int32_t name = -1;
+                if (names[row]) {
+                    name = name_offset;
+                    name_offset += strlen(names[row]) + 1;
+                }
+
+                if (image_write(f, offset, &name, sizeof(int32_t))) {
+                    return -1;
+                }
+            }
+
+            for (row = 0; row < count; row ++) {
+                if (names[row] && image_write(
+                    f, offset, names[row], strlen(names[row]) + 1))
+                {
+                    return -1;
+                }
+            }
+        } else {
+            /* Header is initialized when the image is loaded */
+            if (image_write_padding(
+                f, offset, *offset + ECS_VECTOR_HEADER_SIZE))
+            {
+                return -1;
+            }
+
+            if (image_write(f, offset, ecs_vector_first(column->data),
+                (size_t)column->size * count))
+            {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static
+int image_save(
+    ecs_world_t *world,
+    FILE *f)
+{
+    ecs_chunked_t *tables = world->main_stage.tables;
+    uint32_t i, count = ecs_chunked_count(tables);
+    uint64_t offset = 0;
+
+    ecs_image_header_t header = {
+        .magic = ECS_IMAGE_MAGIC,
+        .version = ECS_IMAGE_VERSION,
+        .entity_size = sizeof(ecs_entity_t),
+        .component_offset = sizeof(ecs_image_header_t)
+    };
+
+    /* Reserve space for the header, which is written when the offsets are
+     * known */
+    if (image_write_padding(f, &offset, sizeof(ecs_image_header_t))) {
+        return -1;
+    }
+
+    if (image_write_components(world, f, &offset)) {
+        return -1;
+    }
+
+    header.component_size = offset - header.component_offset;
+
+    /* The component segment is written in 4 byte chunks */
+    if (image_write_padding(
+        f, &offset, image_align(offset, ECS_IMAGE_ALIGNMENT)))
+    {
+        return -1;
+    }
+
+    header.table_offset = offset;
+
+    /* Compute size of table directory, so that block offsets are known */
+    uint64_t directory_size = 0;
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, i);
+        if (image_table_is_serialized(table)) {
+            int32_t type_count = ecs_vector_count(table->type);
+            directory_size += sizeof(ecs_image_table_t) +
+                type_count * sizeof(ecs_entity_t) +
+                (type_count + 1) * sizeof(ecs_image_column_t);
+            header.table_count ++;
+        }
+    }
+
+    uint64_t block_offset = image_align(
+        offset + directory_size, ECS_IMAGE_PAGE_SIZE);
+
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, i);
+        if (image_table_is_serialized(table)) {
+            if (image_write_table_record(f, &offset, table, &block_offset)) {
+                return -1;
+            }
+        }
+    }
+
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, i);
+        if (image_table_is_serialized(table)) {
+            if (image_write_table_data(f, &offset, table)) {
+                return -1;
+            }
+        }
+    }
+
+    header.size = offset;
+
+    if (fseek(f, 0, SEEK_SET)) {
+        return -1;
+    }
+
+    return image_write(f, &offset, &header, sizeof(header));
+}
+
+static
+int image_map(
+    const char *filename,
+    ecs_image_t *image)
+{
+#ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) || !st.st_size) {
+        close(fd);
+        return -1;
+    }
+
+    /* Private mapping, so that pages are copied when they are written */
+    void *data = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+        fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        return -1;
+    }
+
+    image->data = data;
+    image->size = st.st_size;
+#else
+    /* No mmap, read the image in memory */
+    FILE *f = fopen(filename, "rb");
+    if (!f) {
+        return -1;
+    }
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    if (size <= 0) {
+        fclose(f);
+        return -1;
+    }
+
+    image->data = ecs_os_malloc(size);
+    image->size = size;
+
+    if (fread(image->data, 1, size, f) != (size_t)size) {
+        ecs_os_free(image->data);
+        fclose(f);
+        return -1;
+    }
+
+    fclose(f);
+#endif
+    return 0;
+}
+
+static
+void image_unmap(
+    ecs_image_t *image)
+{
+#ifndef _WIN32
+    munmap(image->data, image->size);
+#else
+    ecs_os_free(image->data);
+#endif
+}
+
+static
+bool image_range_valid(
+    ecs_image_t *image,
+    uint64_t offset,
+    uint64_t size)
+{
+    return offset <= image->size && size <= image->size - offset;
+}
+
+static
+ecs_vector_t* image_load_names(
+    ecs_image_t *image,
+    ecs_image_column_t *column,
+    int32_t count)
+{
+    ecs_vector_params_t params = {.element_size = sizeof(EcsId)};
+    ecs_vector_t *result = NULL;
+    int32_t i;
+
+    if (!image_range_valid(image, column->offset, count * sizeof(int32_t))) {
+        return NULL;
+    }
+
+    int32_t *offsets = ECS_OFFSET(image->data, column->offset);
+    const char *base = (const char*)offsets;
+
+    ecs_vector_set_count(&result, &params, count);
+    EcsId *names = ecs_vector_first(result);
+
+    /* Names point into the image, which remains mapped until ecs_fini */
+    for (i = 0; i < count; i ++) {
+        if (offsets[i] == -1) {
+            names[i] = NULL;
+            continue;
+        }
+
+        /* A name must be terminated within the mapped bytes */
+        uint64_t offset = column->offset + (uint64_t)offsets[i];
+        if (offsets[i] < 0 || !image_range_valid(image, offset, 1) ||
+            !memchr(ECS_OFFSET(image->data, offset), '\0', image->size - offset))
+        {
+            ecs_vector_free(result);
+            return NULL;
+        }
+
+        names[i] = ECS_OFFSET(base, offsets[i]);
+    }
+
+    return result;
+}
+
+static
+int image_load_table(
+    ecs_world_t *world,
+    ecs_image_t *image,
+    ecs_image_table_t *record,
+    ecs_entity_t *type_array,
+    ecs_image_column_t *image_columns)
+{
+    int32_t i, type_count = record->type_count, count = record->row_count;
+
+    ecs_type_t type = ecs_type_find(world, type_array, type_count);
+    if (!type) {
+        return -1;
+    }
+
+    ecs_table_t *table = ecs_world_get_table(world, &world->main_stage, type);
+    ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_table_column_t *columns = ecs_os_calloc(
+        sizeof(ecs_table_column_t), type_count + 1);
+    ecs_assert(columns != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    for (i = 0; i < type_count + 1; i ++) {
+        ecs_image_column_t *column = &image_columns[i];
+        columns[i].size = table->columns[i].size;
+        columns[i].alignment = table->columns[i].alignment;
+
+        if (column->size != columns[i].size ||
+            column->is_name != image_column_is_name(table, i))
+        {
+            goto error;
+        }
+
+        if (!columns[i].size) {
+            continue;
+        }
+
+        /* Column blocks are read in place */
+        if (column->offset % ECS_IMAGE_PAGE_SIZE) {
+            goto error;
+        }
+
+        if (column->is_name) {
+            columns[i].data = image_load_names(image, column, count);
+            if (!columns[i].data) {
+                goto error;
+            }
+        } else {
+            if (!image_range_valid(image, column->offset,
+                ECS_VECTOR_HEADER_SIZE + (uint64_t)column->size * count))
+            {
+                goto error;
+            }
+
+            columns[i].data = ecs_vector_borrow(
+                ECS_OFFSET(image->data, column->offset), count);
+
+            /* Column data in the image follows the vector header, which is
+             * not sufficiently aligned for components with a larger 
+             * alignment. Copy those columns to aligned storage. */
+            if (columns[i].alignment) {
+                ecs_vector_params_t params = {
+                    .element_size = columns[i].size,
+                    .alignment = columns[i].alignment};
+                columns[i].data = ecs_vector_copy(columns[i].data, &params);
+            }
+        }
+    }
+
+    /* Remove any existing entities from entity index */
+    ecs_table_unregister_entities(world, table);
+
+    ecs_table_replace_columns(world, table, columns);
+
+    ecs_table_register_entities(world, table);
+
+    ecs_name_index_add_table(world->main_stage.name_index, table);
+
+    return 0;
+error:
+    for (i = 0; i < type_count + 1; i ++) {
+        ecs_vector_free(columns[i].data);
+    }
+    ecs_os_free(columns);
+    return -1;
+}
+
+static
+bool image_header_valid(
+    ecs_image_t *image)
+{
+    ecs_image_header_t *header = image->data;
+
+    return image->size >= sizeof(ecs_image_header_t) &&
+        header->magic == ECS_IMAGE_MAGIC &&
+        header->version == ECS_IMAGE_VERSION &&
+        header->entity_size == sizeof(ecs_entity_t) &&
+        header->size == image->size &&
+        !(header->table_offset % ECS_IMAGE_ALIGNMENT) &&
+        image_range_valid(
+            image, header->component_offset, header->component_size);
+}
+
+static
+int image_load(
+    ecs_world_t *world,
+    ecs_image_t *image)
+{
+    ecs_image_header_t *header = image->data;
+
+    /* Components are deserialized with a regular writer, which checks whether
+     * they are compatible with the ones in the world */
+    if (header->component_size) {
+        ecs_writer_t writer = ecs_writer_init(world);
+        if (ecs_writer_write(ECS_OFFSET(image->data, header->component_offset),
+            header->component_size, &writer))
+        {
+            return -1;
+        }
+    }
+
+    uint64_t offset = header->table_offset;
+    uint32_t t;
+
+    for (t = 0; t < header->table_count; t ++) {
+        if (!image_range_valid(image, offset, sizeof(ecs_image_table_t))) {
+            return -1;
+        }
+
+        ecs_image_table_t *record = ECS_OFFSET(image->data, offset);
+        if (record->type_count <= 0 || record->row_count <= 0) {
+            return -1;
+        }
+
+        uint64_t type_size = record->type_count * sizeof(ecs_entity_t);
+        uint64_t columns_size =
+            (record->type_count + 1) * sizeof(ecs_image_column_t);
+
+        offset += sizeof(ecs_image_table_t);
+        if (!image_range_valid(image, offset, type_size + columns_size)) {
+            return -1;
+        }
+
+        ecs_entity_t *type_array = ECS_OFFSET(image->data, offset);
+        ecs_image_column_t *columns = ECS_OFFSET(type_array, type_size);
+        offset += type_size + columns_size;
+
+        if (image_load_table(world, image, record, type_array, columns)) {
+            return -1;
+        }
+    }
+
+    /* Systems may have cached pointers to the replaced columns */
+    world->should_resolve = true;
+
+    return 0;
+}
+
+/* -- Private functions -- */
+
+void ecs_image_fini(
+    ecs_world_t *world)
+{
+    ecs_image_t *images = ecs_vector_first(world->images);
+    int32_t i, count = ecs_vector_count(world->images);
+
+    for (i = 0; i < count; i ++) {
+        image_unmap(&images[i]);
+    }
+
+    ecs_vector_free(world->images);
+    world->images = NULL;
+}
+
+/* -- Public functions -- */
+
+int ecs_world_save_image(
+    ecs_world_t *world,
+    const char *filename)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(filename != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!world->in_progress, ECS_INVALID_WHILE_ITERATING, NULL);
+
+    FILE *f = fopen(filename, "wb");
+    if (!f) {
+        return -1;
+    }
+
+    int result = image_save(world, f);
+
+    if (fclose(f)) {
+        result = -1;
+    }
+
+    return result;
+}
+
+int ecs_world_load_image(
+    ecs_world_t *world,
+    const char *filename)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(filename != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!world->in_progress, ECS_INVALID_WHILE_ITERATING, NULL);
+
+    ecs_image_t image;
+    if (image_map(filename, &image)) {
+        return -1;
+    }
+
+    if (!image_header_valid(&image)) {
+        image_unmap(&image);
+        return -1;
+    }
+
+    /* Tables may borrow columns from the image even if loading fails halfway,
+     * so the image is always kept until the world is deleted */
+    ecs_image_t *elem = ecs_vector_add(&world->images, &image_arr_params);
+    *elem = image;
+
+    return image_load(world, &image);
+}
@@ -1,260 +1,295 @@
 
 #include "flecs_private.h"
 
-#define FLECS_LOAD_FACTOR (3.0f / 4.0f)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ECS_MAP_SSE2
+#endif
 
-typedef struct ecs_map_node_t {
-    uint64_t key;           /* Key */
-    uint32_t next;          /* Next node index */
-    uint32_t prev;          /* Previous node index (enables O(1) removal) */
-} ecs_map_node_t;
+/* The map is an open addressing hash table with a control byte per slot. The
+ * control bytes of a group of slots are tested with a single SIMD compare, so
+ * that a lookup rarely has to look at keys that do not match. */
+
+/* Number of control bytes that are probed at once */
+#define ECS_MAP_GROUP_SIZE (16)
+
+/* Control byte values. Full slots store the lower 7 bits of the hash, so that
+ * the sign bit identifies slots that are empty or deleted. */
+#define ECS_MAP_EMPTY ((int8_t)-128)
+#define ECS_MAP_DELETED ((int8_t)-2)
+
+/* Maximum number of elements for a number of slots (load factor of 7/8) */
+#define ECS_MAP_MAX_LOAD(bucket_count) ((bucket_count) - (bucket_count) / 8)
 
 struct ecs_map_t {
-    uint32_t *buckets;      /* Array of buckets */
-    ecs_vector_t *nodes;    /* Array with memory for map nodes */
-    ecs_vector_params_t node_params; /* Parameters for node vector */
-    size_t bucket_count;    /* number of buckets */
-    uint32_t count;         /* number of elements */
-    uint32_t min;           /* minimum number of elements */
+    int8_t *ctrl;           /* Control bytes, followed by slots in memory */
+    void *slots;            /* Array with keys and data */
+    uint32_t slot_size;     /* Size of key and data */
+    uint32_t data_size;     /* Size of data */
+    uint32_t bucket_count;  /* Number of slots, power of 2 (or 0) */
+    uint32_t count;         /* Number of elements */
+    uint32_t growth_left;   /* Number of empty slots that may be used */
+    uint32_t min;           /* Minimum number of slots */
 };
 
-static
-size_t data_size(
-    ecs_map_t *map)
-{
-    return map->node_params.element_size - sizeof(ecs_map_node_t);
-}
+/** Bitmask with a bit for each slot in a group */
+typedef uint32_t group_mask_t;
 
-/** Get map node from index */
+/** Mix key bits, so that keys with a pattern in their lower bits (like
+ * pointers or sequential ids) are spread out over the table */
 static
-ecs_map_node_t *node_from_index(
-    ecs_map_t *map,
-    ecs_vector_t *nodes,
-    uint32_t index)
+uint64_t hash_key(
+    uint64_t key)
 {
-    return ecs_vector_get(nodes, &map->node_params, index - 1);
+    key ^= key >> 32;
+    key *= 0x9E3779B97F4A7C15ull;
+    return key ^ (key >> 29);
 }
 
-/** Get a bucket for a given key */
 static
-uint32_t* get_bucket(
-    ecs_map_t *map,
-    uint64_t key)
+int8_t hash_h2(
+    uint64_t hash)
 {
-    uint64_t index = key % map->bucket_count;
-    return &map->buckets[index];
+    return (int8_t)(hash & 0x7F);
 }
 
-/** Callback that updates administration when node is moved in nodes array */
 static
-void move_node(
-    ecs_vector_t *array,
-    const ecs_vector_params_t *params,
-    void *to,
-    void *from,
-    void *ctx)
-{
-    ecs_map_t *map = ctx;
-    ecs_map_node_t *node_p = to;
-    uint32_t node = ecs_vector_get_index(array, &map->node_params, to) + 1;
-    uint32_t prev = node_p->prev;
-    uint32_t next = node_p->next;
-    (void)params;
-    (void)from;
-
-    if (prev) {
-        ecs_map_node_t *prev_p = node_from_index(map, array, prev);
-        prev_p->next = node;
-    } else {
-        uint32_t *bucket = get_bucket(map, node_p->key);
-        *bucket = node;
+uint32_t first_bit(
+    group_mask_t mask)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctz(mask);
+#else
+    uint32_t result = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        result ++;
     }
+    return result;
+#endif
+}
 
-    if (next) {
-        ecs_map_node_t *next_p = node_from_index(map, array, next);
-        next_p->prev = node;
+/** Slots in group with control byte equal to h2 */
+static
+group_mask_t group_match(
+    const int8_t *ctrl,
+    int8_t h2)
+{
+#ifdef ECS_MAP_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+    return (group_mask_t)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_set1_epi8(h2), group));
+#else
+    group_mask_t result = 0;
+    uint32_t i;
+    for (i = 0; i < ECS_MAP_GROUP_SIZE; i ++) {
+        result |= (group_mask_t)(ctrl[i] == h2) << i;
     }
+    return result;
+#endif
 }
 
-/** Allocate the buckets buffer */
+/** Slots in group that are empty or deleted */
 static
-void alloc_buffer(
-    ecs_map_t *map,
-    uint32_t bucket_count)
-{
-    if (bucket_count) {
-        map->buckets = ecs_os_calloc(bucket_count * sizeof(uint32_t), 1);
-        ecs_assert(map->buckets != NULL, ECS_OUT_OF_MEMORY, 0);
-    } else {
-        map->buckets = NULL;
+group_mask_t group_match_free(
+    const int8_t *ctrl)
+{
+#ifdef ECS_MAP_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+    return (group_mask_t)_mm_movemask_epi8(group);
+#else
+    group_mask_t result = 0;
+    uint32_t i;
+    for (i = 0; i < ECS_MAP_GROUP_SIZE; i ++) {
+        result |= (group_mask_t)(ctrl[i] < 0) << i;
     }
-
-    map->bucket_count = bucket_count;
+    return result;
+#endif
 }
 
-/** Allocate a map object */
 static
-ecs_map_t *alloc_map(
-    uint32_t bucket_count,
-    uint32_t data_size)
+group_mask_t group_match_full(
+    const int8_t *ctrl)
 {
-    ecs_map_t *result = ecs_os_malloc(sizeof(ecs_map_t));
-    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
-
-    alloc_buffer(result, bucket_count);
-    result->count = 0;
-    result->min = bucket_count;
-    result->node_params = (ecs_vector_params_t){
-        .element_size = data_size + sizeof(ecs_map_node_t),
-        .move_action = move_node
-    };
-
-    result->nodes = ecs_vector_new(&result->node_params, ECS_MAP_INITIAL_NODE_COUNT);
-    
-    return result;
+    return ~group_match_free(ctrl) & ((1u << ECS_MAP_GROUP_SIZE) - 1);
 }
 
-/** Find next non-empty bucket */
 static
-uint32_t next_bucket(
+uint64_t* get_slot(
     ecs_map_t *map,
-    uint32_t start_index)
+    uint32_t index)
 {
-    size_t i;
-    for (i = start_index; i < map->bucket_count; i ++) {
-        if (map->buckets[i]) {
-            break;
-        }
-    }
-
-    return i;
+    return ECS_OFFSET(map->slots, index * map->slot_size);
 }
 
 static
-void *get_node_data(
-    ecs_map_node_t *node)
+void *get_slot_data(
+    uint64_t *slot)
 {
-    return ECS_OFFSET(node, sizeof(ecs_map_node_t));
+    return ECS_OFFSET(slot, sizeof(uint64_t));
 }
 
 static
-void set_node_data(
+void set_slot_data(
     ecs_map_t *map,
-    ecs_map_node_t *node,
+    uint64_t *slot,
     const void *data)
 {
-    void *node_data = get_node_data(node);
-    if (data != node_data) { 
+    void *slot_data = get_slot_data(slot);
+    if (data != slot_data) {
         if (data) {
-            memcpy(node_data, data, data_size(map));
+            memcpy(slot_data, data, map->data_size);
         } else {
-            memset(node_data, 0, data_size(map));
+            memset(slot_data, 0, map->data_size);
         }
     }
 }
 
-/** Add new node to bucket */
+/** Smallest number of slots that can store count elements */
 static
-void* add_node(
-    ecs_map_t *map,
-    uint32_t *bucket,
-    uint64_t key,
-    const void *data,
-    ecs_map_node_t *elem_p)
+uint32_t bucket_count_for(
+    uint32_t count)
 {
-    uint32_t elem;
+    if (!count) {
+        return 0;
+    }
 
-    if (!elem_p) {
-        elem_p = ecs_vector_add(&map->nodes, &map->node_params);
-        elem = ecs_vector_count(map->nodes);
-    } else {
-        elem = ecs_vector_get_index(
-            map->nodes,
-            &map->node_params,
-            elem_p) + 1;
+    uint32_t result = ECS_MAP_GROUP_SIZE;
+    while (ECS_MAP_MAX_LOAD(result) < count) {
+        result *= 2;
     }
 
-    elem_p->key = key;
-    elem_p->next = 0;
-    elem_p->prev = 0;
-    set_node_data(map, elem_p, data);
+    return result;
+}
 
-    uint32_t first = *bucket;
-    if (first) {
-        ecs_map_node_t *first_p = node_from_index(map, map->nodes, first);
-        first_p->prev = elem;
-        elem_p->next = first;
+/** Allocate control bytes and slots in a single buffer */
+static
+void alloc_buffer(
+    ecs_map_t *map,
+    uint32_t bucket_count)
+{
+    if (bucket_count) {
+        map->ctrl = ecs_os_malloc(bucket_count * (1 + map->slot_size));
+        ecs_assert(map->ctrl != NULL, ECS_OUT_OF_MEMORY, 0);
+        memset(map->ctrl, ECS_MAP_EMPTY, bucket_count);
+        map->slots = ECS_OFFSET(map->ctrl, bucket_count);
+    } else {
+        map->ctrl = NULL;
+        map->slots = NULL;
     }
 
-    *bucket = elem;
+    map->bucket_count = bucket_count;
+    map->growth_left = ECS_MAP_MAX_LOAD(bucket_count);
+}
 
-    map->count ++;
+/** Find slot with key, or -1 if the key is not in the map */
+static
+int32_t find_slot(
+    ecs_map_t *map,
+    uint64_t key,
+    uint64_t hash)
+{
+    int8_t h2 = hash_h2(hash);
+    uint32_t group_mask = map->bucket_count / ECS_MAP_GROUP_SIZE - 1;
+    uint32_t group = (uint32_t)(hash >> 7) & group_mask;
+    uint32_t step = 0;
+
+    /* Probing terminates, as the load factor guarantees empty slots */
+    for (;;) {
+        uint32_t offset = group * ECS_MAP_GROUP_SIZE;
+        const int8_t *ctrl = &map->ctrl[offset];
+
+        group_mask_t match = group_match(ctrl, h2);
+        while (match) {
+            uint32_t index = offset + first_bit(match);
+            if (*get_slot(map, index) == key) {
+                return index;
+            }
+            match &= match - 1;
+        }
+
+        if (group_match(ctrl, ECS_MAP_EMPTY)) {
+            return -1;
+        }
 
-    return elem_p;
+        step ++;
+        group = (group + step) & group_mask;
+    }
 }
 
-/** Get map node for a given key */
+/** Find first empty or deleted slot for hash */
 static
-ecs_map_node_t *get_node(
+uint32_t find_free_slot(
     ecs_map_t *map,
-    uint32_t *bucket,
-    uint64_t key)
+    uint64_t hash)
 {
-    uint32_t node = *bucket;
-
-    while (node) {
-        ecs_map_node_t *node_p = node_from_index(map, map->nodes, node);
+    uint32_t group_mask = map->bucket_count / ECS_MAP_GROUP_SIZE - 1;
+    uint32_t group = (uint32_t)(hash >> 7) & group_mask;
+    uint32_t step = 0;
 
-        if (node_p->prev) {
-            assert(node_from_index(map, map->nodes, node_p->prev)->next == node);
-        }
-        if (node_p->next) {
-            assert(node_from_index(map, map->nodes, node_p->next)->prev == node);
+    for (;;) {
+        uint32_t offset = group * ECS_MAP_GROUP_SIZE;
+        group_mask_t free_slots = group_match_free(&map->ctrl[offset]);
+        if (free_slots) {
+            return offset + first_bit(free_slots);
         }
 
-        if (node_p->key == key) {
-            return node_p;
-        }
-        node = node_p->next;
+        step ++;
+        group = (group + step) & group_mask;
     }
+}
 
-    return NULL;
+/** Store key and data in free slot */
+static
+uint64_t* insert_slot(
+    ecs_map_t *map,
+    uint32_t index,
+    uint64_t key,
+    uint64_t hash,
+    const void *data)
+{
+    if (map->ctrl[index] == ECS_MAP_EMPTY) {
+        map->growth_left --;
+    }
+
+    map->ctrl[index] = hash_h2(hash);
+    map->count ++;
+
+    uint64_t *slot = get_slot(map, index);
+    *slot = key;
+    set_slot_data(map, slot, data);
+
+    return slot;
 }
 
-/** Resize number of buckets in a map */
+/** Move elements to a new buffer, which also removes deleted slots */
 static
 void resize_map(
     ecs_map_t *map,
     uint32_t bucket_count)
 {
     ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(ECS_MAP_MAX_LOAD(bucket_count) >= map->count,
+        ECS_INTERNAL_ERROR, NULL);
 
-    uint32_t *old_buckets = map->buckets;
+    int8_t *old_ctrl = map->ctrl;
+    void *old_slots = map->slots;
     uint32_t old_bucket_count = map->bucket_count;
 
     alloc_buffer(map, bucket_count);
     map->count = 0;
 
-    uint32_t bucket_index;
-    for (bucket_index = 0; bucket_index < old_bucket_count; bucket_index ++) {
-        uint32_t bucket = old_buckets[bucket_index];
-        if (bucket) {
-            uint32_t node = bucket;
-            uint32_t next;
-            uint64_t key;
-
-            ecs_map_node_t *node_p;
-            do {
-                node_p = node_from_index(map, map->nodes, node);
-                next = node_p->next;
-                key = node_p->key;
-                uint32_t *new_bucket = get_bucket(map, key);
-                add_node(map, new_bucket, key, get_node_data(node_p), node_p);
-            } while ((node = next));
+    uint32_t i;
+    for (i = 0; i < old_bucket_count; i ++) {
+        if (old_ctrl[i] >= 0) {
+            uint64_t *slot = ECS_OFFSET(old_slots, i * map->slot_size);
+            uint64_t hash = hash_key(*slot);
+            insert_slot(map, find_free_slot(map, hash), *slot, hash,
+                get_slot_data(slot));
         }
     }
 
-    ecs_os_free(old_buckets);
+    ecs_os_free(old_ctrl);
 }
 
 
@@ -267,7 +302,19 @@ ecs_map_t* ecs_map_new(
     if (!data_size) {
         data_size = sizeof(uint64_t);
     }
-    return alloc_map((float)size / FLECS_LOAD_FACTOR, data_size);
+
+    ecs_map_t *result = ecs_os_malloc(sizeof(ecs_map_t));
+    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    /* Keep keys 8 byte aligned */
+    result->data_size = data_size;
+    result->slot_size = sizeof(uint64_t) + ((data_size + 7) & ~7u);
+    result->count = 0;
+    result->min = bucket_count_for(size);
+
+    alloc_buffer(result, result->min);
+
+    return result;
 }
 
 void ecs_map_clear(
@@ -275,30 +322,29 @@ void ecs_map_clear(
 {
     ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
 
-    uint32_t target_size = (float)map->count / FLECS_LOAD_FACTOR;
+    /* Size the map for the number of elements it had before it was cleared,
+     * as maps are often cleared and then filled up again */
+    uint32_t target_size = bucket_count_for(map->count);
 
     if (target_size < map->min) {
         target_size = map->min;
     }
 
-    if (target_size < (float)map->bucket_count * 0.75) {
-        ecs_os_free(map->buckets);
+    if (target_size < map->bucket_count) {
+        ecs_os_free(map->ctrl);
         alloc_buffer(map, target_size);
-    } else {
-        memset(map->buckets, 0, sizeof(int32_t) * map->bucket_count);
+    } else if (map->bucket_count) {
+        memset(map->ctrl, ECS_MAP_EMPTY, map->bucket_count);
+        map->growth_left = ECS_MAP_MAX_LOAD(map->bucket_count);
     }
 
-    ecs_vector_reclaim(&map->nodes, &map->node_params);
-    ecs_vector_clear(map->nodes);
-
     map->count = 0;
 }
 
 void ecs_map_free(
     ecs_map_t *map)
 {
-    ecs_vector_free(map->nodes);
-    ecs_os_free(map->buckets);
+    ecs_os_free(map->ctrl);
     ecs_os_free(map);
 }
 
@@ -313,33 +359,34 @@ void* _ecs_map_set(
     (void)size;
     ecs_assert(ecs_map_data_size(map) == size, ECS_INVALID_PARAMETER, NULL);
 
-    uint32_t bucket_count = map->bucket_count;
-    if (!bucket_count) {
-        alloc_buffer(map, 2);
-        bucket_count = map->bucket_count;
-    }
+    uint64_t hash = hash_key(key);
 
-    if ((((float)map->count) / (float)bucket_count) > FLECS_LOAD_FACTOR) {
-        resize_map(map, bucket_count * 2);
+    if (!map->bucket_count) {
+        alloc_buffer(map, ECS_MAP_GROUP_SIZE);
+    } else {
+        int32_t index = find_slot(map, key, hash);
+        if (index >= 0) {
+            uint64_t *slot = get_slot(map, index);
+            set_slot_data(map, slot, data);
+            return get_slot_data(slot);
+        }
     }
 
-    uint32_t *bucket = get_bucket(map, key);
-    ecs_map_node_t *node = NULL;
+    uint32_t index = find_free_slot(map, hash);
 
-    if (!*bucket) {
-        node = add_node(map, bucket, key, data, NULL);
-    } else {
-        node = get_node(map, bucket, key);
-        if (node) {
-            set_node_data(map, node, data);
-        } else {
-            node = add_node(map, bucket, key, data, NULL);
+    if (!map->growth_left && map->ctrl[index] == ECS_MAP_EMPTY) {
+        /* If most of the used slots are deleted, rehashing the map is enough
+         * to make room for the new element. */
+        uint32_t bucket_count = map->bucket_count;
+        if (map->count >= ECS_MAP_MAX_LOAD(bucket_count) / 2) {
+            bucket_count *= 2;
         }
-    }
 
-    ecs_assert(node != NULL, ECS_INTERNAL_ERROR, NULL);
+        resize_map(map, bucket_count);
+        index = find_free_slot(map, hash);
+    }
 
-    return get_node_data(node);
+    return get_slot_data(insert_slot(map, index, key, hash, data));
 }
 
 int ecs_map_remove(
@@ -350,37 +397,25 @@ int ecs_map_remove(
         return -1;
     }
 
-    uint32_t *bucket = get_bucket(map, key);
-
-    if (*bucket) {
-        ecs_map_node_t *node = get_node(map, bucket, key);
-        if (node) {
-            ecs_map_node_t *prev_node = node_from_index(map, map->nodes, node->prev);
-            ecs_map_node_t *next_node = node_from_index(map, map->nodes, node->next);
-
-            if (prev_node) {
-                assert(node_from_index(map, map->nodes, prev_node->next) == node);
-                prev_node->next = node->next;
-            } else {
-                *bucket = node->next;
-            }
-
-            if (next_node) {
-                assert(node_from_index(map, map->nodes, next_node->prev) == node);
-                next_node->prev = node->prev;
-            }
-
-            ecs_vector_params_t params = map->node_params;
-            params.move_ctx = map;
-
-            ecs_vector_remove(map->nodes, &params, node);
-            map->count --;
+    int32_t index = find_slot(map, key, hash_key(key));
+    if (index < 0) {
+        return -1;
+    }
 
-            return 0;
-        }
+    /* If the group has an empty slot, no probe sequence continued past this
+     * group, and the slot can be marked as empty. Otherwise lookups for keys
+     * stored in other groups have to continue probing at this slot. */
+    uint32_t group = (uint32_t)index & ~(ECS_MAP_GROUP_SIZE - 1u);
+    if (group_match(&map->ctrl[group], ECS_MAP_EMPTY)) {
+        map->ctrl[index] = ECS_MAP_EMPTY;
+        map->growth_left ++;
+    } else {
+        map->ctrl[index] = ECS_MAP_DELETED;
     }
 
-    return -1;
+    map->count --;
+
+    return 0;
 }
 
 void* ecs_map_get_ptr(
@@ -391,12 +426,9 @@ void* ecs_map_get_ptr(
         return 0;
     }
 
-    uint32_t *bucket = get_bucket(map, key);
-    if (*bucket) {
-        ecs_map_node_t *elem = get_node(map, bucket, key);
-        if (elem) {
-            return get_node_data(elem);
-        }
+    int32_t index = find_slot(map, key, hash_key(key));
+    if (index >= 0) {
+        return get_slot_data(get_slot(map, index));
     }
 
     return 0;
@@ -413,22 +445,20 @@ bool _ecs_map_has(
     if (!map) {
         return false;
     }
-    
+
     if (!map->count) {
         return false;
     }
 
-    ecs_assert(!value_out || (ecs_map_data_size(map) == size), ECS_INVALID_PARAMETER, NULL); 
+    ecs_assert(!value_out || (ecs_map_data_size(map) == size), ECS_INVALID_PARAMETER, NULL);
 
-    uint32_t *bucket = get_bucket(map, key_hash);
-    if (*bucket) {
-        ecs_map_node_t *elem = get_node(map, bucket, key_hash);
-        if (elem) {
-            if (value_out) {
-                memcpy(value_out, get_node_data(elem), data_size(map));
-            }
-            return true;
+    int32_t index = find_slot(map, key_hash, hash_key(key_hash));
+    if (index >= 0) {
+        if (value_out) {
+            memcpy(value_out, get_slot_data(get_slot(map, index)),
+                map->data_size);
         }
+        return true;
     }
 
     return false;
@@ -450,16 +480,23 @@ uint32_t ecs_map_set_size(
     ecs_map_t *map,
     uint32_t size)
 {
-    uint32_t result = ecs_vector_set_size(&map->nodes, &map->node_params, size);
-    resize_map(map, size / FLECS_LOAD_FACTOR);
-    return result;
+    if (size < map->count) {
+        size = map->count;
+    }
+
+    uint32_t bucket_count = bucket_count_for(size);
+    if (bucket_count != map->bucket_count) {
+        resize_map(map, bucket_count);
+    }
+
+    return ECS_MAP_MAX_LOAD(map->bucket_count);
 }
 
 uint32_t ecs_map_grow(
     ecs_map_t *map,
     uint32_t size)
 {
-    if (size > ecs_vector_size(map->nodes)) {
+    if (size > map->count + map->growth_left) {
         return ecs_map_set_size(map, size);
     }
 
@@ -468,21 +505,20 @@ uint32_t ecs_map_grow(
 
 void ecs_map_memory(
     ecs_map_t *map,
-    uint32_t *total,
-    uint32_t *used)
+    uint64_t *total,
+    uint64_t *used)
 {
     if (!map) {
         return;
     }
 
     if (total) {
-        *total += map->bucket_count * sizeof(uint32_t) + sizeof(ecs_map_t);
-        ecs_vector_memory(map->nodes, &map->node_params, total, NULL);
+        *total += (uint64_t)map->bucket_count * (1 + map->slot_size) + 
+            sizeof(ecs_map_t);
     }
 
     if (used) {
-        *used += map->count * sizeof(uint32_t);
-        ecs_vector_memory(map->nodes, &map->node_params, NULL, used);
+        *used += (uint64_t)map->count * (1 + map->slot_size);
     }
 }
 
@@ -490,10 +526,11 @@ ecs_map_t* ecs_map_copy(
     const ecs_map_t *map)
 {
     ecs_map_t *dst = ecs_os_memdup(map, sizeof(ecs_map_t));
-    dst->buckets = ecs_os_memdup(
-        map->buckets, map->bucket_count * sizeof(uint32_t));
-    
-    dst->nodes = ecs_vector_copy(map->nodes, &map->node_params);
+    if (map->bucket_count) {
+        dst->ctrl = ecs_os_memdup(
+            map->ctrl, map->bucket_count * (1 + map->slot_size));
+        dst->slots = ECS_OFFSET(dst->ctrl, map->bucket_count);
+    }
 
     return dst;
 }
@@ -503,8 +540,7 @@ ecs_map_iter_t ecs_map_iter(
 {
     ecs_map_iter_t result = {
         .map = map,
-        .bucket_index = -1,
-        .node = 0
+        .bucket_index = -1
     };
 
     return result;
@@ -518,34 +554,24 @@ bool ecs_map_hasnext(
         return false;
     }
 
-    if (!map->buckets) {
-        return false;
-    }
+    /* Find the next full slot one group at a time */
+    uint32_t index = iter_data->bucket_index + 1;
+    while (index < map->bucket_count) {
+        uint32_t group = index & ~(ECS_MAP_GROUP_SIZE - 1u);
+        group_mask_t full = group_match_full(&map->ctrl[group]) >>
+            (index - group);
 
-    uint32_t bucket_index = iter_data->bucket_index;
-    uint32_t node = iter_data->node;
+        if (full) {
+            iter_data->bucket_index = index + first_bit(full);
+            return true;
+        }
 
-    if (node) {
-        ecs_map_node_t *node_p = node_from_index(map, map->nodes, node);
-        node = node_p->next;
+        index = group + ECS_MAP_GROUP_SIZE;
     }
 
-    if (!node) {
-        bucket_index = next_bucket(map, bucket_index + 1);
-        if (bucket_index < map->bucket_count) {
-            node = map->buckets[bucket_index];
-        } else {
-            node = 0;
-        }
-    }
+    iter_data->bucket_index = map->bucket_count;
 
-    if (node) {
-        iter_data->node = node;
-        iter_data->bucket_index = bucket_index;
-        return true;
-    } else {
-        return false;
-    }
+    return false;
 }
 
 void* ecs_map_next_w_key_w_size(
@@ -556,12 +582,13 @@ void* ecs_map_next_w_key_w_size(
     (void)size;
 
     ecs_map_t *map = iter_data->map;
-    ecs_assert(!size || data_size(map) == size, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(!size || map->data_size == size, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(iter_data->bucket_index < map->bucket_count,
+        ECS_INTERNAL_ERROR, NULL);
 
-    ecs_map_node_t *node_p = node_from_index(map, map->nodes, iter_data->node);
-    assert(node_p != NULL);
-    if (key_out) *key_out = node_p->key;
-    return get_node_data(node_p);
+    uint64_t *slot = get_slot(map, iter_data->bucket_index);
+    if (key_out) *key_out = *slot;
+    return get_slot_data(slot);
 }
 
 void* ecs_map_next_w_key(
@@ -587,5 +614,5 @@ void* ecs_map_next_w_size(
 uint32_t ecs_map_data_size(
     ecs_map_t *map)
 {
-    return data_size(map);
+    return map->data_size;
 }
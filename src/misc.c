@@ -47,6 +47,75 @@ double ecs_time_measure(
     return ecs_time_to_double(stop);
 }
 
+void ecs_time_histogram_record(
+    ecs_time_histogram_t *hist,
+    double seconds)
+{
+    uint64_t units = (uint64_t)(seconds * 1000000000.0) / 
+        ECS_HISTOGRAM_RESOLUTION_NS;
+
+    /* Bucket is the number of significant bits of the sample */
+    uint32_t i, bucket = 0;
+    while (units && bucket < ECS_HISTOGRAM_BUCKET_COUNT - 1) {
+        units >>= 1;
+        bucket ++;
+    }
+
+    if (hist->count == ECS_HISTOGRAM_WINDOW) {
+        hist->count = 0;
+        for (i = 0; i < ECS_HISTOGRAM_BUCKET_COUNT; i ++) {
+            hist->buckets[i] /= 2;
+            hist->count += hist->buckets[i];
+        }
+
+        hist->prev_max_seconds = hist->max_seconds;
+        hist->max_seconds = 0;
+    }
+
+    hist->buckets[bucket] ++;
+    hist->count ++;
+
+    if (seconds > hist->max_seconds) {
+        hist->max_seconds = seconds;
+    }
+}
+
+float ecs_time_histogram_percentile(
+    const ecs_time_histogram_t *hist,
+    float percentile)
+{
+    float max = hist->max_seconds;
+    if (hist->prev_max_seconds > max) {
+        max = hist->prev_max_seconds;
+    }
+
+    if (!hist->count) {
+        return 0;
+    }
+
+    uint32_t i, sum = 0, target = hist->count * percentile;
+    if (target < 1) {
+        target = 1;
+    }
+
+    for (i = 0; i < ECS_HISTOGRAM_BUCKET_COUNT - 1; i ++) {
+        sum += hist->buckets[i];
+        if (sum >= target) {
+            break;
+        }
+    }
+
+    float upper = (float)((uint64_t)ECS_HISTOGRAM_RESOLUTION_NS << i) / 
+        1000000000.0f;
+
+    /* The bucket bound can't exceed the largest sample */
+    if (upper > max) {
+        upper = max;
+    }
+
+    return upper;
+}
+
 void* ecs_os_memdup(const void *src, size_t size) {
     void *dst = ecs_os_malloc(size);
     ecs_assert(dst != NULL, ECS_OUT_OF_MEMORY, NULL);
@@ -0,0 +1,364 @@
+#include "flecs_private.h"
+
+/* The name index maps a hash of (parent, name) to a vector of entities. An
+ * entity is registered with parent 0, and with each parent in its type. A
+ * bucket may contain entities that were renamed, deleted, or that collide with
+ * another (parent, name) pair, so candidates are always verified against the
+ * current name and type of the entity. */
+
+static
+uint64_t name_key(
+    ecs_entity_t parent,
+    const char *name)
+{
+    uint32_t hash = 0;
+    ecs_hash(&parent, sizeof(ecs_entity_t), &hash);
+    ecs_hash(name, strlen(name), &hash);
+    return hash;
+}
+
+/** Find the position of an entity in a bucket. Buckets are sorted by entity id,
+ * so that a name shared by many entities (like the children of instances of
+ * the same prefab) does not require a linear scan for each added entity. */
+static
+bool bucket_find(
+    ecs_vector_t *bucket,
+    ecs_entity_t entity,
+    uint32_t *index_out)
+{
+    ecs_entity_t *buffer = ecs_vector_first(bucket);
+    uint32_t lo = 0, hi = ecs_vector_count(bucket);
+
+    /* New entities usually have the highest id */
+    if (!hi || buffer[hi - 1] < entity) {
+        *index_out = hi;
+        return false;
+    }
+
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (buffer[mid] < entity) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    *index_out = lo;
+
+    return buffer[lo] == entity;
+}
+
+/** Remove entity at index, while keeping the bucket sorted */
+static
+void bucket_remove_index(
+    ecs_vector_t *bucket,
+    uint32_t index)
+{
+    ecs_entity_t *buffer = ecs_vector_first(bucket);
+    uint32_t count = ecs_vector_count(bucket);
+
+    memmove(&buffer[index], &buffer[index + 1], 
+        (count - index - 1) * sizeof(ecs_entity_t));
+
+    ecs_vector_remove_last(bucket);
+}
+
+static
+void add_to_bucket(
+    ecs_map_t *index,
+    uint64_t key,
+    ecs_entity_t entity)
+{
+    ecs_vector_t *entities = NULL;
+    ecs_vector_t **bucket = ecs_map_get_ptr(index, key);
+
+    if (!bucket) {
+        bucket = ecs_map_set(index, key, &entities);
+    }
+
+    uint32_t i;
+    if (bucket_find(*bucket, entity, &i)) {
+        return;
+    }
+
+    uint32_t count = ecs_vector_count(*bucket);
+    ecs_vector_add(bucket, &handle_arr_params);
+
+    ecs_entity_t *buffer = ecs_vector_first(*bucket);
+    memmove(&buffer[i + 1], &buffer[i], (count - i) * sizeof(ecs_entity_t));
+    buffer[i] = entity;
+}
+
+static
+void remove_from_bucket(
+    ecs_map_t *index,
+    uint64_t key,
+    ecs_entity_t entity)
+{
+    ecs_vector_t **bucket = ecs_map_get_ptr(index, key);
+    if (!bucket) {
+        return;
+    }
+
+    uint32_t i;
+    if (bucket_find(*bucket, entity, &i)) {
+        bucket_remove_index(*bucket, i);
+    }
+}
+
+/** Test if entity is alive, has the specified name and contains the parent.
+ * If the entity no longer belongs in the bucket of key, is_stale is set. */
+static
+bool match_entity(
+    ecs_world_t *world,
+    uint64_t key,
+    ecs_entity_t key_parent,
+    ecs_entity_t entity,
+    ecs_entity_t parent,
+    const char *name,
+    bool *is_stale)
+{
+    *is_stale = true;
+
+    if (!ecs_is_alive(world, entity)) {
+        return false;
+    }
+
+    const char *id = ecs_get_id(world, entity);
+    if (!id) {
+        return false;
+    }
+
+    if (strcmp(id, name)) {
+        /* The entity may have been renamed, or its name hashes to the same
+         * bucket as the name that is looked up. */
+        if (name_key(key_parent, id) != key) {
+            return false;
+        }
+
+        *is_stale = false;
+        return false;
+    }
+
+    *is_stale = false;
+
+    if (parent) {
+        ecs_type_t type = ecs_get_type(world, entity);
+        if (ecs_type_index_of(type, parent) == -1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/** Find entity in the bucket of key. Entities that no longer belong in the
+ * bucket are removed if purge is true. */
+static
+ecs_entity_t find_in_bucket(
+    ecs_world_t *world,
+    ecs_map_t *index,
+    ecs_entity_t key_parent,
+    ecs_entity_t parent,
+    const char *name,
+    bool purge)
+{
+    uint64_t key = name_key(key_parent, name);
+    ecs_vector_t **bucket = ecs_map_get_ptr(index, key);
+    if (!bucket) {
+        return 0;
+    }
+
+    ecs_entity_t *buffer = ecs_vector_first(*bucket);
+    uint32_t i, count = ecs_vector_count(*bucket);
+
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = buffer[i];
+        bool is_stale;
+
+        if (match_entity(world, key, key_parent, e, parent, name, &is_stale)) {
+            return e;
+        }
+
+        if (is_stale && purge) {
+            bucket_remove_index(*bucket, i);
+            buffer = ecs_vector_first(*bucket);
+            count --;
+            i --;
+        }
+    }
+
+    return 0;
+}
+
+static
+ecs_entity_t find_in_index(
+    ecs_world_t *world,
+    ecs_map_t *index,
+    ecs_entity_t parent,
+    const char *name,
+    bool purge)
+{
+    ecs_entity_t result = find_in_bucket(
+        world, index, parent, parent, name, purge);
+
+    /* Entities are only registered with the parents they had when their name
+     * was set. If the entity was adopted later, or if parent is a component of
+     * the entity, find it through the entities registered without parent. */
+    if (!result && parent) {
+        result = find_in_bucket(
+            world, index, 0, parent, name, purge);
+
+        /* Cache the result, so next lookup is found in the parent bucket */
+        if (result && purge) {
+            add_to_bucket(index, name_key(parent, name), result);
+        }
+    }
+
+    return result;
+}
+
+/* -- Private functions -- */
+
+void ecs_name_index_add(
+    ecs_map_t *index,
+    ecs_entity_t entity,
+    ecs_type_t type,
+    const char *name)
+{
+    if (!name) {
+        return;
+    }
+
+    add_to_bucket(index, name_key(0, name), entity);
+
+    ecs_entity_t *array = ecs_vector_first(type);
+    uint32_t i, count = ecs_vector_count(type);
+    for (i = 0; i < count; i ++) {
+        if (array[i] & ECS_CHILDOF) {
+            add_to_bucket(
+                index, name_key(array[i] & ECS_ENTITY_MASK, name), entity);
+        }
+    }
+}
+
+void ecs_name_index_remove(
+    ecs_map_t *index,
+    ecs_entity_t entity,
+    ecs_type_t type,
+    const char *name)
+{
+    if (!name) {
+        return;
+    }
+
+    remove_from_bucket(index, name_key(0, name), entity);
+
+    ecs_entity_t *array = ecs_vector_first(type);
+    uint32_t i, count = ecs_vector_count(type);
+    for (i = 0; i < count; i ++) {
+        if (array[i] & ECS_CHILDOF) {
+            remove_from_bucket(
+                index, name_key(array[i] & ECS_ENTITY_MASK, name), entity);
+        }
+    }
+}
+
+void ecs_name_index_add_table(
+    ecs_map_t *index,
+    ecs_table_t *table)
+{
+    int16_t column_index = ecs_type_index_of(table->type, EEcsId);
+    if (column_index == -1) {
+        return;
+    }
+
+    ecs_entity_t *entities = ecs_vector_first(table->columns[0].data);
+    EcsId *names = ecs_vector_first(table->columns[column_index + 1].data);
+    uint32_t i, count = ecs_vector_count(table->columns[0].data);
+
+    for (i = 0; i < count; i ++) {
+        ecs_name_index_add(index, entities[i], table->type, names[i]);
+    }
+}
+
+void ecs_name_index_clear(
+    ecs_map_t *index)
+{
+    ecs_map_iter_t it = ecs_map_iter(index);
+    while (ecs_map_hasnext(&it)) {
+        ecs_vector_t *entities = ecs_map_nextptr(&it);
+        ecs_vector_free(entities);
+    }
+
+    ecs_map_clear(index);
+}
+
+void ecs_name_index_rebuild(
+    ecs_world_t *world)
+{
+    ecs_map_t *index = world->main_stage.name_index;
+    ecs_name_index_clear(index);
+
+    ecs_chunked_t *tables = world->main_stage.tables;
+    uint32_t i, count = ecs_chunked_count(tables);
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, i);
+        if (table->columns) {
+            ecs_name_index_add_table(index, table);
+        }
+    }
+}
+
+void ecs_name_index_merge(
+    ecs_world_t *world,
+    ecs_stage_t *stage)
+{
+    ecs_map_t *dst = world->main_stage.name_index;
+    ecs_map_iter_t it = ecs_map_iter(stage->name_index);
+
+    while (ecs_map_hasnext(&it)) {
+        uint64_t key;
+        ecs_vector_t *entities = ecs_map_nextptr_w_key(&it, &key);
+        ecs_entity_t *buffer = ecs_vector_first(entities);
+        uint32_t i, count = ecs_vector_count(entities);
+
+        for (i = 0; i < count; i ++) {
+            add_to_bucket(dst, key, buffer[i]);
+        }
+    }
+
+    ecs_name_index_clear(stage->name_index);
+}
+
+ecs_entity_t ecs_name_index_lookup(
+    ecs_world_t *world,
+    ecs_entity_t parent,
+    const char *name)
+{
+    ecs_world_t *world_arg = world;
+    ecs_stage_t *stage = ecs_get_stage(&world);
+    ecs_entity_t result = 0;
+
+    /* Names that were set while in progress are stored in the stage. OnSet
+     * systems always run in progress, so the temporary stage can contain names
+     * until the next merge, even when the world is not in progress. */
+    if (stage == &world->main_stage) {
+        stage = &world->temp_stage;
+    }
+
+    if (ecs_map_count(stage->name_index)) {
+        result = find_in_index(
+            world_arg, stage->name_index, parent, name, false);
+    }
+
+    /* The main stage index may only be modified when not in progress, as it
+     * can be accessed by multiple threads while in progress */
+    if (!result) {
+        result = find_in_index(world_arg, world->main_stage.name_index,
+            parent, name, !world->in_progress);
+    }
+
+    return result;
+}
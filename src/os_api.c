@@ -1,5 +1,9 @@
 #include "flecs_private.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 static bool ecs_os_api_initialized = false;
 static bool ecs_os_api_debug_enabled = false;
 
@@ -269,6 +273,28 @@ void ecs_os_api_free(void *ptr) {
     free(ptr);
 }
 
+static
+int32_t ecs_os_api_ainc(
+    int32_t *value)
+{
+#if defined(_MSC_VER)
+    return _InterlockedIncrement((volatile long*)value);
+#else
+    return __sync_add_and_fetch(value, 1);
+#endif
+}
+
+static
+int32_t ecs_os_api_adec(
+    int32_t *value)
+{
+#if defined(_MSC_VER)
+    return _InterlockedDecrement((volatile long*)value);
+#else
+    return __sync_sub_and_fetch(value, 1);
+#endif
+}
+
 static
 char* ecs_os_api_strdup(const char *str) {
     int len = strlen(str);
@@ -293,6 +319,9 @@ void ecs_os_set_api_defaults(void)
     ecs_os_api.calloc = ecs_os_api_calloc;
     ecs_os_api.strdup = ecs_os_api_strdup;
 
+    ecs_os_api.ainc = ecs_os_api_ainc;
+    ecs_os_api.adec = ecs_os_api_adec;
+
 #ifdef __BAKE__
     ecs_os_api.thread_new = bake_thread_new;
     ecs_os_api.thread_join = bake_thread_join;
@@ -0,0 +1,323 @@
+#include "flecs_private.h"
+
+static
+uint32_t* get_table_index(
+    ecs_query_t *query,
+    ecs_table_t *table)
+{
+    return ecs_map_get_ptr(query->table_index, (uintptr_t)table);
+}
+
+/** Number of entities in table. Tables that never stored an entity have no
+ * entity array, so ecs_table_count cannot be used. */
+static
+uint32_t table_count(
+    ecs_table_t *table)
+{
+    return ecs_vector_count(table->columns[0].data);
+}
+
+/** Swap two tables in the tables array of a query, and update the index */
+static
+void swap_tables(
+    ecs_query_t *query,
+    uint32_t index_1,
+    uint32_t index_2)
+{
+    if (index_1 == index_2) {
+        return;
+    }
+
+    ecs_table_t **buffer = ecs_vector_first(query->tables);
+    ecs_table_t *table_1 = buffer[index_1];
+    ecs_table_t *table_2 = buffer[index_2];
+
+    buffer[index_1] = table_2;
+    buffer[index_2] = table_1;
+
+    ecs_map_set(query->table_index, (uintptr_t)table_1, &index_2);
+    ecs_map_set(query->table_index, (uintptr_t)table_2, &index_1);
+}
+
+/** Move table at index out of the range of tables that is iterated */
+static
+void deactivate_table(
+    ecs_query_t *query,
+    uint32_t index)
+{
+    ecs_assert(index < query->active_count, ECS_INTERNAL_ERROR, NULL);
+    query->active_count --;
+    swap_tables(query, index, query->active_count);
+}
+
+static
+void add_table(
+    ecs_query_t *query,
+    ecs_table_t *table)
+{
+    ecs_table_t **elem = ecs_vector_add(&query->tables, &ptr_params);
+    *elem = table;
+
+    uint32_t index = ecs_vector_count(query->tables) - 1;
+    ecs_map_set(query->table_index, (uintptr_t)table, &index);
+
+    ecs_query_t **q = ecs_vector_add(&table->queries, &ptr_params);
+    *q = query;
+
+    if (table_count(table)) {
+        ecs_query_activate_table(query, table);
+    }
+}
+
+static
+void remove_query_from_table(
+    ecs_query_t *query,
+    ecs_table_t *table)
+{
+    ecs_query_t **buffer = ecs_vector_first(table->queries);
+    uint32_t i, count = ecs_vector_count(table->queries);
+
+    for (i = 0; i < count; i ++) {
+        if (buffer[i] == query) {
+            ecs_vector_remove_index(table->queries, &ptr_params, i);
+            break;
+        }
+    }
+}
+
+static
+void remove_table(
+    ecs_query_t *query,
+    ecs_table_t *table,
+    uint32_t index)
+{
+    if (index < query->active_count) {
+        deactivate_table(query, index);
+        index = query->active_count;
+    }
+
+    swap_tables(query, index, ecs_vector_count(query->tables) - 1);
+    ecs_vector_remove_last(query->tables);
+    ecs_map_remove(query->table_index, (uintptr_t)table);
+
+    remove_query_from_table(query, table);
+}
+
+/** Add table to query if it matches the filter, or remove it if it no longer
+ * matches. Matching depends on the components inherited from prefabs, which
+ * can change after the table is created. */
+static
+void match_table(
+    ecs_world_t *world,
+    ecs_query_t *query,
+    ecs_table_t *table)
+{
+    bool match = ecs_type_match_w_filter(world, table->type, &query->filter);
+    uint32_t *index = get_table_index(query, table);
+
+    if (match && !index) {
+        add_table(query, table);
+    } else if (!match && index) {
+        remove_table(query, table, *index);
+    }
+}
+
+static
+void match_tables(
+    ecs_world_t *world,
+    ecs_query_t *query)
+{
+    ecs_chunked_t *tables = world->main_stage.tables;
+    uint32_t i, count = ecs_chunked_count(tables);
+
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, i);
+        match_table(world, query, table);
+    }
+}
+
+static
+void free_query(
+    ecs_query_t *query)
+{
+    ecs_vector_free(query->tables);
+    ecs_map_free(query->table_index);
+    ecs_os_free(query);
+}
+
+/* -- Private API -- */
+
+void ecs_queries_notify_of_table(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    ecs_query_t **buffer = ecs_vector_first(world->queries);
+    uint32_t i, count = ecs_vector_count(world->queries);
+
+    for (i = 0; i < count; i ++) {
+        match_table(world, buffer[i], table);
+    }
+}
+
+void ecs_queries_rematch(
+    ecs_world_t *world,
+    ecs_vector_t *tables)
+{
+    ecs_query_t **buffer = ecs_vector_first(world->queries);
+    uint32_t i, count = ecs_vector_count(world->queries);
+
+    for (i = 0; i < count; i ++) {
+        ecs_query_t *query = buffer[i];
+
+        if (!tables) {
+            match_tables(world, query);
+        } else {
+            ecs_table_t **table_buffer = ecs_vector_first(tables);
+            uint32_t t, t_count = ecs_vector_count(tables);
+            for (t = 0; t < t_count; t ++) {
+                match_table(world, query, table_buffer[t]);
+            }
+        }
+    }
+}
+
+void ecs_query_activate_table(
+    ecs_query_t *query,
+    ecs_table_t *table)
+{
+    uint32_t *index = get_table_index(query, table);
+    ecs_assert(index != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    if (*index >= query->active_count) {
+        swap_tables(query, *index, query->active_count);
+        query->active_count ++;
+    }
+}
+
+void ecs_queries_fini(
+    ecs_world_t *world)
+{
+    /* Tables are freed by the stage, only free the queries themselves */
+    ecs_query_t **buffer = ecs_vector_first(world->queries);
+    uint32_t i, count = ecs_vector_count(world->queries);
+
+    for (i = 0; i < count; i ++) {
+        free_query(buffer[i]);
+    }
+
+    ecs_vector_free(world->queries);
+    world->queries = NULL;
+}
+
+/* -- Public API -- */
+
+ecs_query_t* ecs_query_new(
+    ecs_world_t *world,
+    const ecs_filter_t *filter)
+{
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_FROM_WORKER, NULL);
+    ecs_assert(!world->in_progress, ECS_INVALID_WHILE_ITERATING, NULL);
+    ecs_assert(filter != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_query_t *result = ecs_os_malloc(sizeof(ecs_query_t));
+    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    result->world = world;
+    result->filter = *filter;
+    result->tables = NULL;
+    result->table_index = ecs_map_new(0, sizeof(uint32_t));
+    result->active_count = 0;
+
+    ecs_query_t **elem = ecs_vector_add(&world->queries, &ptr_params);
+    *elem = result;
+
+    match_tables(world, result);
+
+    return result;
+}
+
+void ecs_query_free(
+    ecs_query_t *query)
+{
+    ecs_world_t *world = query->world;
+    ecs_assert(!world->in_progress, ECS_INVALID_WHILE_ITERATING, NULL);
+
+    ecs_table_t **tables = ecs_vector_first(query->tables);
+    uint32_t i, count = ecs_vector_count(query->tables);
+
+    for (i = 0; i < count; i ++) {
+        remove_query_from_table(query, tables[i]);
+    }
+
+    ecs_query_t **buffer = ecs_vector_first(world->queries);
+    count = ecs_vector_count(world->queries);
+
+    for (i = 0; i < count; i ++) {
+        if (buffer[i] == query) {
+            ecs_vector_remove_index(world->queries, &ptr_params, i);
+            break;
+        }
+    }
+
+    free_query(query);
+}
+
+ecs_query_iter_t ecs_query_iter(
+    ecs_query_t *query)
+{
+    ecs_assert(query != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    /* Tables may have to be rematched if a prefab or parent changed its type
+     * since the last frame */
+    ecs_world_t *world = query->world;
+    if (world->should_match && !world->in_progress) {
+        ecs_world_rematch(world);
+    }
+
+    return (ecs_query_iter_t){
+        .query = query,
+        .index = 0,
+        .rows = {
+            .world = world
+        }
+    };
+}
+
+bool ecs_query_next(
+    ecs_query_iter_t *iter)
+{
+    ecs_query_t *query = iter->query;
+
+    /* Tables that became empty are only moved out of the active range here,
+     * so that emptying a table while iterating does not reorder the tables
+     * that have not been visited yet. While the world is in progress the query
+     * may be iterated by multiple threads, and is not modified. */
+    bool compact = !query->world->in_progress;
+
+    while (iter->index < query->active_count) {
+        /* Get array each time, tables may be added while iterating */
+        ecs_table_t *table = ((ecs_table_t**)
+            ecs_vector_first(query->tables))[iter->index];
+
+        uint32_t count = table_count(table);
+        if (!count) {
+            if (compact) {
+                /* Swaps the last active table into the current position */
+                deactivate_table(query, iter->index);
+            } else {
+                iter->index ++;
+            }
+            continue;
+        }
+
+        ecs_rows_t *rows = &iter->rows;
+        rows->table = table;
+        rows->table_columns = table->columns;
+        rows->count = count;
+        rows->entities = ecs_vector_first(table->columns[0].data);
+        iter->index ++;
+        return true;
+    }
+
+    return false;
+}
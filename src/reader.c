@@ -1,5 +1,31 @@
 #include "flecs_private.h"
 
+/** Copy as much of a string as fits in the buffer. The end of the string is
+ * padded with zero's to a multiple of 4 bytes. */
+static
+size_t ecs_name_reader_read(
+    char *buffer,
+    size_t size,
+    const char *name,
+    size_t len,
+    size_t *written)
+{
+    size_t read = len - *written;
+    if (read > size) {
+        read = size;
+    }
+
+    memcpy(buffer, ECS_OFFSET(name, *written), read);
+    *written += read;
+
+    size_t align = (((read - 1) / sizeof(int32_t)) + 1) * sizeof(int32_t);
+    if (align != read) {
+        memset(ECS_OFFSET(buffer, read), 0, align - read);
+    }
+
+    return align;
+}
+
 static
 void ecs_component_reader_fetch_component_data(
     ecs_reader_t *stream)
@@ -37,6 +63,10 @@ void ecs_component_reader_next(
         break;
 
     case EcsComponentSize:
+        reader->state = EcsComponentAlignment;
+        break;
+
+    case EcsComponentAlignment:
         reader->state = EcsComponentNameLength;
         reader->name = reader->name_column[reader->index];
         reader->len = strlen(reader->name) + 1;
@@ -100,6 +130,13 @@ size_t ecs_component_reader(
         ecs_component_reader_next(stream);
         break;
 
+    case EcsComponentAlignment:
+        *(int32_t*)buffer = 
+            (int32_t)reader->data_column[reader->index].alignment;
+        read = sizeof(int32_t);
+        ecs_component_reader_next(stream);
+        break;
+
     case EcsComponentNameLength:
         *(int32_t*)buffer = (int32_t)reader->len;
         read = sizeof(int32_t);
@@ -107,18 +144,8 @@ size_t ecs_component_reader(
         break;
 
     case EcsComponentName:
-        read = reader->len - reader->written;
-        if (read >= sizeof(int32_t)) {
-            *(int32_t*)buffer = *(int32_t*)ECS_OFFSET(reader->name, reader->written);
-            reader->written += sizeof(int32_t);
-        } else {
-            memcpy(buffer, ECS_OFFSET(reader->name, reader->written), read);
-            memset(ECS_OFFSET(buffer, read), 0, sizeof(int32_t) - read);
-            reader->written += read;
-        }
-
-        /* Always align buffer to multiples of 4 bytes */
-        read = sizeof(int32_t);
+        read = ecs_name_reader_read(
+            buffer, size, reader->name, reader->len, &reader->written);
 
         if (reader->written == reader->len) {
             ecs_component_reader_next(stream);
@@ -288,11 +315,16 @@ size_t ecs_table_reader(
 
     case EcsTableType: {
         ecs_entity_t *type_array = ecs_vector_first(reader->type);
-        *(int32_t*)buffer = *(int32_t*)ECS_OFFSET(type_array, reader->type_written);
-        reader->type_written += sizeof(int32_t);
-        read = sizeof(int32_t);
+        int32_t type_bytes = ecs_vector_count(reader->type) * sizeof(ecs_entity_t);
+        read = type_bytes - reader->type_written;
+        if (read > size) {
+            read = size;
+        }
 
-        if (reader->type_written == ecs_vector_count(reader->type) * sizeof(ecs_entity_t)) {
+        memcpy(buffer, ECS_OFFSET(type_array, reader->type_written), read);
+        reader->type_written += read;
+
+        if (reader->type_written == type_bytes) {
             ecs_table_reader_next(stream);
         }
         break;                
@@ -367,18 +399,8 @@ size_t ecs_table_reader(
         break;
 
     case EcsTableColumnName:   
-        read = reader->name_len - reader->name_written;
-        if (read >= sizeof(int32_t)) {
-            *(int32_t*)buffer = *(int32_t*)ECS_OFFSET(reader->name, reader->name_written);
-            reader->name_written += sizeof(int32_t);
-        } else {
-            memcpy(buffer, ECS_OFFSET(reader->name, reader->name_written), read);
-            memset(ECS_OFFSET(buffer, read), 0, sizeof(int32_t) - read);
-            reader->name_written += read;
-        }
-
-        /* Always align buffer to multiples of 4 bytes */
-        read = sizeof(int32_t);
+        read = ecs_name_reader_read(buffer, size, 
+            reader->name, reader->name_len, &reader->name_written);
 
         if (reader->name_written == reader->name_len) {
             ecs_table_reader_next(stream);
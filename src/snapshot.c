@@ -1,27 +1,85 @@
 #include "flecs_private.h"
 
 static
-void dup_table(
-    ecs_table_t *table)
+ecs_table_column_t* share_columns(
+    ecs_table_t *table,
+    ecs_table_column_t *columns)
 {
     uint32_t c, column_count = ecs_vector_count(table->type);
 
     /* First create a copy of columns structure */
-    table->columns = ecs_os_memdup(
-        table->columns, sizeof(ecs_table_column_t) * (column_count + 1));
+    ecs_table_column_t *result = ecs_os_memdup(
+        columns, sizeof(ecs_table_column_t) * (column_count + 1));
+    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
     
-    /* Now copy each column separately */
+    /* Share column data with the table. The data is copied when either the
+     * world or the snapshot modifies a column. */
+    for (c = 0; c < column_count + 1; c ++) {
+        result[c].data = ecs_vector_share(result[c].data);
+    }
+
+    return result;
+}
+
+/** Free columns of a table in a snapshot. This does not use the table API, as
+ * the table is a copy that is not known to the systems of the world. */
+static
+void free_columns(
+    ecs_table_t *table)
+{
+    ecs_table_column_t *columns = table->columns;
+    if (!columns) {
+        return;
+    }
+
+    uint32_t c, column_count = ecs_vector_count(table->type);
     for (c = 0; c < column_count + 1; c ++) {
-        ecs_table_column_t *column = &table->columns[c];
-        ecs_vector_params_t column_params = {.element_size = column->size};
-        column->data = ecs_vector_copy(column->data, &column_params);
+        ecs_vector_free(columns[c].data);
     }
+
+    ecs_os_free(columns);
+    table->columns = NULL;
+}
+
+static
+void dup_table(
+    ecs_table_t *table)
+{
+    table->columns = share_columns(table, table->columns);
+}
+
+/** Find the columns of a table in the most recent snapshot of a chain */
+static
+ecs_table_column_t* find_columns(
+    const ecs_snapshot_t *base,
+    ecs_snapshot_t **deltas,
+    uint32_t delta_count,
+    uint32_t table_index)
+{
+    int32_t i;
+    for (i = delta_count - 1; i >= 0; i --) {
+        ecs_chunked_t *tables = deltas[i]->tables;
+        if (table_index < ecs_chunked_count(tables)) {
+            ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, table_index);
+            if (table->columns) {
+                return table->columns;
+            }
+        }
+    }
+
+    if (table_index < ecs_chunked_count(base->tables)) {
+        ecs_table_t *table = ecs_chunked_get(
+            base->tables, ecs_table_t, table_index);
+        return table->columns;
+    }
+
+    return NULL;
 }
 
 static
 ecs_snapshot_t* snapshot_create(
     ecs_world_t *world,
-    const ecs_map_t *entity_index,
+    ecs_ei_t *entity_index,
     const ecs_chunked_t *tables,
     const ecs_filter_t *filter)
 {
@@ -30,17 +88,18 @@ ecs_snapshot_t* snapshot_create(
 
     /* Copy tables from world */
     result->tables = ecs_chunked_copy(tables);
+    result->is_delta = false;
     
     if (filter || !entity_index) {
         result->filter = filter ? *filter : (ecs_filter_t){0};
         result->entity_index = NULL;
     } else {
         result->filter = (ecs_filter_t){0};
-        result->entity_index = ecs_map_copy(entity_index);
+        result->entity_index = ecs_ei_copy(entity_index);
     }
 
-    /* We need to dup the table data, because right now the copied tables are
-     * still pointing to columns in the main stage. */
+    /* We need to dup the table columns, because right now the copied tables 
+     * are still pointing to columns in the main stage. */
     uint32_t i, count = ecs_chunked_count(result->tables);
     for (i = 0; i < count; i ++) {
         ecs_table_t *table = ecs_chunked_get(result->tables, ecs_table_t, i);
@@ -72,6 +131,18 @@ ecs_snapshot_t* snapshot_create(
 }
 
 /** Create a snapshot */
+static
+void reset_table_depths(
+    ecs_world_t *world)
+{
+    uint32_t i, count = ecs_chunked_count(world->main_stage.tables);
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_chunked_get(
+            world->main_stage.tables, ecs_table_t, i);
+        table->depth = -1;
+    }
+}
+
 ecs_snapshot_t* ecs_snapshot_take(
     ecs_world_t *world,
     const ecs_filter_t *filter)
@@ -84,6 +155,60 @@ ecs_snapshot_t* ecs_snapshot_take(
 
     result->last_handle = world->last_handle;
 
+    /* References of systems point to data that is now shared with the
+     * snapshot. Resolving them detaches the data before it is written. */
+    world->should_resolve = true;
+
+    return result;
+}
+
+/** Create a snapshot that only stores tables changed since prev */
+ecs_snapshot_t* ecs_snapshot_take_delta(
+    ecs_world_t *world,
+    const ecs_snapshot_t *prev)
+{
+    ecs_assert(prev != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    /* A filtered snapshot has no entity index, and cannot be used to
+     * determine which entities are alive when the chain is restored */
+    ecs_assert(prev->entity_index != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_snapshot_t *result = ecs_os_malloc(sizeof(ecs_snapshot_t));
+    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    result->tables = ecs_chunked_copy(world->main_stage.tables);
+    result->entity_index = ecs_ei_copy(world->main_stage.entity_index);
+    result->filter = (ecs_filter_t){0};
+    result->last_handle = world->last_handle;
+    result->is_delta = true;
+
+    uint32_t i, count = ecs_chunked_count(result->tables);
+    uint32_t prev_count = ecs_chunked_count(prev->tables);
+
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_chunked_get(result->tables, ecs_table_t, i);
+        if (table->flags & EcsTableHasBuiltins) {
+            continue;
+        }
+
+        /* The copied table stores the version at which it was taken. If it is
+         * the same as in the previous snapshot, the table did not change. Tables
+         * created after the previous snapshot are always stored. */
+        if (i < prev_count) {
+            ecs_table_t *prev_table = ecs_chunked_get(
+                prev->tables, ecs_table_t, i);
+
+            if (prev_table->version == table->version) {
+                table->columns = NULL;
+                continue;
+            }
+        }
+
+        dup_table(table);
+    }
+
+    world->should_resolve = true;
+
     return result;
 }
 
@@ -93,6 +218,10 @@ ecs_snapshot_t* ecs_snapshot_copy(
     const ecs_snapshot_t *snapshot,
     const ecs_filter_t *filter)
 {
+    /* Tables that did not change are not stored in a delta, filtering them
+     * would make them indistinguishable from tables that were filtered out */
+    ecs_assert(!snapshot->is_delta || !filter, ECS_INVALID_PARAMETER, NULL);
+
     ecs_snapshot_t *result = snapshot_create(
             world,
             snapshot->entity_index,
@@ -103,6 +232,8 @@ ecs_snapshot_t* ecs_snapshot_copy(
         result->filter = snapshot->filter;
     }
 
+    result->is_delta = snapshot->is_delta;
+
     result->last_handle = snapshot->last_handle;
 
     return result;
@@ -113,6 +244,8 @@ void ecs_snapshot_restore(
     ecs_world_t *world,
     ecs_snapshot_t *snapshot)
 {
+    ecs_assert(!snapshot->is_delta, ECS_INVALID_PARAMETER, NULL);
+
     ecs_filter_t filter = snapshot->filter;
     bool filter_used = false;
 
@@ -124,7 +257,7 @@ void ecs_snapshot_restore(
     } else {
         /* If no filter was used, the entity index will be an exact copy of what
          * it was before taking the snapshot */
-        ecs_map_free(world->main_stage.entity_index);
+        ecs_ei_free(world->main_stage.entity_index);
         world->main_stage.entity_index = snapshot->entity_index;
     }   
 
@@ -151,14 +284,14 @@ void ecs_snapshot_restore(
             ecs_vector_t *entities = dst->columns[0].data;
             ecs_entity_t *array = ecs_vector_first(entities);
             uint32_t j, row_count = ecs_vector_count(entities);
-            ecs_map_t *entity_index = world->main_stage.entity_index;
+            ecs_ei_t *entity_index = world->main_stage.entity_index;
             
             for (j = 0; j < row_count; j ++) {
                 ecs_row_t row = {
                     .type = dst->type,
                     .index = j + 1
                 };
-                ecs_map_set(entity_index, array[j], &row);
+                ecs_ei_set(entity_index, array[j], &row);
             } 
         }
     }
@@ -170,9 +303,17 @@ void ecs_snapshot_restore(
         ecs_table_replace_columns(world, table, NULL);
     }
 
+    /* Entities may have moved to other tables, which invalidates the depth of
+     * the tables with their children */
+    reset_table_depths(world);
+
     ecs_chunked_free(snapshot->tables);
 
+    /* Names of restored entities are not guaranteed to be in the index */
+    ecs_name_index_rebuild(world);
+
     world->should_match = true;
+    world->should_match_all = true;
     world->should_resolve = true;
 
     if (!filter_used) {
@@ -182,13 +323,74 @@ void ecs_snapshot_restore(
     ecs_os_free(snapshot);    
 }
 
+/** Restore a base snapshot with a chain of delta snapshots */
+void ecs_snapshot_restore_delta(
+    ecs_world_t *world,
+    const ecs_snapshot_t *base,
+    ecs_snapshot_t **deltas,
+    uint32_t delta_count)
+{
+    ecs_assert(base != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!base->is_delta, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(base->entity_index != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!delta_count || deltas != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    const ecs_snapshot_t *last = base;
+    if (delta_count) {
+        last = deltas[delta_count - 1];
+    }
+
+    /* The snapshots are not consumed, so they can be restored more than once.
+     * Tables and the entity index share their data with the snapshots until
+     * they are modified. */
+    ecs_ei_free(world->main_stage.entity_index);
+    world->main_stage.entity_index = ecs_ei_copy(last->entity_index);
+
+    uint32_t i, count = ecs_chunked_count(last->tables);
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *src = ecs_chunked_get(last->tables, ecs_table_t, i);
+        if (src->flags & EcsTableHasBuiltins) {
+            continue;
+        }
+
+        ecs_table_column_t *columns = find_columns(base, deltas, delta_count, i);
+        ecs_assert(columns != NULL, ECS_INVALID_PARAMETER, NULL);
+
+        ecs_table_t *dst = ecs_chunked_get(world->main_stage.tables, ecs_table_t, i);
+        ecs_table_replace_columns(world, dst, share_columns(dst, columns));
+
+        /* Deltas taken after restoring compare against the last snapshot */
+        dst->version = src->version;
+    }
+
+    /* Clear data from remaining tables */
+    uint32_t world_count = ecs_chunked_count(world->main_stage.tables);
+    for (; i < world_count; i ++) {
+        ecs_table_t *table = ecs_chunked_get(world->main_stage.tables, ecs_table_t, i);
+        ecs_table_replace_columns(world, table, NULL);
+    }
+
+    /* Entities may have moved to other tables, which invalidates the depth of
+     * the tables with their children */
+    reset_table_depths(world);
+
+    ecs_name_index_rebuild(world);
+
+    world->should_match = true;
+    world->should_match_all = true;
+    world->should_resolve = true;
+    world->last_handle = last->last_handle;
+}
+
 /** Cleanup snapshot */
 void ecs_snapshot_free(
     ecs_world_t *world,
     ecs_snapshot_t *snapshot)
 {
+    (void)world;
+
     if (snapshot->entity_index) {
-        ecs_map_free(snapshot->entity_index);
+        ecs_ei_free(snapshot->entity_index);
     }
 
     uint32_t i, count = ecs_chunked_count(snapshot->tables);
@@ -198,8 +400,7 @@ void ecs_snapshot_free(
             continue;
         }
 
-        ecs_table_replace_columns(world, src, NULL);
-        ecs_os_free(src->columns);
+        free_columns(src);
     }    
 
     ecs_chunked_free(snapshot->tables);
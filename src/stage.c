@@ -30,6 +30,30 @@ void notify_new_tables(
     }
 }
 
+/** Reset staged data for the next frame. The column arrays are kept, so that
+ * the next frame that stages data for the same type can reuse the memory. */
+static
+void reset_data_stage(
+    ecs_stage_t *stage)
+{
+    ecs_map_iter_t it = ecs_map_iter(stage->data_stage);
+    while (ecs_map_hasnext(&it)) {
+        uint64_t keyval;
+        ecs_table_column_t *columns = 
+            *(ecs_table_column_t**)ecs_map_next_w_key(&it, &keyval);
+        
+        ecs_type_t type = (ecs_type_t)(uintptr_t)keyval;
+        uint32_t i, count = ecs_vector_count(type);
+        
+        for(i = 0; i < count + 1; i ++) {
+            ecs_vector_clear(columns[i].data);
+        }
+    }
+
+    ecs_ei_clear(stage->entity_index);
+    ecs_map_clear(stage->remove_merge);
+}
+
 static
 void clean_data_stage(
     ecs_stage_t *stage)
@@ -50,7 +74,7 @@ void clean_data_stage(
         ecs_os_free(columns);
     }
 
-    ecs_map_clear(stage->entity_index);
+    ecs_ei_clear(stage->entity_index);
     ecs_map_clear(stage->remove_merge);
     ecs_map_clear(stage->data_stage);
 }
@@ -60,19 +84,28 @@ void merge_commits(
     ecs_world_t *world,
     ecs_stage_t *stage)
 {  
-    if (!ecs_map_count(stage->entity_index)) {
+    if (!ecs_ei_count(stage->entity_index)) {
         return;
     }
 
-    ecs_map_iter_t it = ecs_map_iter(stage->entity_index);
+    ecs_merge_entities(world, stage);
+    
+    reset_data_stage(stage);
+}
 
-    while (ecs_map_hasnext(&it)) {
-        ecs_entity_t entity;
-        ecs_row_t *row = ecs_map_next_w_key(&it, &entity);
-        ecs_merge_entity(world, stage, entity, *row);
+static
+void merge_deletes(
+    ecs_world_t *world,
+    ecs_stage_t *stage)
+{
+    ecs_entity_t *entities = ecs_vector_first(stage->delete_merge);
+    uint32_t i, count = ecs_vector_count(stage->delete_merge);
+
+    for (i = 0; i < count; i ++) {
+        ecs_release_entity(world, entities[i]);
     }
-    
-    clean_data_stage(stage);
+
+    ecs_vector_clear(stage->delete_merge);
 }
 
 static
@@ -108,7 +141,9 @@ void ecs_stage_init(
 
     memset(stage, 0, sizeof(ecs_stage_t));
 
-    stage->entity_index = ecs_map_new(0, sizeof(ecs_row_t));
+    /* Only the main stage stores all entities, other stages store deltas */
+    stage->entity_index = ecs_ei_new(is_main_stage);
+    stage->name_index = ecs_map_new(0, sizeof(ecs_vector_t*));
 
     if (is_main_stage) {
         stage->last_link = &world->main_stage.type_root.link;
@@ -151,12 +186,17 @@ void ecs_stage_deinit(
         clean_data_stage(stage);
         ecs_map_free(stage->data_stage);
         ecs_map_free(stage->remove_merge);
+        ecs_vector_free(stage->delete_merge);
+        ecs_vector_free(stage->merge_rows);
+        ecs_vector_free(stage->merge_entities);
     }
 
     clean_tables(world, stage);
     ecs_chunked_free(stage->tables);
     ecs_map_free(stage->table_index);
-    ecs_map_free(stage->entity_index);
+    ecs_ei_free(stage->entity_index);
+    ecs_name_index_clear(stage->name_index);
+    ecs_map_free(stage->name_index);
 }
 
 void ecs_stage_merge(
@@ -175,6 +215,12 @@ void ecs_stage_merge(
      * is found after merging the staged type with the non-staged type. */
     merge_commits(world, stage);
 
+    /* Add names that were set while in progress to the main name index */
+    ecs_name_index_merge(world, stage);
+
+    /* Release ids of deleted entities, after their data has been merged */
+    merge_deletes(world, stage);
+
     /* Clear temporary tables used by stage */
     clean_tables(world, stage);
     ecs_chunked_clear(stage->tables);
@@ -13,6 +13,13 @@ void StatsAddWorldStats(ecs_rows_t *rows) {
     ecs_set(rows->world, EcsWorld, EcsWorldStats, {0});
 }
 
+static
+void StatsAddThreadStats(ecs_rows_t *rows) {
+    ECS_COLUMN_COMPONENT(rows, EcsThreadStats, 1);
+
+    ecs_set(rows->world, EcsWorld, EcsThreadStats, {0});
+}
+
 static
 void StatsAddAllocStats(ecs_rows_t *rows) {
     ECS_COLUMN_COMPONENT(rows, EcsAllocStats, 1);
@@ -112,7 +119,7 @@ void StatsCollectWorldStats(ecs_rows_t *rows) {
 
     ecs_world_t *world = rows->world;
 
-    stats->entities_count = ecs_map_count(world->main_stage.entity_index);
+    stats->entities_count = ecs_ei_count(world->main_stage.entity_index);
     stats->components_count = ecs_count(world, EcsComponent);
     stats->col_systems_count = ecs_count(world, EcsColSystem);
     stats->row_systems_count = ecs_count(world, EcsRowSystem);
@@ -127,6 +134,52 @@ void StatsCollectWorldStats(ecs_rows_t *rows) {
     stats->frame_count_total = world->frame_count_total;
 }
 
+static
+ecs_time_percentiles_t compute_percentiles(
+    const ecs_time_histogram_t *hist)
+{
+    ecs_time_percentiles_t result;
+    result.p50_seconds = ecs_time_histogram_percentile(hist, 0.5);
+    result.p99_seconds = ecs_time_histogram_percentile(hist, 0.99);
+    result.max_seconds = ecs_time_histogram_percentile(hist, 1.0);
+    return result;
+}
+
+static
+void collect_stage_time(
+    ecs_stage_t *stage,
+    ecs_thread_time_stat_t *stats)
+{
+    stats->merges_count_total = stage->merge_count_total;
+    stats->merge_seconds_total = stage->merge_time_total;
+    stats->merge_seconds = compute_percentiles(&stage->merge_histogram);
+}
+
+static
+void StatsCollectThreadStats(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, EcsThreadStats, stats, 1);
+
+    ecs_world_t *world = rows->world;
+    ecs_thread_t *threads = ecs_vector_first(world->worker_threads);
+    uint32_t i, count = ecs_vector_count(world->worker_threads);
+
+    if (count > ECS_STATS_MAX_THREADS) {
+        count = ECS_STATS_MAX_THREADS;
+    }
+
+    stats->threads_count = count;
+    collect_stage_time(&world->temp_stage, &stats->main_thread);
+
+    for (i = 0; i < count; i ++) {
+        ecs_thread_time_stat_t *thread_stats = &stats->threads[i];
+        thread_stats->jobs_count_total = threads[i].job_count_total;
+        thread_stats->jobs_seconds_total = threads[i].job_time_total;
+        thread_stats->job_seconds = compute_percentiles(
+            &threads[i].job_histogram);
+        collect_stage_time(threads[i].stage, thread_stats);
+    }
+}
+
 static
 void StatsCollectAllocStats(ecs_rows_t *rows) {
     ECS_COLUMN(rows, EcsAllocStats, stats, 1);
@@ -163,31 +216,12 @@ void StatsCollectColSystemMemoryTotals(ecs_rows_t *rows) {
     }
 }
 
-static
-void StatsCollectTableMemoryTotals(ecs_rows_t *rows) {
-    ECS_COLUMN(rows, EcsTableStats, stats, 1);
-
-    EcsMemoryStats *world_stats = rows->param;
-
-    uint32_t i;
-    for (i = 0; i < rows->count; i ++) {
-        world_stats->components_memory.used_bytes += stats[i].component_memory.used_bytes;
-        world_stats->components_memory.allocd_bytes += stats[i].component_memory.allocd_bytes;
-
-        world_stats->entities_memory.used_bytes += stats[i].entity_memory.used_bytes;
-        world_stats->entities_memory.allocd_bytes += stats[i].entity_memory.allocd_bytes;
-
-        world_stats->tables_memory.used_bytes += stats[i].other_memory_bytes;
-        world_stats->tables_memory.allocd_bytes += stats[i].other_memory_bytes; 
-    }
-}
-
 static
 void compute_stage_memory(
     ecs_stage_t *stage, 
     EcsMemoryStats *stats)
 {
-    ecs_map_memory(stage->entity_index, 
+    ecs_ei_memory(stage->entity_index, 
         &stats->entities_memory.allocd_bytes, 
         &stats->entities_memory.used_bytes);
 
@@ -298,20 +332,19 @@ static
 void StatsCollectMemoryStats(ecs_rows_t *rows) {
     ECS_COLUMN(rows, EcsMemoryStats, stats, 1);
     ECS_COLUMN_ENTITY(rows, StatsCollectColSystemMemoryTotals, 2);
-    ECS_COLUMN_ENTITY(rows, StatsCollectTableMemoryTotals, 3);
 
     ecs_world_t *world = rows->world;
 
-    /* Compute entity memory (entity index) */
-    stats->entities_memory = (ecs_memory_stat_t){0};
-    ecs_map_memory(world->main_stage.entity_index, 
+    /* Memory of table columns is kept up to date by the tables, so that it
+     * does not have to be computed by walking all tables */
+    stats->entities_memory = world->entity_memory;
+    stats->components_memory = world->component_memory;
+    stats->tables_memory = (ecs_memory_stat_t){0};
+
+    /* Add entity index to entity memory */
+    ecs_ei_memory(world->main_stage.entity_index, 
         &stats->entities_memory.allocd_bytes, 
         &stats->entities_memory.used_bytes);
-    
-    /* Compute entity (entity columns), component and table memory */
-    stats->components_memory = (ecs_memory_stat_t){0};
-    stats->tables_memory = (ecs_memory_stat_t){0};
-    ecs_run(world, StatsCollectTableMemoryTotals, 0, stats);
 
     /* Compute system memory */
     stats->systems_memory = (ecs_memory_stat_t){0};
@@ -393,6 +426,8 @@ void StatsCollectSystemStats(ecs_rows_t *rows) {
         stats[i].period_seconds = system[i].period;
         stats[i].seconds_total = system[i].base.time_spent;
         stats[i].invoke_count_total = system[i].base.invoke_count;
+        stats[i].invoke_seconds = compute_percentiles(
+            &system[i].base.time_histogram);
         stats[i].is_enabled = system[i].base.enabled;
         stats[i].is_active = ecs_vector_count(system[i].tables) != 0;
         stats[i].is_hidden = ecs_has(rows->world, entity, EcsHidden);
@@ -513,30 +548,27 @@ void StatsCollectComponentStats(ecs_rows_t *rows) {
         stats[i].entities_count = 0;
         stats[i].memory = (ecs_memory_stat_t){0};
 
-        /* Walk tables to collect memory and entity stats per component */
-        ecs_chunked_t *tables = rows->world->main_stage.tables;
-        uint32_t t, count = ecs_chunked_count(rows->world->main_stage.tables);
+        /* Only walk the tables that have the component */
+        ecs_vector_t *tables = NULL;
+        ecs_map_has(rows->world->component_tables, entity, &tables);
+
+        ecs_table_t **buffer = ecs_vector_first(tables);
+        uint32_t t, count = ecs_vector_count(tables);
 
         for (t = 0; t < count; t ++) {
-            ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, t);
-            ecs_entity_t *components = ecs_vector_first(table->type);
-            uint32_t c, c_count = ecs_vector_count(table->type);
-
-            /* Iterate over table columns until component is found */
-            for (c = 0; c < c_count; c ++) {
-                if (components[c] == entity) {
-                    ecs_vector_t *column = table->columns[c].data;
-                    stats[i].tables_count ++;
-                    stats[i].entities_count += ecs_vector_count(column);
-                    ecs_vector_params_t param = {
-                        .element_size = stats[i].size_bytes
-                    };
-                    ecs_vector_memory(column, &param, 
-                        &stats[i].memory.allocd_bytes, 
-                        &stats[i].memory.used_bytes);
-                    break;
-                }
-            }
+            ecs_table_t *table = buffer[t];
+            int16_t c = ecs_type_index_of(table->type, entity);
+            ecs_assert(c != -1, ECS_INTERNAL_ERROR, NULL);
+
+            ecs_vector_t *column = table->columns[c + 1].data;
+            stats[i].tables_count ++;
+            stats[i].entities_count += ecs_vector_count(table->columns[0].data);
+            ecs_vector_params_t param = {
+                .element_size = stats[i].size_bytes
+            };
+            ecs_vector_memory(column, &param, 
+                &stats[i].memory.allocd_bytes, 
+                &stats[i].memory.used_bytes);
         }
     }
 }
@@ -571,37 +603,6 @@ void StatsCollectTableStats_StatusAction(
     }
 }
 
-static
-void collect_table_data_memory(
-    ecs_table_t *table,
-    EcsTableStats *stats)
-{
-    uint32_t i, count = ecs_vector_count(table->type);
-    ecs_table_column_t *columns = table->columns;
-
-    ecs_vector_params_t params = {
-        .element_size = sizeof(ecs_entity_t)
-    };
-
-    stats->entity_memory = (ecs_memory_stat_t){0};
-
-    ecs_vector_memory(columns[0].data, &params, 
-        &stats->entity_memory.allocd_bytes, 
-        &stats->entity_memory.used_bytes);
-
-    stats->component_memory = (ecs_memory_stat_t){0};
-
-    for (i = 1; i <= count; i ++) {
-        ecs_vector_params_t params = {
-            .element_size = columns[i].size
-        };
-
-        ecs_vector_memory(columns[i].data, &params, 
-            &stats->component_memory.allocd_bytes, 
-            &stats->component_memory.used_bytes);
-    }
-}
-
 static
 void StatsCollectTableStats(ecs_rows_t *rows) {
     ECS_COLUMN(rows, EcsTablePtr, table_ptr, 1);
@@ -616,11 +617,12 @@ void StatsCollectTableStats(ecs_rows_t *rows) {
         stats[i].columns_count = ecs_vector_count(type);
         stats[i].rows_count = ecs_vector_count(columns[0].data);
         stats[i].systems_matched_count = ecs_vector_count(table->frame_systems);
+        stats[i].system_seconds_total = table->time_spent;
         stats[i].other_memory_bytes = 
             sizeof(ecs_table_column_t) + ecs_vector_count(type) +
             sizeof(ecs_entity_t) * ecs_vector_count(table->frame_systems);
-
-        collect_table_data_memory(table, &stats[i]);
+        stats[i].entity_memory = table->entity_memory;
+        stats[i].component_memory = table->component_memory;
     }
 }
 
@@ -702,6 +704,7 @@ void FlecsStatsImport(
 
     ECS_COMPONENT(world, EcsAllocStats);
     ECS_COMPONENT(world, EcsWorldStats);
+    ECS_COMPONENT(world, EcsThreadStats);
     ECS_COMPONENT(world, EcsMemoryStats);
     ECS_COMPONENT(world, EcsSystemStats);
     ECS_COMPONENT(world, EcsColSystemMemoryStats);
@@ -720,16 +723,14 @@ void FlecsStatsImport(
         [out] EcsWorld.EcsMemoryStats,
         SYSTEM.EcsOnDemand, SYSTEM.EcsHidden);
 
-    ECS_SYSTEM(world, StatsCollectTableMemoryTotals, EcsManual, 
-        [in] EcsTableStats,
-        [out] EcsWorld.EcsMemoryStats,
-        SYSTEM.EcsOnDemand, SYSTEM.EcsHidden);
-
     /* -- Component creation systems -- */
 
     ECS_SYSTEM(world, StatsAddWorldStats, EcsOnStore, [out] !EcsWorld.EcsWorldStats, 
         SYSTEM.EcsOnDemand, SYSTEM.EcsHidden);
 
+    ECS_SYSTEM(world, StatsAddThreadStats, EcsOnStore, [out] !EcsWorld.EcsThreadStats, 
+        SYSTEM.EcsOnDemand, SYSTEM.EcsHidden);
+
     ECS_SYSTEM(world, StatsAddAllocStats, EcsOnStore, [out] !EcsWorld.EcsAllocStats, 
         SYSTEM.EcsOnDemand, SYSTEM.EcsHidden);
 
@@ -772,6 +773,14 @@ void FlecsStatsImport(
     ecs_set_system_status_action(
         world, StatsCollectWorldStats, StatsCollectWorldStats_StatusAction, NULL);
 
+    ECS_SYSTEM(world, StatsCollectThreadStats, EcsPostLoad,
+        [out] EcsThreadStats,
+        SYSTEM.EcsOnDemand, SYSTEM.EcsHidden);
+
+    /* Job and merge times are measured together with the frame time */
+    ecs_set_system_status_action(
+        world, StatsCollectThreadStats, StatsCollectWorldStats_StatusAction, NULL);
+
     ECS_SYSTEM(world, StatsCollectAllocStats, EcsPostLoad,
         [out] EcsAllocStats, 
         SYSTEM.EcsOnDemand, SYSTEM.EcsHidden);
@@ -779,7 +788,6 @@ void FlecsStatsImport(
     ECS_SYSTEM(world, StatsCollectMemoryStats, EcsPostLoad,
         [out] EcsMemoryStats,
         .StatsCollectColSystemMemoryTotals,
-        .StatsCollectTableMemoryTotals,
         SYSTEM.EcsOnDemand, SYSTEM.EcsHidden);      
 
     ECS_SYSTEM(world, StatsCollectSystemStats, EcsPostLoad,
@@ -818,6 +826,7 @@ void FlecsStatsImport(
     /* Export components to module */
     ECS_EXPORT_COMPONENT(EcsAllocStats);
     ECS_EXPORT_COMPONENT(EcsWorldStats);
+    ECS_EXPORT_COMPONENT(EcsThreadStats);
     ECS_EXPORT_COMPONENT(EcsMemoryStats);
     ECS_EXPORT_COMPONENT(EcsSystemStats);
     ECS_EXPORT_COMPONENT(EcsColSystemMemoryStats);
@@ -97,10 +97,7 @@ ecs_entity_t new_row_system(
 
     ecs_entity_t result = _ecs_new(world, world->t_row_system);
 
-    EcsId *id_data = ecs_get_ptr(world, result, EcsId);
-    ecs_assert(id_data != NULL, ECS_INTERNAL_ERROR, NULL);
-
-    *id_data = id;
+    ecs_set(world, result, EcsId, {id});
 
     EcsRowSystem *system_data = ecs_get_ptr(world, result, EcsRowSystem);
     memset(system_data, 0, sizeof(EcsRowSystem));
@@ -131,6 +128,12 @@ ecs_entity_t new_row_system(
             type_id = ecs_type_add_intern(
                 world, NULL, type_id, column->is.component);
         }
+
+        /* Cached references to the system must be resolved again when
+         * components are added to or removed from the system */
+        if (column->kind == EcsFromSystem) {
+            ecs_set_watch(world, &world->main_stage, result);
+        }
     }
 
     ecs_system_compute_and_families(world, &system_data->base);
@@ -344,6 +347,31 @@ void ecs_invoke_status_action(
     }
 }
 
+void ecs_system_detach_columns(
+    ecs_world_t *world,
+    EcsSystem *system_data,
+    ecs_table_t *table,
+    ecs_table_column_t *table_columns,
+    int32_t *columns,
+    uint64_t tick)
+{
+    ecs_system_column_t *buffer = ecs_vector_first(system_data->columns);
+    uint32_t i, count = ecs_vector_count(system_data->columns);
+    bool is_written = false;
+
+    for (i = 0; i < count; i ++) {
+        if (columns[i] > 0 && buffer[i].inout_kind != EcsIn) {
+            ecs_table_detach_column(world, &table_columns[columns[i]]);
+            table_columns[columns[i]].changed = tick;
+            is_written = true;
+        }
+    }
+
+    if (is_written) {
+        ecs_table_bump_version(world, table);
+    }
+}
+
 void ecs_system_init_base(
     ecs_world_t *world,
     EcsSystem *base_data)
@@ -532,43 +560,26 @@ error:
     return -1;
 }
 
-/** Run system on a single row */
-ecs_type_t ecs_notify_row_system(
+/** Resolve the columns of a row system for a table */
+static
+void resolve_row_system_table(
     ecs_world_t *world,
+    ecs_world_t *real_world,
     ecs_entity_t system,
+    EcsRowSystem *system_data,
     ecs_type_t type,
     ecs_table_t *table,
-    ecs_table_column_t *table_columns,
-    uint32_t offset,
-    uint32_t limit)
+    ecs_row_system_table_t *result)
 {
-    ecs_entity_info_t info = {.entity = system};
-    ecs_world_t *real_world = world;
-    ecs_get_stage(&real_world);
-
-    EcsRowSystem *system_data = ecs_get_ptr_intern(
-        real_world, &real_world->main_stage, &info, EEcsRowSystem, false, true);
-    
-    assert(system_data != NULL);
-
-    if (!system_data->base.enabled) {
-        return false;
-    }
-
-    if (table && table->flags & EcsTableIsPrefab && 
-        !system_data->base.match_prefab) 
-    {
-        return 0;
-    }
-
-    ecs_system_action_t action = system_data->base.action;
-
     uint32_t i, column_count = ecs_vector_count(system_data->base.columns);
     ecs_system_column_t *buffer = ecs_vector_first(system_data->base.columns);
-    int32_t *columns = ecs_os_alloca(int32_t, column_count);
-    ecs_reference_t *references = ecs_os_alloca(ecs_reference_t, column_count);
+    int32_t *columns = result->columns;
+    ecs_reference_t *references = result->references;
+    int32_t ref_id = 0;
 
-    uint32_t ref_id = 0;
+    result->has_refs = false;
+    result->matched = false;
+    result->ref_version = real_world->ref_version;
 
     /* Iterate over system columns, resolve data from table or references */
 
@@ -585,7 +596,7 @@ ecs_type_t ecs_notify_row_system(
 
             /* If entity owns component but column is shared, no match */
             if (columns[i] && buffer[i].kind == EcsFromShared) {
-                return 0;
+                goto done;
             }
 
             if (!columns[i] && table) {
@@ -593,9 +604,12 @@ ecs_type_t ecs_notify_row_system(
                  * components of components, but only if column was not OWNED */
                 if (buffer[i].kind == EcsFromOwned) {
                     /* System doesn't match */
-                    return 0;
+                    goto done;
                 }
 
+                /* The base can change when components are added to it */
+                result->has_refs = true;
+
                 entity = ecs_get_entity_for_component(
                     real_world, 0, table->type, buffer[i].is.component);
 
@@ -624,20 +638,128 @@ ecs_type_t ecs_notify_row_system(
             }
 
             /* Store the reference data so the system callback can access it */
-            info = (ecs_entity_info_t){.entity = entity};
             references[ref_id] = (ecs_reference_t){
                 .entity = entity, 
                 .component = component,
-                .cached_ptr = ecs_get_ptr_intern(real_world, &real_world->main_stage, 
-                                &info, component, false, true)
+                .cached_ptr = ecs_get_ref_ptr(real_world, entity, component)
             };
 
             /* Update the column vector with the entry to the ref vector */
             ref_id ++;
             columns[i] = -ref_id;
+            result->has_refs = true;
+        }
+    }
+
+    result->matched = true;
+done:
+    result->ref_count = ref_id;
+}
+
+/** Get the resolved columns of a row system for a table. Columns are resolved
+ * when the system is first invoked for a table, and are cached in the system.
+ * While worker threads are running the cache is not modified, and columns that
+ * are not cached are resolved in the provided buffer. */
+static
+ecs_row_system_table_t* get_row_system_table(
+    ecs_world_t *world,
+    ecs_world_t *real_world,
+    ecs_entity_t system,
+    EcsRowSystem *system_data,
+    ecs_type_t type,
+    ecs_table_t *table,
+    ecs_row_system_table_t *buffer)
+{
+    ecs_row_system_table_t *result = NULL;
+    bool read_only = real_world->in_progress && real_world->worker_threads;
+
+    if (table && system_data->tables) {
+        result = ecs_map_get_ptr(system_data->tables, (uintptr_t)type);
+    }
+
+    if (result) {
+        if (!result->has_refs || result->ref_version == real_world->ref_version) {
+            return result;
+        }
+
+        /* Referenced entities may have changed, resolve columns again */
+        if (!read_only) {
+            resolve_row_system_table(
+                world, real_world, system, system_data, type, table, result);
+            return result;
         }
     }
 
+    if (table && !read_only) {
+        uint32_t column_count = ecs_vector_count(system_data->base.columns);
+        ecs_row_system_table_t entry = {0};
+        entry.columns = ecs_os_malloc(sizeof(int32_t) * column_count);
+        entry.references = ecs_os_malloc(
+            sizeof(ecs_reference_t) * column_count);
+
+        if (!system_data->tables) {
+            system_data->tables = ecs_map_new(0, sizeof(ecs_row_system_table_t));
+        }
+
+        result = ecs_map_set(system_data->tables, (uintptr_t)type, &entry);
+    } else {
+        result = buffer;
+    }
+
+    resolve_row_system_table(
+        world, real_world, system, system_data, type, table, result);
+
+    return result;
+}
+
+/** Run system on a single row */
+ecs_type_t ecs_notify_row_system(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    ecs_type_t type,
+    ecs_table_t *table,
+    ecs_table_column_t *table_columns,
+    uint32_t offset,
+    uint32_t limit)
+{
+    ecs_entity_info_t info = {.entity = system};
+    ecs_world_t *real_world = world;
+    ecs_get_stage(&real_world);
+
+    EcsRowSystem *system_data = ecs_get_ptr_intern(
+        real_world, &real_world->main_stage, &info, EEcsRowSystem, false, true);
+    
+    assert(system_data != NULL);
+
+    if (!system_data->base.enabled) {
+        return false;
+    }
+
+    if (table && table->flags & EcsTableIsPrefab && 
+        !system_data->base.match_prefab) 
+    {
+        return 0;
+    }
+
+    ecs_system_action_t action = system_data->base.action;
+
+    uint32_t column_count = ecs_vector_count(system_data->base.columns);
+    ecs_row_system_table_t buffer = {
+        .columns = ecs_os_alloca(int32_t, column_count),
+        .references = ecs_os_alloca(ecs_reference_t, column_count)
+    };
+
+    ecs_row_system_table_t *resolved = get_row_system_table(
+        world, real_world, system, system_data, type, table, &buffer);
+
+    if (!resolved->matched) {
+        return 0;
+    }
+
+    /* The cached entry may move if the action causes the system to cache the
+     * columns of another table, but the arrays it points to do not */
+    int32_t *columns = resolved->columns;
+
     /* Prepare ecs_rows_t for system callback */
     ecs_rows_t rows = {
         .world = world,
@@ -655,12 +777,15 @@ ecs_type_t ecs_notify_row_system(
     };
 
     /* Set references metadata if system has references */
-    if (ref_id) {
-        rows.references = references;
+    if (resolved->ref_count) {
+        rows.references = resolved->references;
     }
 
     /* Obtain pointer to vector with entity identifiers */
     if (table_columns) {
+        ecs_system_detach_columns(real_world, &system_data->base, table, 
+            table_columns, columns, real_world->change_tick);
+
         ecs_entity_t *entities = ecs_vector_first(table_columns[0].data);
         rows.entities = &entities[rows.offset];
     }
@@ -1040,6 +1165,18 @@ void ecs_set_period(
     }
 }
 
+void ecs_set_changed_only(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    bool changed_only)
+{
+    assert(world->magic == ECS_WORLD_MAGIC);
+    EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
+    if (system_data) {
+        system_data->changed_only = changed_only;
+    }
+}
+
 static
 void* get_owned_column_ptr(
     const ecs_rows_t *rows,
@@ -1235,6 +1372,24 @@ void* ecs_table_column(
     uint32_t column)
 {
     ecs_table_t *table = rows->table;
+    ecs_world_t *world = rows->world;
+    ecs_get_stage(&world);
+
+    /* Columns that are matched by the system have already been detached if
+     * the system writes them. Other columns can be modified through the
+     * returned pointer, so they must not be shared with a snapshot. */
+    uint32_t i;
+    for (i = 0; i < rows->column_count; i ++) {
+        if (rows->columns[i] == (int32_t)column + 1) {
+            break;
+        }
+    }
+
+    if (i == rows->column_count) {
+        ecs_table_detach_column(world, &table->columns[column + 1]);
+        ecs_table_bump_version(world, table);
+    }
+
     return ecs_vector_first(table->columns[column + 1].data);
 }
 
@@ -20,7 +20,63 @@ void activate_table(
                 ecs_system_activate_table(world, buffer[i], table, activate);
             }
         }
+
+        /* Queries only move tables that become empty out of the iterated
+         * range when they are iterated, see ecs_query_next */
+        ecs_vector_t *queries = table->queries;
+        if (activate && queries) {
+            ecs_query_t **buffer = ecs_vector_first(queries);
+            uint32_t i, count = ecs_vector_count(queries);
+            for (i = 0; i < count; i ++) {
+                ecs_query_activate_table(buffer[i], table);
+            }
+        }
+    }
+}
+
+/** Moving the storage of a table invalidates the pointers that systems cached
+ * to components of entities in the table. Tables without such entities can
+ * move their storage without requiring references to be resolved again. */
+static
+void invalidate_refs(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    if (table->flags & EcsTableIsReferenced) {
+        world->should_resolve = true;
+        world->ref_version ++;
+    }
+}
+
+/** Update the memory totals after count rows were added to (or removed from,
+ * if negative) the columns of a table. Only the columns of main stage tables
+ * are counted. Rows only change the memory in use by a fixed amount, unless a
+ * column was resized, in which case the columns of the table are walked. */
+static
+void update_memory(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_table_column_t *columns,
+    int32_t count,
+    bool resized)
+{
+    if (columns != table->columns || !(table->flags & EcsTableIsMainStage)) {
+        return;
     }
+
+    if (resized) {
+        ecs_table_update_memory(world, table);
+        return;
+    }
+
+    /* Counters are unsigned, adding a negative value wraps around */
+    uint64_t entity_bytes = (int64_t)count * (int64_t)sizeof(ecs_entity_t);
+    uint64_t component_bytes = (int64_t)count * table->row_size;
+
+    table->entity_memory.used_bytes += entity_bytes;
+    table->component_memory.used_bytes += component_bytes;
+    world->entity_memory.used_bytes += entity_bytes;
+    world->component_memory.used_bytes += component_bytes;
 }
 
 static
@@ -51,6 +107,7 @@ ecs_table_column_t* new_columns(
             if (component->size) {
                 /* Regular column data */
                 result[i + 1].size = component->size;
+                result[i + 1].alignment = component->alignment;
             }
         }
 
@@ -66,8 +123,101 @@ ecs_table_column_t* new_columns(
     return result;
 }
 
+/** Find or create the edge for a component in the table */
+static
+ecs_table_edge_t* get_edge(
+    ecs_table_t *table,
+    ecs_entity_t component)
+{
+    if (component < ECS_TABLE_LO_EDGE_COUNT) {
+        if (!table->lo_edges) {
+            table->lo_edges = ecs_os_calloc(
+                sizeof(ecs_table_edge_t), ECS_TABLE_LO_EDGE_COUNT);
+            ecs_assert(table->lo_edges != NULL, ECS_OUT_OF_MEMORY, NULL);
+        }
+
+        return &table->lo_edges[component];
+    } else {
+        if (!table->hi_edges) {
+            table->hi_edges = ecs_map_new(0, sizeof(ecs_table_edge_t));
+        }
+
+        ecs_table_edge_t *edge = ecs_map_get_ptr(table->hi_edges, component);
+        if (!edge) {
+            edge = ecs_map_set(
+                table->hi_edges, component, &((ecs_table_edge_t){0}));
+        }
+
+        return edge;
+    }
+}
+
+/** Get component from a type that contains a single component */
+static
+ecs_entity_t single_component(
+    ecs_type_t type)
+{
+    ecs_assert(ecs_vector_count(type) == 1, ECS_INTERNAL_ERROR, NULL);
+    return *(ecs_entity_t*)ecs_vector_first(type);
+}
+
 /* -- Private functions -- */
 
+/* Edges are only used for tables in the main stage, outside of progress. The
+ * first transition still merges the types and looks up the table, subsequent
+ * transitions only follow the cached pointer. Transitions that would result in
+ * an empty entity are not cached, as a NULL edge means "not yet resolved". */
+
+ecs_table_t* ecs_table_traverse_add(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_table_t *table,
+    ecs_type_t to_add)
+{
+    ecs_assert(!world->in_progress, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_table_edge_t *edge = get_edge(table, single_component(to_add));
+    ecs_table_t *result = edge->add;
+
+    if (!result) {
+        ecs_type_t type = ecs_type_merge_intern(
+            world, stage, table->type, to_add, NULL);
+        ecs_assert(type != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        result = ecs_world_get_table(world, stage, type);
+
+        /* Creating a table can run code that adds edges to this table, which
+         * may move edges in the hi_edges map. Don't reuse the edge pointer. */
+        get_edge(table, single_component(to_add))->add = result;
+    }
+
+    return result;
+}
+
+ecs_table_t* ecs_table_traverse_remove(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_table_t *table,
+    ecs_type_t to_remove)
+{
+    ecs_assert(!world->in_progress, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_table_edge_t *edge = get_edge(table, single_component(to_remove));
+    ecs_table_t *result = edge->remove;
+
+    if (!result) {
+        ecs_type_t type = ecs_type_merge_intern(
+            world, stage, table->type, NULL, to_remove);
+
+        if (type) {
+            result = ecs_world_get_table(world, stage, type);
+            get_edge(table, single_component(to_remove))->remove = result;
+        }
+    }
+
+    return result;
+}
+
 ecs_table_column_t* ecs_table_get_columns(
     ecs_world_t *world,
     ecs_stage_t *stage,
@@ -89,14 +239,168 @@ ecs_table_column_t* ecs_table_get_columns(
     }
 }
 
+void ecs_table_detach_column(
+    ecs_world_t *world,
+    ecs_table_column_t *column)
+{
+    if (!ecs_vector_is_shared(column->data)) {
+        return;
+    }
+
+    /* Worker threads can detach the same column while in progress */
+    bool lock = world->in_progress && world->worker_threads;
+    if (lock) {
+        ecs_os_mutex_lock(world->thread_mutex);
+    }
+
+    if (ecs_vector_is_shared(column->data)) {
+        ecs_vector_params_t params = {
+            .element_size = column->size, .alignment = column->alignment};
+        ecs_vector_t *data = ecs_vector_copy(column->data, &params);
+        ecs_vector_free(column->data);
+        column->data = data;
+
+        /* Systems may have cached pointers to the shared data */
+        world->should_resolve = true;
+        world->ref_version ++;
+    }
+
+    if (lock) {
+        ecs_os_mutex_unlock(world->thread_mutex);
+    }
+}
+
+void ecs_table_bump_version(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    /* Worker threads can write the same table while in progress */
+    if (world->in_progress && world->worker_threads) {
+        ecs_os_ainc((int32_t*)&table->version);
+    } else {
+        table->version ++;
+    }
+}
+
+void ecs_table_detach(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_table_column_t *columns)
+{
+    uint32_t i, column_count = ecs_vector_count(table->type);
+    uint64_t tick = world->change_tick;
+
+    for (i = 0; i < column_count + 1; i ++) {
+        ecs_table_detach_column(world, &columns[i]);
+        columns[i].changed = tick;
+    }
+
+    table->version ++;
+}
+
 void ecs_table_init(
     ecs_world_t *world,
     ecs_stage_t *stage,
     ecs_table_t *table)
 {
     table->frame_systems = NULL;
+    table->queries = NULL;
     table->flags = 0;
+    table->lo_edges = NULL;
+    table->hi_edges = NULL;
+    table->version = 0;
+    table->time_spent = 0;
+    table->depth = -1;
+    table->entity_memory = (ecs_memory_stat_t){0};
+    table->component_memory = (ecs_memory_stat_t){0};
     table->columns = new_columns(world, stage, table, table->type);
+
+    if (stage == &world->main_stage) {
+        table->flags |= EcsTableIsMainStage;
+    }
+
+    uint32_t i, count = ecs_vector_count(table->type);
+    table->row_size = 0;
+    for (i = 1; i <= count; i ++) {
+        table->row_size += table->columns[i].size;
+    }
+}
+
+int32_t ecs_table_depth(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    if (table->depth >= 0) {
+        return table->depth;
+    }
+
+    ecs_stage_t *stage = &world->main_stage;
+    int32_t result = 0;
+
+    ecs_entity_t *array = ecs_vector_first(table->type);
+    int32_t i, count = ecs_vector_count(table->type);
+
+    /* The depth of a table is one more than the deepest table that stores one
+     * of its parents. Parents are stored at the end of the type. */
+    for (i = count - 1; i >= 0; i --) {
+        ecs_entity_t e = array[i];
+
+        if (e & ECS_CHILDOF) {
+            int32_t depth = 1;
+
+            ecs_row_t *row = ecs_ei_get(
+                stage->entity_index, e & ECS_ENTITY_MASK);
+
+            if (row && row->type) {
+                ecs_table_t *parent_table = ecs_world_get_table(
+                    world, stage, row->type);
+                depth += ecs_table_depth(world, parent_table);
+            }
+
+            if (depth > result) {
+                result = depth;
+            }
+        } else if (!(e & ECS_ENTITY_FLAGS_MASK)) {
+            /* No more parents after this */
+            break;
+        }
+    }
+
+    table->depth = result;
+
+    return result;
+}
+
+void ecs_table_invalidate_depth(
+    ecs_world_t *world,
+    ecs_entity_t parent)
+{
+    ecs_vector_t *tables = NULL;
+    if (!ecs_map_has(world->component_tables, parent | ECS_CHILDOF, &tables)) {
+        return;
+    }
+
+    ecs_table_t **buffer = ecs_vector_first(tables);
+    uint32_t i, count = ecs_vector_count(tables);
+
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = buffer[i];
+
+        /* A depth is only computed after the depths of the parent tables are
+         * computed, so if a table has no depth, its children have none either */
+        if (table->depth < 0) {
+            continue;
+        }
+
+        table->depth = -1;
+
+        ecs_entity_t *entities = ecs_vector_first(table->columns[0].data);
+        uint32_t e, e_count = ecs_vector_count(table->columns[0].data);
+
+        for (e = 0; e < e_count; e ++) {
+            ecs_table_invalidate_depth(world, entities[e]);
+        }
+    }
 }
 
 void ecs_table_deinit(
@@ -133,6 +437,10 @@ void ecs_table_clear(
     uint32_t count = ecs_vector_count(table->columns[0].data);
     
     clear_columns(table);
+    table->version ++;
+    world->ref_version ++;
+
+    ecs_table_update_memory(world, table);
 
     if (count) {
         activate_table(world, table, 0, false);
@@ -157,11 +465,21 @@ void ecs_table_replace_columns(
         table->columns = columns;
     }
 
+    table->version ++;
+    world->ref_version ++;
+
     uint32_t count = 0;
     if (table->columns) {
+        uint32_t i, column_count = ecs_vector_count(table->type);
+        for (i = 0; i < column_count + 1; i ++) {
+            table->columns[i].changed = world->change_tick;
+        }
+
         count = ecs_vector_count(table->columns[0].data);
     }
 
+    ecs_table_update_memory(world, table);
+
     if (!prev_count && count) {
         activate_table(world, table, 0, true);
     } else if (prev_count && !count) {
@@ -169,6 +487,57 @@ void ecs_table_replace_columns(
     }
 }
 
+void ecs_table_unregister_entities(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    ecs_vector_t *entity_vector = table->columns[0].data;
+    ecs_entity_t *entities = ecs_vector_first(entity_vector);
+    int32_t i, count = ecs_vector_count(entity_vector);
+    for (i = 0; i < count; i ++) {
+        ecs_ei_remove(world->main_stage.entity_index, entities[i]);
+    }
+}
+
+void ecs_table_register_entities(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    ecs_vector_t *entity_vector = table->columns[0].data;
+    ecs_entity_t *entities = ecs_vector_first(entity_vector);
+    int32_t i, count = ecs_vector_count(entity_vector);
+
+    for (i = 0; i < count; i ++) {
+        ecs_row_t row, *row_ptr = ecs_ei_get(
+            world->main_stage.entity_index, entities[i]);
+
+        /* If the entity is stored in another table, delete it from there */
+        if (row_ptr) {
+            row = *row_ptr;
+            if (row.type != table->type) {
+                ecs_table_t *old_table = ecs_world_get_table(
+                    world, &world->main_stage, row.type);
+                ecs_assert(old_table != NULL, ECS_INTERNAL_ERROR, NULL);
+
+                ecs_table_delete(world, &world->main_stage, 
+                    old_table, old_table->columns, row.index);
+            }
+        }
+
+        row = (ecs_row_t){
+            .index = i + 1,
+            .type = table->type
+        };
+
+        ecs_ei_set(world->main_stage.entity_index, entities[i], &row);
+
+        ecs_entity_t index = entities[i] & ECS_ENTITY_INDEX_MASK;
+        if (index >= world->last_handle) {
+            world->last_handle = index + 1;
+        }
+    }
+}
+
 /* Delete all entities in table, invoke OnRemove handlers. This function is used
  * when an application invokes delete_w_filter. Use ecs_table_clear, as the
  * table may have to be deactivated with systems. */
@@ -186,10 +555,16 @@ void ecs_table_free(
     ecs_world_t *world,
     ecs_table_t *table)
 {
-    (void)world;
     clear_columns(table);
+    ecs_table_update_memory(world, table);
     ecs_os_free(table->columns);
     ecs_vector_free(table->frame_systems);
+    ecs_vector_free(table->queries);
+    ecs_os_free(table->lo_edges);
+
+    if (table->hi_edges) {
+        ecs_map_free(table->hi_edges);
+    }
 }
 
 void ecs_table_register_system(
@@ -214,7 +589,10 @@ uint32_t ecs_table_insert(
 {
     uint32_t column_count = ecs_vector_count(table->type);
 
+    ecs_table_detach(world, table, columns);
+
     /* Fist add entity to column with entity ids */
+    uint32_t old_size = ecs_vector_size(columns[0].data);
     ecs_entity_t *e = ecs_vector_add(&columns[0].data, &handle_arr_params);
     ecs_assert(e != NULL, ECS_INTERNAL_ERROR, NULL);
 
@@ -223,18 +601,26 @@ uint32_t ecs_table_insert(
     /* Add elements to each column array */
     uint32_t i;
     bool reallocd = false;
+    bool resized = old_size != ecs_vector_size(columns[0].data);
 
     for (i = 1; i < column_count + 1; i ++) {
         uint32_t size = columns[i].size;
         if (size) {
-            ecs_vector_params_t params = {.element_size = size};
+            ecs_vector_params_t params = {
+                .element_size = size, .alignment = columns[i].alignment};
             void *old_vector = columns[i].data;
+            old_size = ecs_vector_size(old_vector);
 
             ecs_vector_add(&columns[i].data, &params);
             
             if (old_vector != columns[i].data) {
                 reallocd = true;
             }
+
+            /* Vectors can grow without moving */
+            if (old_size != ecs_vector_size(columns[i].data)) {
+                resized = true;
+            }
         }
     }
 
@@ -245,9 +631,11 @@ uint32_t ecs_table_insert(
     }
 
     if (reallocd && table->columns == columns) {
-        world->should_resolve = true;
+        invalidate_refs(world, table);
     }
 
+    update_memory(world, table, columns, 1, resized);
+
     /* Return index of last added entity */
     return index + 1;
 }
@@ -266,6 +654,13 @@ void ecs_table_delete(
         columns = table->columns;
     }
 
+    ecs_table_detach(world, table, columns);
+
+    /* Referenced entities may be moved or deleted */
+    if (table->columns == columns) {
+        invalidate_refs(world, table);
+    }
+
     ecs_vector_t *entity_column = columns[0].data;
     uint32_t index, count = ecs_vector_count(entity_column);
 
@@ -303,7 +698,7 @@ void ecs_table_delete(
         ecs_row_t row;
         row.type = table->type;
         row.index = index + 1;
-        ecs_map_set(stage->entity_index, to_move, &row);
+        ecs_ei_set(stage->entity_index, to_move, &row);
 
         /* Decrease size of entity column */
         ecs_vector_remove_last(entity_column);
@@ -319,6 +714,8 @@ void ecs_table_delete(
         }
     }
     
+    update_memory(world, table, columns, -1, false);
+
     if (!world->in_progress && !count) {
         activate_table(world, table, 0, false);
     }
@@ -333,7 +730,10 @@ uint32_t ecs_table_grow(
 {
     uint32_t column_count = ecs_vector_count(table->type);
 
+    ecs_table_detach(world, table, columns);
+
     /* Fist add entity to column with entity ids */
+    uint32_t old_size = ecs_vector_size(columns[0].data);
     ecs_entity_t *e = ecs_vector_addn(&columns[0].data, &handle_arr_params, count);
     ecs_assert(e != NULL, ECS_INTERNAL_ERROR, NULL);
 
@@ -343,20 +743,28 @@ uint32_t ecs_table_grow(
     }
 
     bool reallocd = false;
+    bool resized = old_size != ecs_vector_size(columns[0].data);
 
     /* Add elements to each column array */
     for (i = 1; i < column_count + 1; i ++) {
-        ecs_vector_params_t params = {.element_size = columns[i].size};
+        ecs_vector_params_t params = {
+            .element_size = columns[i].size, 
+            .alignment = columns[i].alignment};
         if (!params.element_size) {
             continue;
         }
         void *old_vector = columns[i].data;
+        old_size = ecs_vector_size(old_vector);
 
         ecs_vector_addn(&columns[i].data, &params, count);
 
         if (old_vector != columns[i].data) {
             reallocd = true;
         }
+
+        if (old_size != ecs_vector_size(columns[i].data)) {
+            resized = true;
+        }
     }
 
     uint32_t row_count = ecs_vector_count(columns[0].data);
@@ -365,14 +773,17 @@ uint32_t ecs_table_grow(
     }
 
     if (reallocd && table->columns == columns) {
-        world->should_resolve = true;
+        invalidate_refs(world, table);
     }
 
+    update_memory(world, table, columns, count, resized);
+
     /* Return index of first added entity */
     return row_count - count + 1;
 }
 
 int16_t ecs_table_dim(
+    ecs_world_t *world,
     ecs_table_t *table,
     ecs_table_column_t *columns,
     uint32_t count)
@@ -383,6 +794,8 @@ int16_t ecs_table_dim(
 
     uint32_t column_count = ecs_vector_count(table->type);
 
+    ecs_table_detach(world, table, columns);
+
     uint32_t size = ecs_vector_set_size(
         &columns[0].data, &handle_arr_params, count);
     ecs_assert(size != 0, ECS_INTERNAL_ERROR, NULL);
@@ -393,7 +806,9 @@ int16_t ecs_table_dim(
         uint32_t column_size = columns[i].size;
 
         if (column_size) {
-            ecs_vector_params_t params = {.element_size = column_size};
+            ecs_vector_params_t params = {
+                .element_size = column_size, 
+                .alignment = columns[i].alignment};
             uint32_t size = ecs_vector_set_size(&columns[i].data, &params, count);
             ecs_assert(size != 0, ECS_INTERNAL_ERROR, NULL);
             (void)size;
@@ -402,6 +817,8 @@ int16_t ecs_table_dim(
         }
     }
 
+    update_memory(world, table, columns, 0, true);
+
     return 0;
 }
 
@@ -415,7 +832,47 @@ uint64_t ecs_table_count(
     return ecs_vector_count(table->columns[0].data);
 }
 
+void ecs_table_update_memory(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    if (!(table->flags & EcsTableIsMainStage)) {
+        return;
+    }
+
+    ecs_memory_stat_t entity_memory = {0};
+    ecs_memory_stat_t component_memory = {0};
+    ecs_table_column_t *columns = table->columns;
+
+    if (columns) {
+        ecs_vector_memory(columns[0].data, &handle_arr_params, 
+            &entity_memory.allocd_bytes, &entity_memory.used_bytes);
+
+        uint32_t i, count = ecs_vector_count(table->type);
+        for (i = 1; i <= count; i ++) {
+            ecs_vector_params_t params = {.element_size = columns[i].size};
+            ecs_vector_memory(columns[i].data, &params, 
+                &component_memory.allocd_bytes, 
+                &component_memory.used_bytes);
+        }
+    }
+
+    /* Apply the difference with the previous values to the world totals */
+    world->entity_memory.allocd_bytes += 
+        entity_memory.allocd_bytes - table->entity_memory.allocd_bytes;
+    world->entity_memory.used_bytes += 
+        entity_memory.used_bytes - table->entity_memory.used_bytes;
+    world->component_memory.allocd_bytes += 
+        component_memory.allocd_bytes - table->component_memory.allocd_bytes;
+    world->component_memory.used_bytes += 
+        component_memory.used_bytes - table->component_memory.used_bytes;
+
+    table->entity_memory = entity_memory;
+    table->component_memory = component_memory;
+}
+
 void ecs_table_swap(
+    ecs_world_t *world,
     ecs_stage_t *stage,
     ecs_table_t *table,
     ecs_table_column_t *columns,
@@ -431,17 +888,23 @@ void ecs_table_swap(
         return;
     }
 
+    ecs_table_detach(world, table, columns);
+
+    if (table->columns == columns) {
+        invalidate_refs(world, table);
+    }
+
     ecs_entity_t *entities = ecs_vector_first(columns[0].data);
     ecs_entity_t e1 = entities[row_1];
     ecs_entity_t e2 = entities[row_2];
     
     /* Get pointers to records in entity index */
     if (!row_ptr_1) {
-        row_ptr_1 = ecs_map_get_ptr(stage->entity_index, e1);
+        row_ptr_1 = ecs_ei_get_mut(stage->entity_index, e1);
     }
 
     if (!row_ptr_2) {
-        row_ptr_2 = ecs_map_get_ptr(stage->entity_index, e2);
+        row_ptr_2 = ecs_ei_get_mut(stage->entity_index, e2);
     }
 
     /* Swap entities */
@@ -471,12 +934,19 @@ void ecs_table_swap(
 }
 
 void ecs_table_move_back_and_swap(
+    ecs_world_t *world,
     ecs_stage_t *stage,
     ecs_table_t *table,
     ecs_table_column_t *columns,
     uint32_t row,
     uint32_t count)
 {
+    ecs_table_detach(world, table, columns);
+
+    if (table->columns == columns) {
+        invalidate_refs(world, table);
+    }
+
     ecs_entity_t *entities = ecs_vector_first(columns[0].data);
     uint32_t i;
 
@@ -486,12 +956,12 @@ void ecs_table_move_back_and_swap(
         ecs_entity_t cur = entities[row + i];
         entities[row + i - 1] = cur;
 
-        ecs_row_t *row_ptr = ecs_map_get_ptr(stage->entity_index, cur);
+        ecs_row_t *row_ptr = ecs_ei_get_mut(stage->entity_index, cur);
         row_ptr->index = row + i;
     }
 
     entities[row + count - 1] = e;
-    ecs_row_t *row_ptr = ecs_map_get_ptr(stage->entity_index, e);
+    ecs_row_t *row_ptr = ecs_ei_get_mut(stage->entity_index, e);
     row_ptr->index = row + count;
 
     /* Move back and swap columns */
@@ -538,6 +1008,14 @@ void ecs_table_merge(
     ecs_table_column_t *old_columns = old_table->columns;
     ecs_assert(old_columns != NULL, ECS_INTERNAL_ERROR, NULL);
 
+    old_table->version ++;
+    if (new_table) {
+        new_table->version ++;
+        invalidate_refs(world, new_table);
+    }
+
+    invalidate_refs(world, old_table);
+
     uint32_t old_count = old_columns->data ? ecs_vector_count(old_columns->data) : 0;
     uint32_t new_count = 0;
     if (new_columns) {
@@ -548,8 +1026,36 @@ void ecs_table_merge(
     ecs_entity_t *old_entities = ecs_vector_first(old_columns[0].data);
     uint32_t i;
     for(i = 0; i < old_count; i ++) {
-        ecs_row_t row = {.type = new_type, .index = i + new_count};
-        ecs_map_set(world->main_stage.entity_index, old_entities[i], &row);
+        ecs_row_t *old_row = ecs_ei_get(
+            world->main_stage.entity_index, old_entities[i]);
+        bool is_watched = old_row && old_row->index < 0;
+
+        int32_t index = i + new_count + 1;
+        ecs_row_t row = {
+            .type = new_type, .index = is_watched ? -index : index};
+        ecs_ei_set(world->main_stage.entity_index, old_entities[i], &row);
+
+        /* Same as when a watched entity is committed to a new table. This
+         * also restores the depth order of CASCADE systems. */
+        if (is_watched) {
+            world->should_match = true;
+            world->should_resolve = true;
+            world->ref_version ++;
+
+            ecs_entity_t *elem = ecs_vector_add(
+                &world->match_entities, &handle_arr_params);
+            *elem = old_entities[i];
+        }
+    }
+
+    /* If entities moved to a table with a different depth, the depth of the
+     * tables with their children is out of date */
+    if (!new_table || old_table->depth < 0 || 
+        old_table->depth != new_table->depth) 
+    {
+        for (i = 0; i < old_count; i ++) {
+            ecs_table_invalidate_depth(world, old_entities[i]);
+        }
     }
 
     if (!new_table) {
@@ -602,10 +1108,13 @@ void ecs_table_merge(
             /* If the new table is not empty, copy the contents from the
              * smallest into the largest vector. */
             } else {
+                ecs_table_detach_column(world, &new_columns[i_new]);
                 ecs_vector_t *dst = new_columns[i_new].data;
                 ecs_vector_t *src = old_columns[i_old].data;
 
-                ecs_vector_params_t params = {.element_size = size};
+                ecs_vector_params_t params = {
+                    .element_size = size, 
+                    .alignment = new_columns[i_new].alignment};
                 ecs_vector_set_count(&dst, &params, new_count + old_count);
                 
                 void *dst_ptr = ecs_vector_first(dst);
@@ -632,4 +1141,17 @@ void ecs_table_merge(
             i_old ++;
         }
     }
+
+    /* All entities moved out of the old table, which makes it inactive. The
+     * new table becomes active if it was empty. */
+    if (!world->in_progress) {
+        if (!new_count) {
+            activate_table(world, new_table, 0, true);
+        }
+
+        activate_table(world, old_table, 0, false);
+    }
+
+    ecs_table_update_memory(world, new_table);
+    ecs_table_update_memory(world, old_table);
 }
@@ -0,0 +1,315 @@
+#include "flecs_private.h"
+
+#define ECS_TRACE_DEFAULT_CAPACITY (65536)
+
+static
+const char *trace_category[] = {
+    [EcsTraceFrame] = "frame",
+    [EcsTracePhase] = "phase",
+    [EcsTraceSystem] = "system",
+    [EcsTraceJob] = "job",
+    [EcsTraceMerge] = "merge"
+};
+
+/* Names of the arguments stored with an event, NULL if unused */
+static
+const char *trace_arg_names[][2] = {
+    [EcsTraceFrame] = {NULL, NULL},
+    [EcsTracePhase] = {"systems", NULL},
+    [EcsTraceSystem] = {"tables", "rows"},
+    [EcsTraceJob] = {"offset", "limit"},
+    [EcsTraceMerge] = {"stage", NULL}
+};
+
+static
+uint32_t next_pow_of_2(
+    uint32_t n)
+{
+    uint32_t result = 1;
+    while (result < n) {
+        result *= 2;
+    }
+    return result;
+}
+
+void ecs_trace_buffer_init(
+    ecs_world_t *world,
+    ecs_trace_buffer_t *buffer)
+{
+    if (!buffer->events) {
+        buffer->events = ecs_os_malloc(
+            sizeof(ecs_trace_event_t) * world->trace_capacity);
+        ecs_assert(buffer->events != NULL, ECS_OUT_OF_MEMORY, NULL);
+    }
+
+    buffer->capacity = world->trace_capacity;
+    buffer->count = 0;
+}
+
+void ecs_trace_buffer_free(
+    ecs_trace_buffer_t *buffer)
+{
+    ecs_os_free(buffer->events);
+    buffer->events = NULL;
+    buffer->count = 0;
+}
+
+ecs_trace_buffer_t* ecs_trace_get_buffer(
+    ecs_world_t *world)
+{
+    if (world->magic == ECS_THREAD_MAGIC) {
+        ecs_thread_t *thread = (ecs_thread_t*)world;
+        if (thread->world->trace_enabled) {
+            return &thread->trace_buffer;
+        }
+    } else if (world->trace_enabled) {
+        return &world->trace_buffer;
+    }
+
+    return NULL;
+}
+
+static
+void trace_push(
+    ecs_trace_buffer_t *buffer,
+    ecs_trace_kind_t kind,
+    const char *name,
+    ecs_entity_t system,
+    ecs_time_t start,
+    int32_t arg_1,
+    int32_t arg_2)
+{
+    if (!buffer->events) {
+        return;
+    }
+
+    /* Buffers are only written by the thread that owns them. If the buffer is
+     * full, the oldest event is overwritten. */
+    ecs_trace_event_t *event = &buffer->events[
+        buffer->count & (buffer->capacity - 1)];
+
+    event->name = name;
+    event->system = system;
+    event->kind = kind;
+    event->start = start;
+    ecs_os_get_time(&event->stop);
+    event->args[0] = arg_1;
+    event->args[1] = arg_2;
+
+    buffer->count ++;
+}
+
+void ecs_trace_push(
+    ecs_trace_buffer_t *buffer,
+    ecs_trace_kind_t kind,
+    const char *name,
+    ecs_time_t start,
+    int32_t arg_1,
+    int32_t arg_2)
+{
+    trace_push(buffer, kind, name, 0, start, arg_1, arg_2);
+}
+
+void ecs_trace_push_system(
+    ecs_trace_buffer_t *buffer,
+    ecs_entity_t system,
+    ecs_time_t start,
+    int32_t arg_1,
+    int32_t arg_2)
+{
+    trace_push(buffer, EcsTraceSystem, NULL, system, start, arg_1, arg_2);
+}
+
+static
+double trace_us(
+    ecs_time_t t)
+{
+    return ecs_time_to_double(t) * 1000000.0;
+}
+
+static
+void write_string(
+    FILE *f,
+    const char *str)
+{
+    fputc('"', f);
+
+    if (str) {
+        char ch;
+        while ((ch = *str++)) {
+            if (ch == '"' || ch == '\\') {
+                fputc('\\', f);
+                fputc(ch, f);
+            } else if ((unsigned char)ch < 0x20) {
+                fprintf(f, "\\u%04x", ch);
+            } else {
+                fputc(ch, f);
+            }
+        }
+    }
+
+    fputc('"', f);
+}
+
+static
+void write_thread_name(
+    FILE *f,
+    int32_t tid,
+    const char *name,
+    int32_t index)
+{
+    fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+        "\"tid\":%d,\"args\":{\"name\":\"%s", tid, name);
+
+    if (index >= 0) {
+        fprintf(f, " %d", index);
+    }
+
+    fprintf(f, "\"}}");
+}
+
+static
+void write_buffer(
+    ecs_world_t *world,
+    FILE *f,
+    ecs_time_t trace_start,
+    ecs_trace_buffer_t *buffer,
+    int32_t tid)
+{
+    if (!buffer->events) {
+        return;
+    }
+
+    uint32_t i = 0, count = buffer->count, mask = buffer->capacity - 1;
+    if (count > buffer->capacity) {
+        i = count - buffer->capacity;
+    }
+
+    for (; i < count; i ++) {
+        ecs_trace_event_t *event = &buffer->events[i & mask];
+        double start = trace_us(ecs_time_sub(event->start, trace_start));
+        double duration = trace_us(ecs_time_sub(event->stop, event->start));
+
+        fprintf(f, ",\n{\"name\":");
+        if (event->system) {
+            /* Use the id of the system if it no longer has a name */
+            const char *name = NULL;
+            if (ecs_is_alive(world, event->system)) {
+                name = ecs_get_id(world, event->system);
+            }
+
+            if (name) {
+                write_string(f, name);
+            } else {
+                fprintf(f, "\"%llu\"", (unsigned long long)event->system);
+            }
+        } else {
+            write_string(f, event->name);
+        }
+        fprintf(f, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+            "\"ts\":%.3f,\"dur\":%.3f", trace_category[event->kind], tid,
+            start, duration);
+
+        const char **arg_names = trace_arg_names[event->kind];
+        if (arg_names[0]) {
+            fprintf(f, ",\"args\":{\"%s\":%d", arg_names[0], event->args[0]);
+            if (arg_names[1]) {
+                fprintf(f, ",\"%s\":%d", arg_names[1], event->args[1]);
+            }
+            fputc('}', f);
+        }
+
+        fputc('}', f);
+    }
+}
+
+/* -- Public API -- */
+
+void ecs_trace_start(
+    ecs_world_t *world,
+    uint32_t capacity)
+{
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_FROM_WORKER, NULL);
+    ecs_assert(!world->in_progress, ECS_INVALID_WHILE_ITERATING, NULL);
+    ecs_assert(ecs_os_api.get_time != NULL, ECS_MISSING_OS_API, "get_time");
+
+    if (!capacity) {
+        capacity = ECS_TRACE_DEFAULT_CAPACITY;
+    }
+
+    capacity = next_pow_of_2(capacity);
+
+    /* Reallocate buffers if the capacity changed */
+    if (capacity != world->trace_capacity) {
+        ecs_trace_buffer_free(&world->trace_buffer);
+
+        ecs_thread_t *threads = ecs_vector_first(world->worker_threads);
+        uint32_t i, count = ecs_vector_count(world->worker_threads);
+        for (i = 0; i < count; i ++) {
+            ecs_trace_buffer_free(&threads[i].trace_buffer);
+        }
+
+        world->trace_capacity = capacity;
+    }
+
+    /* Allocate buffers up front, so that recording events never allocates */
+    ecs_trace_buffer_init(world, &world->trace_buffer);
+
+    ecs_thread_t *threads = ecs_vector_first(world->worker_threads);
+    uint32_t i, count = ecs_vector_count(world->worker_threads);
+    for (i = 0; i < count; i ++) {
+        ecs_trace_buffer_init(world, &threads[i].trace_buffer);
+    }
+
+    ecs_os_get_time(&world->trace_start);
+    world->trace_enabled = true;
+}
+
+void ecs_trace_stop(
+    ecs_world_t *world)
+{
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_FROM_WORKER, NULL);
+    ecs_assert(!world->in_progress, ECS_INVALID_WHILE_ITERATING, NULL);
+    world->trace_enabled = false;
+}
+
+int ecs_trace_write(
+    ecs_world_t *world,
+    const char *filename)
+{
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_FROM_WORKER, NULL);
+    ecs_assert(!world->in_progress, ECS_INVALID_WHILE_ITERATING, NULL);
+    ecs_assert(filename != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    FILE *f = fopen(filename, "w");
+    if (!f) {
+        return -1;
+    }
+
+    ecs_thread_t *threads = ecs_vector_first(world->worker_threads);
+    uint32_t i, count = ecs_vector_count(world->worker_threads);
+
+    /* The first worker thread is the main thread, so they share a timeline */
+    fprintf(f, "{\"traceEvents\":[\n{\"name\":\"process_name\",\"ph\":\"M\","
+        "\"pid\":1,\"args\":{\"name\":\"flecs\"}}");
+
+    write_thread_name(f, 0, "main", -1);
+    for (i = 1; i < count; i ++) {
+        write_thread_name(f, i, "worker", i);
+    }
+
+    write_buffer(world, f, world->trace_start, &world->trace_buffer, 0);
+    for (i = 0; i < count; i ++) {
+        write_buffer(
+            world, f, world->trace_start, &threads[i].trace_buffer, i);
+    }
+
+    fprintf(f, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    int result = ferror(f) ? -1 : 0;
+    if (fclose(f)) {
+        result = -1;
+    }
+
+    return result;
+}
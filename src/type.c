@@ -416,27 +416,29 @@ ecs_type_t find_or_create_type(
         } else {
             if (!node->types) {
                 if (create) {
-                    node->types = ecs_os_calloc(
-                        ECS_TYPE_DB_BUCKET_COUNT, sizeof(ecs_vector_t*));
+                    node->types = ecs_map_new(0, sizeof(ecs_vector_t*));
                 } else {
                     return NULL;
                 }
             }
 
+            /* Types are stored by hash, so that nodes with many types with
+             * large entity offsets (like types with a different parent for
+             * each entity) do not degrade into a linear search */
             uint32_t hash = hash_array(&array[i], count - i);
-            uint32_t index = hash % ECS_TYPE_DB_BUCKET_COUNT;
+            ecs_vector_t **types = ecs_map_get_ptr(node->types, hash);
 
-            if (!node->types[index]) {
+            if (!types) {
                 if (create) {
-                    node->types[index] = ecs_vector_new(&link_params, 1);
+                    ecs_vector_t *vector = ecs_vector_new(&link_params, 1);
+                    types = ecs_map_set(node->types, hash, &vector);
                 } else {
                     return NULL;
                 }
             }
 
             type = find_type_in_vector(
-                world, stage, &node->types[index], array, count, create, 
-                normalized);
+                world, stage, types, array, count, create, normalized);
 
             if (type) {
                 break;
@@ -837,42 +839,6 @@ bool ecs_type_has_entity_intern(
     return false;
 }
 
-int32_t ecs_type_container_depth(
-   ecs_world_t *world,
-   ecs_type_t type,
-   ecs_entity_t component)     
-{
-    int result = 0;
-
-    int32_t i, count = ecs_vector_count(type);
-    ecs_entity_t *array = ecs_vector_first(type);
-
-    for (i = count - 1; i >= 0; i --) {
-        if (array[i] & ECS_CHILDOF) {
-            ecs_type_t c_type = ecs_get_type(world, array[i] & ECS_ENTITY_MASK);
-            int32_t j, c_count = ecs_vector_count(c_type);
-            ecs_entity_t *c_array = ecs_vector_first(c_type);
-
-            for (j = 0; j < c_count; j ++) {
-                if (c_array[j] == component) {
-                    result ++;
-                    result += ecs_type_container_depth(world, c_type, component);
-                    break;
-                }
-            }
-
-            if (j != c_count) {
-                break;
-            }
-        } else if (!(array[i] & ECS_ENTITY_FLAGS_MASK)) {
-            /* No more parents after this */
-            break;
-        }
-    }
-
-    return result;
-}
-
 static
 EcsTypeComponent type_from_vec(
     ecs_world_t *world,
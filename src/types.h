@@ -35,10 +35,20 @@
 #define ECS_WORLD_INITIAL_REMOVE_SYSTEM_COUNT (0)
 #define ECS_WORLD_INITIAL_SET_SYSTEM_COUNT (0)
 #define ECS_WORLD_INITIAL_PREFAB_COUNT (0)
-#define ECS_MAP_INITIAL_NODE_COUNT (4)
 #define ECS_TABLE_INITIAL_ROW_COUNT (0)
 #define ECS_SYSTEM_INITIAL_TABLE_COUNT (0)
-#define ECS_MAX_JOBS_PER_WORKER (16)
+
+/* Number of jobs a system is split into per worker thread. Having more jobs
+ * than threads lets idle threads steal work from threads that are behind. */
+#define ECS_JOBS_PER_THREAD (4)
+
+/* Number of times an idle worker polls for new jobs before it parks itself on
+ * the thread condition variable */
+#define ECS_WORKER_SPIN_COUNT (4096)
+
+/* Component ids below this value use an array lookup to find the add/remove
+ * edges of a table. Edges for higher ids are stored in a map. */
+#define ECS_TABLE_LO_EDGE_COUNT (256)
 
 /* This is _not_ the max number of entities that can be of a given type. This 
  * constant defines the maximum number of components, prefabs and parents can be
@@ -137,16 +147,55 @@ typedef struct ecs_system_column_t {
     ecs_entity_t source;             /* Source entity (used with FromEntity) */
 } ecs_system_column_t;
 
+/** Kinds of events recorded by the tracer */
+typedef enum ecs_trace_kind_t {
+    EcsTraceFrame,
+    EcsTracePhase,
+    EcsTraceSystem,
+    EcsTraceJob,
+    EcsTraceMerge
+} ecs_trace_kind_t;
+
+/** A traced span of time, with kind-specific arguments */
+typedef struct ecs_trace_event_t {
+    const char *name;                /* Static string, NULL for systems */
+    ecs_entity_t system;             /* System (name is resolved on write) */
+    ecs_time_t start;                /* Time at which span started */
+    ecs_time_t stop;                 /* Time at which span ended */
+    int32_t args[2];                 /* Arguments (see trace.c for names) */
+    ecs_trace_kind_t kind;           /* Kind of event */
+} ecs_trace_event_t;
+
+/** Ring buffer with the trace events of a single thread. A buffer is only
+ * written by the thread that owns it, and is only read outside of progress, so
+ * recording an event requires no synchronization. */
+typedef struct ecs_trace_buffer_t {
+    ecs_trace_event_t *events;       /* Events (capacity is a power of 2) */
+    uint32_t capacity;               /* Number of events in buffer */
+    uint32_t count;                  /* Number of events recorded */
+} ecs_trace_buffer_t;
+
 /** A table column describes a single column in a table (archetype) */
 struct ecs_table_column_t {
     ecs_vector_t *data;              /* Column data */
     uint16_t size;                   /* Column size (saves component lookups) */
+    uint16_t alignment;              /* Column alignment (0 for default) */
+    uint64_t changed;                /* Change tick of last write to column */
 };
 
 #define EcsTableIsStaged  (1)
 #define EcsTableIsPrefab (2)
 #define EcsTableHasPrefab (4)
 #define EcsTableHasBuiltins (8)
+#define EcsTableIsReferenced (16)
+#define EcsTableIsMainStage (32)
+
+/** An edge caches the table an entity moves to when a single component is
+ * added to or removed from the table that owns the edge. */
+typedef struct ecs_table_edge_t {
+    ecs_table_t *add;                 /* Table after adding the component */
+    ecs_table_t *remove;              /* Table after removing the component */
+} ecs_table_edge_t;
 
 /** A table is the Flecs equivalent of an archetype. Tables store all entities
  * with a specific set of components. Tables are automatically created when an
@@ -155,8 +204,17 @@ struct ecs_table_column_t {
 struct ecs_table_t {
     ecs_table_column_t *columns;      /* Columns storing components of array */
     ecs_vector_t *frame_systems;      /* Frame systems matched with table */
+    ecs_vector_t *queries;            /* Queries matched with table */
     ecs_type_t type;                  /* Identifies table type in type_index */
     uint32_t flags;                   /* Flags for testing table properties */
+    ecs_table_edge_t *lo_edges;       /* Edges for components < LO_EDGE_COUNT */
+    ecs_map_t *hi_edges;              /* Edges for all other components */
+    uint32_t version;                 /* Incremented when table data changes */
+    double time_spent;                /* Time spent by systems on table */
+    int32_t depth;                    /* Hierarchy depth, -1 if not computed */
+    uint32_t row_size;                /* Size of components of one entity */
+    ecs_memory_stat_t entity_memory;  /* Memory of entity column */
+    ecs_memory_stat_t component_memory; /* Memory of component columns */
 };
 
 /** Cached reference to a component in an entity */
@@ -172,9 +230,20 @@ typedef struct ecs_matched_table_t {
     int32_t *columns;               /* Mapping of system columns to table */
     ecs_entity_t *components;       /* Actual components of system columns */
     ecs_vector_t *references;       /* Reference columns and cached pointers */
-    int32_t depth;                  /* Depth of table (when using CASCADE) */
+    int32_t depth;                  /* Hierarchy depth (when using CASCADE) */
 } ecs_matched_table_t;
 
+/** A query caches the tables that match a filter. Tables with entities are
+ * stored before tables without entities, so that iterating a query does not
+ * have to visit tables that are empty. */
+struct ecs_query_t {
+    ecs_world_t *world;             /* Reference to the world */
+    ecs_filter_t filter;            /* Filter used to match tables */
+    ecs_vector_t *tables;           /* Matched tables (ecs_table_t*) */
+    ecs_map_t *table_index;         /* Index of table in tables array */
+    uint32_t active_count;          /* Number of (possibly) non-empty tables */
+};
+
 /** Keep track of how many [in] columns are active for [out] columns of OnDemand
  * systems. */
 typedef struct ecs_on_demand_out_t {
@@ -209,6 +278,7 @@ typedef struct EcsSystem {
     int32_t cascade_by;            /* CASCADE column index */
     int64_t invoke_count;          /* Number of times system was invoked */
     double time_spent;             /* Time spent on running system */
+    ecs_time_histogram_t time_histogram; /* Recent time spent per invocation */
     bool enabled;                  /* Is system enabled or not */
     bool has_refs;                 /* Does the system have reference columns */
     bool needs_tables;             /* Does the system need table matching */
@@ -258,8 +328,11 @@ typedef struct EcsColSystem {
     EcsSystem base;
     ecs_entity_t entity;                  /* Entity id of system, used for ordering */
     ecs_vector_t *jobs;                   /* Jobs for this system */
+    ecs_type_t reads;                     /* Components read by system */
+    ecs_type_t writes;                    /* Components written by system */
     ecs_vector_t *tables;                 /* Vector with matched tables */
     ecs_vector_t *inactive_tables;        /* Inactive tables */
+    ecs_map_t *table_index;               /* Set of matched tables */
     ecs_on_demand_out_t *on_demand;       /* Keep track of [out] column refs */
     ecs_system_status_action_t status_action; /* Status action */
     void *status_ctx;                     /* User data for status action */
@@ -268,10 +341,26 @@ typedef struct EcsColSystem {
     ecs_vector_params_t ref_params;       /* Parameters for refs */
     float period;                         /* Minimum period inbetween system invocations */
     float time_passed;                    /* Time passed since last invocation */
+    uint64_t since_tick;                  /* Change tick of previous invocation */
+    uint64_t run_tick;                    /* Change tick of current invocation */
     bool enabled_by_demand;               /* Is system enabled by on demand systems */
     bool enabled_by_user;                /* Is system enabled by user */
+    bool changed_only;                    /* Skip tables with unchanged [in] columns */
 } EcsColSystem;
 
+/** Columns of a row system resolved for a table. Columns that are found in the
+ * table only depend on the table type, and are resolved once. If the system has
+ * columns that depend on other entities, they are resolved again when the
+ * world's ref_version changes. */
+typedef struct ecs_row_system_table_t {
+    int32_t *columns;               /* Mapping of system columns to table */
+    ecs_reference_t *references;    /* Reference columns and cached pointers */
+    int32_t ref_count;              /* Number of references */
+    uint32_t ref_version;           /* Value of ref_version when resolved */
+    bool has_refs;                  /* Do columns depend on other entities */
+    bool matched;                   /* Does the table match the system */
+} ecs_row_system_table_t;
+
 /** A row system is a system that is ran on 1..n entities for which a certain 
  * operation has been invoked. The system kind determines on what kind of
  * operation the row system is invoked. Example operations are ecs_add,
@@ -279,6 +368,7 @@ typedef struct EcsColSystem {
 typedef struct EcsRowSystem {
     EcsSystem base;
     ecs_vector_t *components;       /* Components in order of signature */
+    ecs_map_t *tables;              /* Resolved columns for each table type */
 } EcsRowSystem;
  
 /** The ecs_row_t struct is a 64-bit value that describes in which table
@@ -289,8 +379,50 @@ typedef struct ecs_row_t {
     int32_t index;                /* Index of the entity in its table */
 } ecs_row_t;
 
+/* Number of rows in a page of the entity index. Must be a power of 2 */
+#define ECS_ENTITY_PAGE_BITS (12)
+#define ECS_ENTITY_PAGE_SIZE (1 << ECS_ENTITY_PAGE_BITS)
+
+/* Generation of an entity slot that has been deleted and not yet recycled */
+#define ECS_ENTITY_DELETED (0x80000000)
+
+/** A page stores the rows of a contiguous range of entity ids. The dense array
+ * stores for each row its position in ecs_ei_t::dense + 1, or 0 if the entity
+ * is not in the index. The generation array stores the current generation of
+ * each id, which is increased when the entity is deleted. Pages are shared
+ * between an index and its copies until one of them modifies the page. */
+typedef struct ecs_ei_page_t {
+    ecs_row_t rows[ECS_ENTITY_PAGE_SIZE];
+    uint32_t dense[ECS_ENTITY_PAGE_SIZE];
+    uint32_t generation[ECS_ENTITY_PAGE_SIZE];
+    uint32_t refcount;             /* Number of other indices sharing page */
+} ecs_ei_page_t;
+
+/** The entity index maps entity ids to ecs_row_t's. Since entity ids are
+ * handed out by a monotonic counter, the main stage stores rows in pages that
+ * are directly indexed by the lower 32 bits of the entity id, which makes a 
+ * lookup a single array access. A dense array of entity ids keeps track of 
+ * which entities are in the index, so that entities can be counted and 
+ * iterated. Ids of deleted entities are stored in a free list, so they can be
+ * recycled with an increased generation. Entity ids that are too large to be 
+ * paged (like the singleton) are stored in a map. Stages other than the main 
+ * stage only store sparse deltas, and only use the map. */
+typedef struct ecs_ei_t {
+    ecs_ei_page_t **pages;         /* Pages, indexed by entity >> PAGE_BITS */
+    uint32_t page_count;           /* Number of page pointers allocated */
+    ecs_vector_t *dense;           /* Entities stored in pages */
+    ecs_vector_t *free;            /* Deleted entity ids that can be reused */
+    ecs_map_t *map;                /* Entities that are not stored in pages */
+    bool paged;                    /* Are pages used for this index */
+} ecs_ei_t;
+
+typedef struct ecs_ei_iter_t {
+    ecs_ei_t *ei;
+    uint32_t index;
+    ecs_map_iter_t map_iter;
+} ecs_ei_iter_t;
+
 #define ECS_TYPE_DB_MAX_CHILD_NODES (256)
-#define ECS_TYPE_DB_BUCKET_COUNT (256)
 
 /** The ecs_type_node_t type is a node in a hierarchical structure that allows
  * for quick lookups of types. A node represents a type, and its direct children
@@ -312,7 +444,7 @@ typedef struct ecs_type_link_t {
 
 typedef struct ecs_type_node_t {
     ecs_vector_t *nodes;    /* child nodes - <ecs_entity_t, ecs_type_node_t> */
-    ecs_vector_t **types;   /* child types w/large entity offsets - <hash, vector<ecs_type_link_t>> */
+    ecs_map_t *types;       /* child types w/large entity offsets - <hash, vector<ecs_type_link_t>> */
     ecs_type_link_t link;     
 } ecs_type_node_t;
 
@@ -325,7 +457,12 @@ typedef struct ecs_stage_t {
     /* If this is not main stage, 
      * changes to the entity index 
      * are buffered here */
-    ecs_map_t *entity_index;       /* Entity lookup table for (table, row) */
+    ecs_ei_t *entity_index;        /* Entity lookup table for (table, row) */
+
+    /* If this is not main stage,
+     * names set while in progress
+     * are buffered here */
+    ecs_map_t *name_index;         /* Entities by hash of (parent, name) */
 
     /* If this is not a thread
      * stage, these are the same
@@ -340,6 +477,9 @@ typedef struct ecs_stage_t {
      * not on the main stage */
     ecs_map_t *data_stage;         /* Arrays with staged component values */
     ecs_map_t *remove_merge;       /* All removed components before merge */
+    ecs_vector_t *delete_merge;    /* All deleted entities before merge */
+    ecs_vector_t *merge_rows;      /* Entities merged per table */
+    ecs_vector_t *merge_entities;  /* Entities merged one by one */
 
     /* Keep track of changes so
      * code knows when entity
@@ -348,6 +488,13 @@ typedef struct ecs_stage_t {
     ecs_type_t from_type;
     ecs_type_t to_type;
     
+    /* Time spent merging the stage,
+     * measured together with
+     * the frame time */
+    ecs_time_histogram_t merge_histogram;
+    double merge_time_total;
+    uint64_t merge_count_total;
+
     /* Is entity range checking enabled? */
     bool range_check_enabled;
 } ecs_stage_t;
@@ -373,6 +520,7 @@ typedef struct ecs_job_t {
     EcsColSystem *system_data;    /* System to run */
     uint32_t offset;              /* Start index in row chunk */
     uint32_t limit;               /* Total number of rows to process */
+    bool is_task;                 /* Tasks are only ran by the main thread */
 } ecs_job_t;
 
 /** A type desribing a worker thread. When a system is invoked by a worker
@@ -384,20 +532,32 @@ typedef struct ecs_job_t {
  * without requiring different API calls when working in multi threaded mode. */
 typedef struct ecs_thread_t {
     uint32_t magic;                           /* Magic number to verify thread pointer */
-    uint32_t job_count;                       /* Number of jobs scheduled for thread */
+    int32_t job_head;                         /* Index of next job to claim */
     ecs_world_t *world;                       /* Reference to world */
-    ecs_job_t *jobs[ECS_MAX_JOBS_PER_WORKER]; /* Array with jobs */
+    ecs_vector_t *jobs;                       /* Queue with jobs for thread */
     ecs_stage_t *stage;                       /* Stage for thread */
     ecs_os_thread_t thread;                   /* Thread handle */
     uint16_t index;                           /* Index of thread */
+    ecs_trace_buffer_t trace_buffer;          /* Trace events of thread */
+    ecs_time_histogram_t job_histogram;       /* Recent time spent per job */
+    double job_time_total;                    /* Time spent running jobs */
+    uint64_t job_count_total;                 /* Number of jobs ran */
 } ecs_thread_t;
 
+/* Memory mapped world image. Table columns loaded from the image are borrowed
+ * vectors that point into the mapping, which is released by ecs_fini. */
+typedef struct ecs_image_t {
+    void *data;
+    size_t size;
+} ecs_image_t;
+
 /* World snapshot */
 struct ecs_snapshot_t {
-    ecs_map_t *entity_index;
+    ecs_ei_t *entity_index;
     ecs_chunked_t *tables;
     ecs_entity_t last_handle;
     ecs_filter_t filter;
+    bool is_delta;                /* Only stores tables changed since previous */
 };
 
 /** The world stores and manages all ECS data. An application can have more than
@@ -433,6 +593,11 @@ struct ecs_world_t {
     ecs_vector_t *set_systems;        /* Systems invoked on ecs_set */
 
 
+    /* -- Queries -- */
+
+    ecs_vector_t *queries;            /* Queries that cache matched tables */
+
+
     /* -- Tasks -- */
 
     ecs_vector_t *fini_tasks;         /* Tasks to execute on ecs_fini */
@@ -444,6 +609,7 @@ struct ecs_world_t {
     ecs_map_t *type_sys_remove_index; /* Index to find remove row systems for type*/
     ecs_map_t *type_sys_set_index;    /* Index to find set row systems for type */
     
+    ecs_map_t *component_tables;      /* Index to find tables for component */
     ecs_map_t *prefab_parent_index;   /* Index to find flag for prefab parent */
     ecs_map_t *type_handles;          /* Handles to named types */
 
@@ -453,16 +619,21 @@ struct ecs_world_t {
     ecs_stage_t main_stage;          /* Main storage */
     ecs_stage_t temp_stage;          /* Stage for when processing systems */
     ecs_vector_t *worker_stages;     /* Stages for worker threads */
+    ecs_vector_t *images;            /* Loaded images that own column data */
 
 
     /* -- Multithreading -- */
 
     ecs_vector_t *worker_threads;    /* Worker threads */
+    ecs_vector_t *job_batch;         /* Systems with jobs in current batch */
+    ecs_vector_t *main_jobs;         /* Jobs that cannot be stolen */
     ecs_os_cond_t thread_cond;       /* Signal that worker threads can start */
     ecs_os_mutex_t thread_mutex;     /* Mutex for thread condition */
-    ecs_os_cond_t job_cond;          /* Signal that worker thread job is done */
-    ecs_os_mutex_t job_mutex;        /* Mutex for protecting job counter */
-    uint32_t jobs_finished;          /* Number of jobs finished */
+    ecs_os_cond_t job_cond;          /* Signal that worker threads are done */
+    ecs_os_mutex_t job_mutex;        /* Mutex for job condition */
+    int32_t job_generation;          /* Incremented when new jobs are ready */
+    int32_t workers_busy;            /* Workers still processing jobs */
+    uint32_t threads_parked;         /* Workers waiting on thread_cond */
     uint32_t threads_running;        /* Number of threads running */
 
     ecs_entity_t last_handle;        /* Last issued handle */
@@ -496,6 +667,11 @@ struct ecs_world_t {
     double world_time_total;      /* Time elapsed since first frame */
     uint32_t frame_count_total;   /* Total number of frames */
 
+    /* Memory of the columns of all main stage tables. Kept up to date when
+     * tables grow or shrink, so that collecting it does not walk tables. */
+    ecs_memory_stat_t entity_memory;
+    ecs_memory_stat_t component_memory;
+
 
     /* -- Settings from command line arguments -- */
 
@@ -514,7 +690,19 @@ struct ecs_world_t {
     bool measure_system_time;     /* Time spent by each system */
     bool should_quit;             /* Did a system signal that app should quit */
     bool should_match;            /* Should tablea be rematched */
+    bool should_match_all;        /* Should all tables be rematched */
+    ecs_vector_t *match_entities; /* Watched entities that changed type */
     bool should_resolve;          /* If a table reallocd, resolve system refs */
+    uint32_t ref_version;         /* Changes when cached refs may be invalid */
+    uint64_t change_tick;         /* Stamped on table columns when written */
+
+
+    /* -- Tracing -- */
+
+    bool trace_enabled;           /* Are trace events recorded */
+    uint32_t trace_capacity;      /* Number of events per trace buffer */
+    ecs_time_t trace_start;       /* Time at which tracing started */
+    ecs_trace_buffer_t trace_buffer; /* Trace events of main thread */
 }; 
 
 
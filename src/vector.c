@@ -4,23 +4,79 @@ struct ecs_vector_t {
     uint32_t count;
     uint32_t size;
 
-    /* Aligns the array to 16 bytes. This prevents issues with component types
-     * that are 16 bit aligned, such as some SIMD compiler intrinsics. This is
-     * a quick hack, but should in the long term be solved by using a separate
-     * datastructure for any collection that can contain user-defined types. */
-    uint64_t dummy;
+    /* Number of additional owners of the vector. A shared vector may not be
+     * modified, and is only freed when the last owner frees it. */
+    uint32_t refcount;
+
+    /* The header is 16 bytes, which aligns the buffer to 16 bytes. Vectors
+     * with a larger alignment store their buffer at the first aligned address
+     * after the header. */
+    uint16_t offset;    /* Offset of buffer from start of vector */
+    uint16_t alignment; /* Alignment of buffer, 0 if buffer follows header */
 };
 
-#define ARRAY_BUFFER(array) ECS_OFFSET(array, sizeof(ecs_vector_t))
+#define ARRAY_BUFFER(array) ECS_OFFSET(array, (array)->offset)
+
+/** Number of bytes to allocate for a buffer of the specified size. Aligned
+ * buffers reserve space for aligning the buffer, and pad the buffer up to a
+ * multiple of the alignment so that the last element can be loaded with a
+ * full vector instruction. */
+static
+size_t alloc_size(
+    uint16_t alignment,
+    uint32_t size)
+{
+    if (alignment > sizeof(ecs_vector_t)) {
+        size = (size + alignment - 1) & ~(uint32_t)(alignment - 1);
+        return sizeof(ecs_vector_t) + alignment + size;
+    } else {
+        return sizeof(ecs_vector_t) + size;
+    }
+}
+
+/** Offset of the first aligned address after the vector header */
+static
+uint16_t buffer_offset(
+    ecs_vector_t *array,
+    uint16_t alignment)
+{
+    if (alignment > sizeof(ecs_vector_t)) {
+        uintptr_t buffer = (uintptr_t)array + sizeof(ecs_vector_t);
+        uintptr_t aligned = (buffer + alignment - 1) & 
+            ~(uintptr_t)(alignment - 1);
+        return aligned - (uintptr_t)array;
+    } else {
+        return sizeof(ecs_vector_t);
+    }
+}
 
 /** Resize the array buffer */
 static
 ecs_vector_t* resize(
     ecs_vector_t *array,
+    const ecs_vector_params_t *params,
     uint32_t size)
 {
-    ecs_vector_t *result = ecs_os_realloc(array, sizeof(ecs_vector_t) + size);
+    ecs_assert(array != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(!array->refcount, ECS_INTERNAL_ERROR, NULL);
+
+    uint16_t alignment = array->alignment;
+    uint16_t old_offset = array->offset;
+
+    ecs_vector_t *result = ecs_os_realloc(array, 
+        alloc_size(alignment, size * params->element_size));
     ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, 0);
+
+    /* The reallocated memory may have a different alignment, in which case
+     * the elements have to be moved to the new aligned address. */
+    uint16_t offset = buffer_offset(result, alignment);
+    if (offset != old_offset) {
+        uint32_t count = result->count < size ? result->count : size;
+        memmove(ECS_OFFSET(result, offset), ECS_OFFSET(result, old_offset),
+            count * params->element_size);
+        result->offset = offset;
+    }
+
     return result;
 }
 
@@ -32,18 +88,36 @@ ecs_vector_t* ecs_vector_new(
     uint32_t size)
 {
     ecs_assert(params->element_size != 0, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(!(params->alignment & (params->alignment - 1)), 
+        ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(params->alignment <= UINT16_MAX / 2, 
+        ECS_INVALID_PARAMETER, NULL);
+
+    uint16_t alignment = params->alignment;
+    if (alignment <= sizeof(ecs_vector_t)) {
+        alignment = 0;
+    }
     
-    ecs_vector_t *result = ecs_os_malloc(sizeof(ecs_vector_t) + size * params->element_size);
+    ecs_vector_t *result = ecs_os_malloc(
+        alloc_size(alignment, size * params->element_size));
     ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
 
     result->count = 0;
     result->size = size;
+    result->refcount = 0;
+    result->offset = buffer_offset(result, alignment);
+    result->alignment = alignment;
     return result;
 }
 
 void ecs_vector_free(
     ecs_vector_t *array)
 {
+    if (array && array->refcount) {
+        array->refcount --;
+        return;
+    }
+
     ecs_os_free(array);
 }
 
@@ -51,6 +125,7 @@ void ecs_vector_clear(
     ecs_vector_t *array)
 {
     if (array) {
+        ecs_assert(!array->refcount, ECS_INTERNAL_ERROR, NULL);
         array->count = 0;
     }
 }
@@ -66,6 +141,8 @@ void* ecs_vector_addn(
         *array_inout = array;
     }
 
+    ecs_assert(!array->refcount, ECS_INTERNAL_ERROR, NULL);
+
     uint32_t size = array->size;
     uint32_t old_count = array->count;
     uint32_t count = old_count + n_elems;
@@ -80,7 +157,7 @@ void* ecs_vector_addn(
             }
         }
 
-        array = resize(array, size * element_size);
+        array = resize(array, params, size);
         array->size = size;
         *array_inout = array;
     }
@@ -124,6 +201,8 @@ uint32_t ecs_vector_remove(
     void *buffer = ARRAY_BUFFER(array);
     uint32_t index = ((char*)elem - (char*)buffer) / element_size;
 
+    ecs_assert(!array->refcount, ECS_INTERNAL_ERROR, NULL);
+
     if (index >= count) {
         return count;
     }
@@ -148,6 +227,7 @@ uint32_t ecs_vector_remove(
 void ecs_vector_remove_last(
     ecs_vector_t *array)
 {
+    ecs_assert(!array->refcount, ECS_INTERNAL_ERROR, NULL);
     if (array->count) array->count --;
 }
 
@@ -191,6 +271,7 @@ uint32_t ecs_vector_remove_index(
     void *elem = ECS_OFFSET(buffer, index * element_size);
 
     ecs_assert(index < count, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!array->refcount, ECS_INTERNAL_ERROR, NULL);
 
     if (index != (count - 1)) {
         void *last_elem = ECS_OFFSET(buffer, element_size * (count - 1));
@@ -216,11 +297,10 @@ void ecs_vector_reclaim(
     ecs_vector_t *array = *array_inout;
     uint32_t size = array->size;
     uint32_t count = array->count;
-    uint32_t element_size = params->element_size;
 
     if (count < size) {
         size = count;
-        array = resize(array, size * element_size);
+        array = resize(array, params, size);
         array->size = size;
         *array_inout = array;
     }
@@ -263,7 +343,7 @@ uint32_t ecs_vector_set_size(
         }
 
         if (result < size) {
-            array = resize(array, size * params->element_size);
+            array = resize(array, params, size);
             array->size = size;
             *array_inout = array;
             result = size;
@@ -283,6 +363,8 @@ uint32_t ecs_vector_set_count(
     if (!*array_inout) {
         *array_inout = ecs_vector_new(params, count);
     }
+
+    ecs_assert(!(*array_inout)->refcount, ECS_INTERNAL_ERROR, NULL);
     (*array_inout)->count = count;
     uint32_t size = ecs_vector_set_size(array_inout, params, count);
 
@@ -354,6 +436,7 @@ void ecs_vector_sort(
         return;
 
     ecs_assert(array->size >= array->count, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(!array->refcount, ECS_INTERNAL_ERROR, NULL);
     uint32_t count = array->count;
     uint32_t element_size = params->element_size;
     void *buffer = ARRAY_BUFFER(array);
@@ -366,18 +449,19 @@ void ecs_vector_sort(
 void ecs_vector_memory(
     const ecs_vector_t *array,
     const ecs_vector_params_t *params,
-    uint32_t *allocd,
-    uint32_t *used)
+    uint64_t *allocd,
+    uint64_t *used)
 {
     if (!array) return;
     
     ecs_assert(array->size >= array->count, ECS_INTERNAL_ERROR, NULL);
 
     if (allocd) {
-        *allocd += array->size * params->element_size + sizeof(ecs_vector_t);
+        *allocd += alloc_size(array->alignment, 
+            array->size * params->element_size);
     }
     if (used) {
-        *used += array->count * params->element_size;
+        *used += (uint64_t)array->count * params->element_size;
     }
 }
 
@@ -389,7 +473,51 @@ ecs_vector_t* ecs_vector_copy(
         return NULL;
     }
 
-    ecs_vector_t *dst = ecs_vector_new(params, src->size);
-    memcpy(dst, src, sizeof(ecs_vector_t) + params->element_size * src->count);
+    /* Keep the alignment of the source, unless a larger one is requested */
+    ecs_vector_params_t dst_params = *params;
+    if (src->alignment > dst_params.alignment) {
+        dst_params.alignment = src->alignment;
+    }
+
+    ecs_vector_t *dst = ecs_vector_new(&dst_params, src->size);
+    memcpy(ARRAY_BUFFER(dst), ARRAY_BUFFER(src), 
+        params->element_size * src->count);
+    dst->count = src->count;
     return dst;
 }
+
+ecs_vector_t* ecs_vector_share(
+    ecs_vector_t *array)
+{
+    if (array) {
+        array->refcount ++;
+    }
+
+    return array;
+}
+
+bool ecs_vector_is_shared(
+    const ecs_vector_t *array)
+{
+    return array && array->refcount;
+}
+
+/** Create a vector in memory that is not owned by the vector. The memory must
+ * start with ECS_VECTOR_HEADER_SIZE bytes for the header, followed by count
+ * elements. The owner of the memory holds a reference that is never released,
+ * so the vector is copied before it is modified and is never freed. */
+ecs_vector_t* ecs_vector_borrow(
+    void *memory,
+    uint32_t count)
+{
+    ecs_assert(sizeof(ecs_vector_t) == ECS_VECTOR_HEADER_SIZE, 
+        ECS_INTERNAL_ERROR, NULL);
+
+    ecs_vector_t *result = memory;
+    result->count = count;
+    result->size = count;
+    result->refcount = 1;
+    result->offset = sizeof(ecs_vector_t);
+    result->alignment = 0;
+    return result;
+}
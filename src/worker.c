@@ -8,52 +8,194 @@ const ecs_vector_params_t job_arr_params = {
     .element_size = sizeof(ecs_job_t)
 };
 
-/** Worker thread code. Processes a job for one system */
+const ecs_vector_params_t job_ptr_arr_params = {
+    .element_size = sizeof(ecs_job_t*)
+};
+
+const ecs_vector_params_t system_ptr_arr_params = {
+    .element_size = sizeof(EcsColSystem*)
+};
+
+/* Read a value that is written by other threads */
+#define ecs_load(value) (*(volatile int32_t*)&(value))
+
+/** Test if workers should quit */
+static
+bool should_quit(
+    ecs_world_t *world)
+{
+    return *(volatile bool*)&world->quit_workers;
+}
+
+/** Claim the next job from the queue of a thread. Jobs are only added to a
+ * queue while the workers are idle, so while jobs are running a queue can only
+ * shrink. This means that the owner of the queue and threads that steal from
+ * it can claim jobs with a single atomic increment. */
+static
+ecs_job_t* claim_job(
+    ecs_thread_t *thread)
+{
+    int32_t count = ecs_vector_count(thread->jobs);
+
+    /* Don't bother incrementing if the queue is already empty */
+    if (ecs_load(thread->job_head) >= count) {
+        return NULL;
+    }
+
+    int32_t index = ecs_os_ainc(&thread->job_head) - 1;
+    if (index < count) {
+        ecs_job_t **jobs = ecs_vector_first(thread->jobs);
+        return jobs[index];
+    }
+
+    return NULL;
+}
+
+/** Run a single job on the thread */
+static
+void run_job(
+    ecs_world_t *world,
+    ecs_thread_t *thread,
+    ecs_job_t *job)
+{
+    bool measure_time = world->measure_frame_time;
+    ecs_trace_buffer_t *trace = ecs_trace_get_buffer((ecs_world_t*)thread);
+
+    ecs_time_t start;
+    if (measure_time || trace) {
+        ecs_os_get_time(&start);
+    }
+
+    ecs_run_intern(
+        (ecs_world_t*)thread, /* magic */
+        world,
+        job->system, 
+        world->delta_time, 
+        job->offset, 
+        job->limit, 
+        NULL, 
+        NULL);
+
+    if (trace) {
+        ecs_trace_push(trace, EcsTraceJob, "job", start, 
+            job->offset, job->limit);
+    }
+
+    /* Job timings are only written by the thread that ran the job */
+    if (measure_time) {
+        double t = ecs_time_measure(&start);
+        ecs_time_histogram_record(&thread->job_histogram, t);
+        thread->job_time_total += t;
+        thread->job_count_total ++;
+    }
+}
+
+/** Run jobs from the queue of the thread, then steal from other threads until
+ * all queues are empty */
+static
+void run_jobs(
+    ecs_world_t *world,
+    ecs_thread_t *thread)
+{
+    ecs_thread_t *threads = ecs_vector_first(world->worker_threads);
+    uint32_t i, count = ecs_vector_count(world->worker_threads);
+    ecs_job_t *job;
+
+    for (i = 0; i < count; i ++) {
+        ecs_thread_t *victim = &threads[(thread->index + i) % count];
+
+        while ((job = claim_job(victim))) {
+            run_job(world, thread, job);
+        }
+    }
+}
+
+/** Wait until the job generation changes, or until workers should quit. Spin
+ * for a while before parking the thread, as jobs for the next system typically
+ * arrive shortly after the previous ones are done. */
+static
+bool wait_for_generation(
+    ecs_world_t *world,
+    int32_t generation)
+{
+    uint32_t i;
+
+    for (i = 0; i < ECS_WORKER_SPIN_COUNT; i ++) {
+        if (ecs_load(world->job_generation) != generation) {
+            return !should_quit(world);
+        }
+        if (should_quit(world)) {
+            return false;
+        }
+    }
+
+    ecs_os_mutex_lock(world->thread_mutex);
+    world->threads_parked ++;
+
+    while (ecs_load(world->job_generation) == generation && 
+        !should_quit(world)) 
+    {
+        ecs_os_cond_wait(world->thread_cond, world->thread_mutex);
+    }
+
+    world->threads_parked --;
+    ecs_os_mutex_unlock(world->thread_mutex);
+
+    return !should_quit(world);
+}
+
+/** Worker thread code. Processes jobs of the thread and steals jobs from other
+ * threads. Each worker processes each job generation exactly once, as the main
+ * thread does not publish new jobs before all workers are done. */
 static
 void* ecs_worker(void *arg) {
     ecs_thread_t *thread = arg;
     ecs_world_t *world = thread->world;
-    uint32_t i;
 
     ecs_os_mutex_lock(world->thread_mutex);
+    int32_t generation = world->job_generation;
     world->threads_running ++;
+    ecs_os_mutex_unlock(world->thread_mutex);
 
-    while (!world->quit_workers) {
-        ecs_os_cond_wait(world->thread_cond, world->thread_mutex);
-        if (world->quit_workers) {
-            break;
-        }
+    while (wait_for_generation(world, generation)) {
+        generation ++;
 
-        ecs_job_t **jobs = thread->jobs;
-        uint32_t job_count = thread->job_count;
-        ecs_os_mutex_unlock(world->thread_mutex);
+        run_jobs(world, thread);
 
-        for (i = 0; i < job_count; i ++) {
-            ecs_run_intern(
-                (ecs_world_t*)thread, /* magic */
-                world,
-                jobs[i]->system, 
-                world->delta_time, 
-                jobs[i]->offset, 
-                jobs[i]->limit, 
-                NULL, 
-                NULL);
+        /* The last worker to finish wakes up the main thread */
+        if (!ecs_os_adec(&world->workers_busy)) {
+            ecs_os_mutex_lock(world->job_mutex);
+            ecs_os_cond_signal(world->job_cond);
+            ecs_os_mutex_unlock(world->job_mutex);
         }
+    }
 
-        ecs_os_mutex_lock(world->thread_mutex);
-        thread->job_count = 0;
+    return NULL;
+}
 
-        ecs_os_mutex_lock(world->job_mutex);
-        world->jobs_finished ++;
-        if (world->jobs_finished == world->threads_running) {
-            ecs_os_cond_signal(world->job_cond);
+/** Test if two (sorted) types have components in common */
+static
+bool types_overlap(
+    ecs_type_t type_1,
+    ecs_type_t type_2)
+{
+    ecs_entity_t *buf_1 = ecs_vector_first(type_1);
+    ecs_entity_t *buf_2 = ecs_vector_first(type_2);
+    uint32_t i_1 = 0, count_1 = ecs_vector_count(type_1);
+    uint32_t i_2 = 0, count_2 = ecs_vector_count(type_2);
+
+    while (i_1 < count_1 && i_2 < count_2) {
+        ecs_entity_t e_1 = buf_1[i_1], e_2 = buf_2[i_2];
+        if (e_1 == e_2) {
+            return true;
+        } else if (e_1 < e_2) {
+            i_1 ++;
+        } else {
+            i_2 ++;
         }
-        ecs_os_mutex_unlock(world->job_mutex);
     }
 
-    ecs_os_mutex_unlock(world->thread_mutex);
-
-    return NULL;
+    return false;
 }
 
 /** Wait until threads have started (busy loop) */
@@ -73,18 +215,22 @@ void wait_for_threads(
     } while (wait);
 }
 
-/** Wait until threads have finished processing their jobs */
+/** Wait until workers have finished processing their jobs */
 static
 void wait_for_jobs(
     ecs_world_t *world)
 {
-    uint32_t thread_count = ecs_vector_count(world->worker_threads) - 1;
+    uint32_t i;
+
+    for (i = 0; i < ECS_WORKER_SPIN_COUNT; i ++) {
+        if (!ecs_load(world->workers_busy)) {
+            return;
+        }
+    }
 
     ecs_os_mutex_lock(world->job_mutex);
-    if (world->jobs_finished != thread_count) {
-        do {
-            ecs_os_cond_wait(world->job_cond, world->job_mutex);
-        } while (world->jobs_finished != thread_count);
+    while (ecs_load(world->workers_busy)) {
+        ecs_os_cond_wait(world->job_cond, world->job_mutex);
     }
     ecs_os_mutex_unlock(world->job_mutex);
 }
@@ -103,13 +249,22 @@ void ecs_stop_threads(
     uint32_t i, count = ecs_vector_count(world->worker_threads);
     for (i = 1; i < count; i ++) {
         ecs_os_thread_join(buffer[i].thread);
+    }
+
+    for (i = 0; i < count; i ++) {
         ecs_stage_deinit(world, buffer[i].stage);
+        ecs_vector_free(buffer[i].jobs);
+        ecs_trace_buffer_free(&buffer[i].trace_buffer);
     }
 
     ecs_vector_free(world->worker_threads);
     ecs_vector_free(world->worker_stages);
+    ecs_vector_free(world->job_batch);
+    ecs_vector_free(world->main_jobs);
     world->worker_stages = NULL;
     world->worker_threads = NULL;
+    world->job_batch = NULL;
+    world->main_jobs = NULL;
     world->quit_workers = false;
     world->threads_running = 0;
 }
@@ -132,16 +287,28 @@ void start_threads(
         thread->magic = ECS_THREAD_MAGIC;
         thread->world = world;
         thread->thread = 0;
-        thread->job_count = 0;
+        thread->jobs = NULL;
+        thread->job_head = 0;
         thread->index = i;
+        thread->trace_buffer = (ecs_trace_buffer_t){0};
+        if (world->trace_enabled) {
+            ecs_trace_buffer_init(world, &thread->trace_buffer);
+        }
+
+        memset(&thread->job_histogram, 0, sizeof(ecs_time_histogram_t));
+        thread->job_time_total = 0;
+        thread->job_count_total = 0;
 
         thread->stage = ecs_vector_add(&world->worker_stages, &stage_arr_params);
         ecs_stage_init(world, thread->stage);
+    }
 
-        if (i != 0) {
-            thread->thread = ecs_os_thread_new(ecs_worker, thread);
-            ecs_assert(thread->thread != 0, ECS_THREAD_ERROR, NULL);
-        }
+    /* Start threads after all thread structs are initialized, as workers can
+     * steal from any thread in the worker_threads vector */
+    ecs_thread_t *buffer = ecs_vector_first(world->worker_threads);
+    for (i = 1; i < threads; i ++) {
+        buffer[i].thread = ecs_os_thread_new(ecs_worker, &buffer[i]);
+        ecs_assert(buffer[i].thread != 0, ECS_THREAD_ERROR, NULL);
     }
 }
 
@@ -149,16 +316,16 @@ void start_threads(
 static
 void create_jobs(
     EcsColSystem *system_data,
-    uint32_t thread_count)
+    uint32_t job_count)
 {
     if (system_data->jobs) {
         ecs_vector_free(system_data->jobs);
     }
 
-    system_data->jobs = ecs_vector_new(&job_arr_params, thread_count);
+    system_data->jobs = ecs_vector_new(&job_arr_params, job_count);
 
     uint32_t i;
-    for (i = 0; i < thread_count; i ++) {
+    for (i = 0; i < job_count; i ++) {
         ecs_vector_add(&system_data->jobs, &job_arr_params);
     }
 }
@@ -166,13 +333,15 @@ void create_jobs(
 
 /* -- Private functions -- */
 
-/** Create a job per available thread for system */
+/** Split system into jobs. A system is split in more jobs than there are
+ * threads, so that threads that finish early can steal remaining jobs. */
 void ecs_schedule_jobs(
     ecs_world_t *world,
     ecs_entity_t system)
 {
     EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
     uint32_t thread_count = ecs_vector_count(world->worker_threads);
+    uint32_t job_count = thread_count * ECS_JOBS_PER_THREAD;
     uint32_t total_rows = 0;
     bool is_task = false;
 
@@ -192,38 +361,40 @@ void ecs_schedule_jobs(
     }
 
     if (is_task) {
-        thread_count = 1; /* Tasks are always scheduled to the main thread */
-    } else if (total_rows < thread_count) {
-        thread_count = total_rows;
+        job_count = 1; /* Tasks are always ran by the main thread */
+    } else if (total_rows < job_count) {
+        job_count = total_rows;
     }
 
-    if (ecs_vector_count(system_data->jobs) != thread_count) {
-        create_jobs(system_data, thread_count);
+    if (ecs_vector_count(system_data->jobs) != job_count) {
+        create_jobs(system_data, job_count);
     }
 
-    float rows_per_thread = (float)total_rows / (float)thread_count;
+    float rows_per_job = (float)total_rows / (float)job_count;
     float residual = 0;
-    int32_t rows_per_thread_i = rows_per_thread;
+    int32_t rows_per_job_i = rows_per_job;
 
     uint32_t start_index = 0;
 
     ecs_job_t *job = NULL;
 
-    for (i = 0; i < thread_count; i ++) {
+    for (i = 0; i < job_count; i ++) {
         job = ecs_vector_get(system_data->jobs, &job_arr_params, i);
-        int32_t rows_per_job = rows_per_thread_i;
-        residual += rows_per_thread - rows_per_job;
+        job->is_task = is_task;
+
+        int32_t rows = rows_per_job_i;
+        residual += rows_per_job - rows;
         if (residual > 1) {
-            rows_per_job ++;
+            rows ++;
             residual --;
         }
 
         job->system = system;
         job->system_data = system_data;
         job->offset = start_index;
-        job->limit = rows_per_job;
+        job->limit = rows;
 
-        start_index += rows_per_job;
+        start_index += rows;
     }
 
     if (i && residual >= 0.9) {
@@ -231,51 +402,120 @@ void ecs_schedule_jobs(
     }
 }
 
-/** Assign jobs to worker threads, signal workers */
+bool ecs_jobs_conflict(
+    ecs_world_t *world,
+    ecs_entity_t system)
+{
+    EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
+    EcsColSystem **batch = ecs_vector_first(world->job_batch);
+    uint32_t i, count = ecs_vector_count(world->job_batch);
+
+    for (i = 0; i < count; i ++) {
+        EcsColSystem *other = batch[i];
+
+        /* Read after write */
+        if (types_overlap(system_data->reads, other->writes)) {
+            return true;
+        }
+
+        /* Write after read or write */
+        if (types_overlap(system_data->writes, other->reads) ||
+            types_overlap(system_data->writes, other->writes)) 
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/** Queue jobs of system in the thread queues. Consecutive jobs are assigned to
+ * the same thread, so that a thread that does not steal processes a contiguous
+ * range of rows. */
 void ecs_prepare_jobs(
     ecs_world_t *world,
     ecs_entity_t system)
 {
     EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
-    ecs_vector_t *threads = world->worker_threads;
-    ecs_vector_t *jobs = system_data->jobs;
-    uint32_t i;
+    ecs_thread_t *threads = ecs_vector_first(world->worker_threads);
+    uint32_t thread_count = ecs_vector_count(world->worker_threads);
+    uint32_t i, job_count = ecs_vector_count(system_data->jobs);
+
+    /* The period is tested once for all jobs, so that they agree on whether
+     * the system runs and the change ticks are advanced for each run */
+    if (!system_data->base.enabled || !ecs_vector_count(system_data->tables)) {
+        return;
+    }
+
+    if (system_data->period && 
+        !ecs_col_system_should_run(system_data, world->delta_time)) 
+    {
+        return;
+    }
+
+    for (i = 0; i < job_count; i++) {
+        ecs_job_t *job = ecs_vector_get(system_data->jobs, &job_arr_params, i);
+        ecs_job_t **elem;
 
-    uint32_t thread_count = ecs_vector_count(jobs);
+        /* Task jobs don't go in a thread queue, as other threads could steal
+         * them from the main thread */
+        if (job->is_task) {
+            elem = ecs_vector_add(&world->main_jobs, &job_ptr_arr_params);
+        } else {
+            ecs_thread_t *thr = &threads[(i * thread_count) / job_count];
+            elem = ecs_vector_add(&thr->jobs, &job_ptr_arr_params);
+        }
 
-    for (i = 0; i < thread_count; i++) {
-        ecs_thread_t *thr = ecs_vector_get(threads, &thread_arr_params, i);
-        uint32_t job_count = thr->job_count;
-        thr->jobs[job_count] = ecs_vector_get(jobs, &job_arr_params, i);
-        thr->job_count = job_count + 1;
+        *elem = job;
     }
+
+    ecs_col_system_begin_run(world, system_data);
+
+    EcsColSystem **elem = ecs_vector_add(
+        &world->job_batch, &system_ptr_arr_params);
+    *elem = system_data;
 }
 
 void ecs_run_jobs(
     ecs_world_t *world)
 {
+    ecs_thread_t *threads = ecs_vector_first(world->worker_threads);
+    uint32_t i, thread_count = ecs_vector_count(world->worker_threads);
+
     /* Make sure threads are ready to accept jobs */
     wait_for_threads(world);
 
+    world->workers_busy = thread_count - 1;
+
+    /* Publish jobs. Workers that are spinning pick up the new generation
+     * without locking, parked workers need to be signalled. */
     ecs_os_mutex_lock(world->thread_mutex);
-    world->jobs_finished = 0;
-    ecs_os_cond_broadcast(world->thread_cond);
+    ecs_os_ainc(&world->job_generation);
+    if (world->threads_parked) {
+        ecs_os_cond_broadcast(world->thread_cond);
+    }
     ecs_os_mutex_unlock(world->thread_mutex);
 
-    /* Run job for thread 0 in main thread */
-    ecs_thread_t *thread = ecs_vector_first(world->worker_threads);
-    ecs_job_t **jobs = thread->jobs;
-    uint32_t i, job_count = thread->job_count;
-
-    for (i = 0; i < job_count; i ++) {
-        ecs_run_w_filter(
-            (ecs_world_t*)thread, jobs[i]->system, world->delta_time, jobs[i]->offset, jobs[i]->limit, 0, NULL);
+    /* Main thread runs the tasks, then runs jobs of thread 0 and steals from
+     * other threads */
+    ecs_job_t **main_jobs = ecs_vector_first(world->main_jobs);
+    uint32_t main_job_count = ecs_vector_count(world->main_jobs);
+    for (i = 0; i < main_job_count; i ++) {
+        run_job(world, &threads[0], main_jobs[i]);
     }
-    thread->job_count = 0;
 
-    if (world->jobs_finished != ecs_vector_count(world->worker_threads) - 1) {
-        wait_for_jobs(world);
+    run_jobs(world, &threads[0]);
+
+    wait_for_jobs(world);
+
+    /* All workers are done, queues can be safely reset */
+    for (i = 0; i < thread_count; i ++) {
+        ecs_vector_clear(threads[i].jobs);
+        threads[i].job_head = 0;
     }
+
+    ecs_vector_clear(world->job_batch);
+    ecs_vector_clear(world->main_jobs);
 }
 
 
@@ -287,6 +527,8 @@ void ecs_set_threads(
 {
     ecs_assert(!threads || ecs_os_api.thread_new, ECS_MISSING_OS_API, "thread_new");
     ecs_assert(!threads || ecs_os_api.thread_join, ECS_MISSING_OS_API, "thread_join");
+    ecs_assert(!threads || ecs_os_api.ainc, ECS_MISSING_OS_API, "ainc");
+    ecs_assert(!threads || ecs_os_api.adec, ECS_MISSING_OS_API, "adec");
     ecs_assert(!threads || ecs_os_api.mutex_new, ECS_MISSING_OS_API, "mutex_new");
     ecs_assert(!threads || ecs_os_api.mutex_free, ECS_MISSING_OS_API, "mutex_free");
     ecs_assert(!threads || ecs_os_api.mutex_lock, ECS_MISSING_OS_API, "mutex_lock");
@@ -125,19 +125,35 @@ ecs_table_t* bootstrap_component_table(
     ecs_table_t *result = ecs_chunked_add(stage->tables, ecs_table_t);
     result->type = world->t_component;
     result->frame_systems = NULL;
+    result->queries = NULL;
+    result->time_spent = 0;
+    result->depth = 0;
     result->flags = 0;
     result->flags |= EcsTableHasBuiltins;
+    result->flags |= EcsTableIsMainStage;
+    result->lo_edges = NULL;
+    result->hi_edges = NULL;
     result->columns = ecs_os_malloc(sizeof(ecs_table_column_t) * 3);
     ecs_assert(result->columns != NULL, ECS_OUT_OF_MEMORY, NULL);
 
     result->columns[0].data = ecs_vector_new(&handle_arr_params, 16);
     result->columns[0].size = sizeof(ecs_entity_t);
+    result->columns[0].alignment = 0;
+    result->columns[0].changed = 0;
     result->columns[1].data = ecs_vector_new(&handle_arr_params, 16);
     result->columns[1].size = sizeof(EcsComponent);
+    result->columns[1].alignment = 0;
+    result->columns[1].changed = 0;
     result->columns[2].data = ecs_vector_new(&handle_arr_params, 16);
     result->columns[2].size = sizeof(EcsId);
+    result->columns[2].alignment = 0;
+    result->columns[2].changed = 0;
+    result->row_size = sizeof(EcsComponent) + sizeof(EcsId);
+    result->entity_memory = (ecs_memory_stat_t){0};
+    result->component_memory = (ecs_memory_stat_t){0};
 
     set_table(stage, world->t_component, result);
+    ecs_table_update_memory(world, result);
 
     return result;
 }
@@ -158,14 +174,17 @@ void bootstrap_component(
 
     /* Create record in entity index */
     ecs_row_t row = {.type = world->t_component, .index = index};
-    ecs_map_set(stage->entity_index, entity, &row);
+    ecs_ei_set(stage->entity_index, entity, &row);
 
     /* Set size and id */
     EcsComponent *component_data = ecs_vector_first(table->columns[1].data);
     EcsId *id_data = ecs_vector_first(table->columns[2].data);
     
     component_data[index - 1].size = size;
+    component_data[index - 1].alignment = 0;
     id_data[index - 1] = id;
+
+    ecs_name_index_add(stage->name_index, entity, world->t_component, id);
 }
 
 static
@@ -182,10 +201,35 @@ void notify_create_table(
     }
 }
 
+/** Add table to the component index for each entity in its type. This includes
+ * CHILDOF and INSTANCEOF elements, so tables that refer to a container or a
+ * prefab can be found without scanning all tables. */
+static
+void index_table(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    ecs_entity_t *array = ecs_vector_first(table->type);
+    uint32_t i, count = ecs_vector_count(table->type);
+
+    for (i = 0; i < count; i ++) {
+        ecs_vector_t *tables = NULL;
+        ecs_map_has(world->component_tables, array[i], &tables);
+
+        ecs_table_t **elem = ecs_vector_add(&tables, &ptr_params);
+        *elem = table;
+
+        /* Always set the entry, as vector may have been realloc'd */
+        ecs_map_set(world->component_tables, array[i], &tables);
+    }
+}
+
 void ecs_notify_systems_of_table(
     ecs_world_t *world,
     ecs_table_t *table)
 {
+    index_table(world, table);
+
     notify_create_table(world, world->pre_update_systems, table);
     notify_create_table(world, world->post_update_systems, table);
     notify_create_table(world, world->on_load_systems, table);
@@ -196,6 +240,8 @@ void ecs_notify_systems_of_table(
     notify_create_table(world, world->on_update_systems, table);
     notify_create_table(world, world->manual_systems, table);
     notify_create_table(world, world->inactive_systems, table);
+
+    ecs_queries_notify_of_table(world, table);
 }
 
 /** Create a new table and register it with the world and systems. A table in
@@ -448,6 +494,10 @@ void col_systems_deinit(
 
         ecs_vector_free(ptr->inactive_tables);
         ecs_vector_free(ptr->tables);
+
+        if (ptr->table_index) {
+            ecs_map_free(ptr->table_index);
+        }
     }
 }
 
@@ -464,6 +514,16 @@ void row_systems_deinit(
         ecs_os_free(ptr->base.signature);
         ecs_vector_free(ptr->base.columns);
         ecs_vector_free(ptr->components);
+
+        if (ptr->tables) {
+            ecs_map_iter_t it = ecs_map_iter(ptr->tables);
+            while (ecs_map_hasnext(&it)) {
+                ecs_row_system_table_t *table = ecs_map_next(&it);
+                ecs_os_free(table->columns);
+                ecs_os_free(table->references);
+            }
+            ecs_map_free(ptr->tables);
+        }
     }
 }
 
@@ -560,6 +620,46 @@ void EcsInitPrefab(ecs_rows_t *rows) {
     }
 }
 
+void EcsSetId(ecs_rows_t *rows) {
+    ecs_world_t *world = rows->world;
+    ecs_stage_t *stage = ecs_get_stage(&world);
+    ecs_table_t *table = rows->table;
+
+    ECS_COLUMN(rows, EcsId, id, 1);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_name_index_add(
+            stage->name_index, rows->entities[i], table->type, id[i]);
+    }
+}
+
+void EcsRemoveId(ecs_rows_t *rows) {
+    ecs_world_t *world = rows->world;
+    ecs_stage_t *stage = ecs_get_stage(&world);
+    ecs_table_t *table = rows->table;
+
+    /* The main stage index is only modified when not in progress. Entries that
+     * are not removed here are purged when they are looked up. */
+    if (stage != &world->main_stage) {
+        return;
+    }
+
+    /* The index is cleared before the tables of a world are deleted, which
+     * may contain cloned entities of which the EcsId was never set */
+    if (!ecs_map_count(stage->name_index)) {
+        return;
+    }
+
+    ECS_COLUMN(rows, EcsId, id, 1);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_name_index_remove(
+            stage->name_index, rows->entities[i], table->type, id[i]);
+    }
+}
+
 void EcsSetPrefab(ecs_rows_t *rows) {
     ecs_world_t *world = rows->world;
 
@@ -681,18 +781,25 @@ ecs_world_t *ecs_init(void) {
     world->remove_systems = ecs_vector_new(&handle_arr_params, 0);
     world->set_systems = ecs_vector_new(&handle_arr_params, 0);
     world->fini_tasks = ecs_vector_new(&handle_arr_params, 0);
+    world->queries = NULL;
 
     world->type_sys_add_index = ecs_map_new(0, sizeof(ecs_vector_t*));
     world->type_sys_remove_index = ecs_map_new(0, sizeof(ecs_vector_t*));
     world->type_sys_set_index = ecs_map_new(0, sizeof(ecs_vector_t*));
     world->type_handles = ecs_map_new(0, sizeof(ecs_entity_t));
+    world->component_tables = ecs_map_new(0, sizeof(ecs_vector_t*));
     world->prefab_parent_index = ecs_map_new(0, sizeof(ecs_entity_t));
     world->on_activate_components = ecs_map_new(0, sizeof(ecs_on_demand_in_t));
     world->on_enable_components = ecs_map_new(0, sizeof(ecs_on_demand_in_t));
 
     world->worker_stages = NULL;
+    world->images = NULL;
     world->worker_threads = NULL;
-    world->jobs_finished = 0;
+    world->job_batch = NULL;
+    world->main_jobs = NULL;
+    world->job_generation = 0;
+    world->workers_busy = 0;
+    world->threads_parked = 0;
     world->threads_running = 0;
     world->valid_schedule = false;
     world->quit_workers = false;
@@ -704,6 +811,14 @@ ecs_world_t *ecs_init(void) {
     world->last_handle = 0;
     world->should_quit = false;
     world->should_match = false;
+    world->should_match_all = false;
+    world->match_entities = NULL;
+    world->ref_version = 0;
+    world->change_tick = 1;
+
+    world->trace_enabled = false;
+    world->trace_capacity = 0;
+    world->trace_buffer = (ecs_trace_buffer_t){0};
 
     world->frame_start_time = (ecs_time_t){0, 0};
     if (time_ok) {
@@ -717,6 +832,8 @@ ecs_world_t *ecs_init(void) {
     world->merge_time_total = 0;
     world->frame_count_total = 0;
     world->world_time_total = 0;
+    world->entity_memory = (ecs_memory_stat_t){0};
+    world->component_memory = (ecs_memory_stat_t){0};
 
     world->context = NULL;
 
@@ -732,6 +849,7 @@ ecs_world_t *ecs_init(void) {
     /* Create table that will hold components (EcsComponent, EcsId) */
     ecs_table_t *table = bootstrap_component_table(world);
     assert(table != NULL);
+    index_table(world, table);
 
     /* Create records for internal components */
     bootstrap_component(world, table, EEcsComponent, ECS_COMPONENT_ID, sizeof(EcsComponent));
@@ -752,6 +870,10 @@ ecs_world_t *ecs_init(void) {
 
     ecs_new_system(world, "EcsInitPrefab", EcsOnAdd, "EcsPrefab", EcsInitPrefab);
     ecs_new_system(world, "EcsSetPrefab", EcsOnSet, "EcsPrefab", EcsSetPrefab);
+    ecs_new_system(world, "EcsSetId", EcsOnSet, 
+        "EcsId, ?EcsPrefab, ?EcsDisabled", EcsSetId);
+    ecs_new_system(world, "EcsRemoveId", EcsOnRemove, 
+        "EcsId, ?EcsPrefab, ?EcsDisabled", EcsRemoveId);
 
     /* Create type that allows for quickly checking if a type contains builtin
      * components. */
@@ -762,6 +884,9 @@ ecs_world_t *ecs_init(void) {
     /* Initialize EcsWorld */
     ecs_set(world, EcsWorld, EcsId, {"EcsWorld"});
 
+    /* Builtin systems were named before EcsSetId could index their names */
+    ecs_name_index_rebuild(world);
+
     return world;
 }
 
@@ -870,6 +995,10 @@ int ecs_fini(
         ecs_set_threads(world, 0);
     }
 
+    /* No lookups happen after this point, don't maintain the name index while
+     * deleting the tables */
+    ecs_name_index_clear(world->main_stage.name_index);
+
     deinit_tables(world);
 
     col_systems_deinit_handlers(world, world->on_update_systems);
@@ -901,12 +1030,17 @@ int ecs_fini(
     row_index_deinit(world->type_sys_add_index);
     row_index_deinit(world->type_sys_remove_index);
     row_index_deinit(world->type_sys_set_index);
+    row_index_deinit(world->component_tables);
+    ecs_queries_fini(world);
     ecs_map_free(world->type_handles);
     ecs_map_free(world->prefab_parent_index);
 
     ecs_stage_deinit(world, &world->main_stage);
     ecs_stage_deinit(world, &world->temp_stage);
 
+    /* Images own column data, release them after the tables are freed */
+    ecs_image_fini(world);
+
     on_demand_in_map_deinit(world->on_activate_components);
     on_demand_in_map_deinit(world->on_enable_components);
 
@@ -922,6 +1056,9 @@ int ecs_fini(
     ecs_vector_free(world->inactive_systems);
     ecs_vector_free(world->manual_systems);
     ecs_vector_free(world->fini_tasks);
+    ecs_vector_free(world->match_entities);
+
+    ecs_trace_buffer_free(&world->trace_buffer);
 
     ecs_vector_free(world->add_systems);
     ecs_vector_free(world->remove_systems);
@@ -945,7 +1082,7 @@ void ecs_dim(
     uint32_t entity_count)
 {
     assert(world->magic == ECS_WORLD_MAGIC);
-    ecs_map_set_size(world->main_stage.entity_index, entity_count);
+    ecs_ei_grow(world->main_stage.entity_index, entity_count);
 }
 
 void _ecs_dim_type(
@@ -957,83 +1094,17 @@ void _ecs_dim_type(
     if (type) {
         ecs_table_t *table = ecs_world_get_table(world, &world->main_stage, type);
         if (table) {
-            ecs_table_dim(table, NULL, entity_count);
+            ecs_table_dim(world, table, NULL, entity_count);
         }
     }
 }
 
-static
-ecs_entity_t ecs_lookup_child_in_columns(
-    ecs_type_t type,
-    ecs_table_column_t *columns,
-    ecs_entity_t parent,
-    const char *id)
-{
-    int16_t column_index;
-
-    if ((column_index = ecs_type_index_of(type, EEcsId)) == -1) {
-        return 0;
-    }
-
-    if (parent && ecs_type_index_of(type, parent) == -1) {
-        return 0;
-    }
-
-    ecs_table_column_t *column = &columns[column_index + 1];
-    EcsId *buffer = ecs_vector_first(column->data);
-    uint32_t i, count = ecs_vector_count(column->data);
-    
-    for (i = 0; i < count; i ++) {
-        if (!buffer[i]) {
-            continue;
-        }
-        
-        if (!strcmp(buffer[i], id)) {
-            return *(ecs_entity_t*)ecs_vector_get(
-                columns[0].data, &handle_arr_params, i);
-        }
-    }
-
-    return 0;
-}
-
 ecs_entity_t ecs_lookup_child(
     ecs_world_t *world,
     ecs_entity_t parent,
     const char *id)
 {
-    ecs_stage_t *stage = ecs_get_stage(&world);
-    ecs_entity_t result = 0;
-
-    if (stage != &world->main_stage) {
-        ecs_map_iter_t it = ecs_map_iter(stage->data_stage);
-
-        while (ecs_map_hasnext(&it)) {
-            uint64_t key;
-            ecs_table_column_t *columns = ecs_map_nextptr_w_key(&it, &key);
-            ecs_type_t key_type = (ecs_type_t)(uintptr_t)key;
-            result = ecs_lookup_child_in_columns(key_type, columns, parent, id);
-            if (result) {
-                break;
-            }
-        }
-    }
-
-    if (!result) {
-        ecs_chunked_t *tables = world->main_stage.tables;
-        uint32_t t, count = ecs_chunked_count(tables);
-
-        for (t = 0; t < count; t ++) {
-            ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, t);
-            result = ecs_lookup_child_in_columns(
-                table->type, table->columns, parent, id);
-            if (result) {
-                break;
-            }
-        }
-    }
-
-    return result;
+    return ecs_name_index_lookup(world, parent, id);
 }
 
 ecs_entity_t ecs_lookup(
@@ -1082,6 +1153,170 @@ void rematch_systems(
     rematch_system_array(world, world->pre_store_systems);
     rematch_system_array(world, world->on_store_systems);    
     rematch_system_array(world, world->inactive_systems);   
+
+    ecs_queries_rematch(world, NULL);
+}
+
+/** Add tables that refer to an entity with CHILDOF or INSTANCEOF. Watched
+ * entities that inherit from the entity are added to the queue, as the tables
+ * that refer to them may inherit components from the entity. */
+static
+void find_affected_tables(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_map_t *visited,
+    ecs_vector_t **queue,
+    ecs_vector_t **tables)
+{
+    ecs_vector_t *refs = NULL;
+
+    if (ecs_map_has(world->component_tables, entity | ECS_CHILDOF, &refs)) {
+        ecs_table_t **buffer = ecs_vector_first(refs);
+        uint32_t i, count = ecs_vector_count(refs);
+
+        for (i = 0; i < count; i ++) {
+            if (!ecs_map_get_ptr(visited, (uintptr_t)buffer[i])) {
+                ecs_map_set(visited, (uintptr_t)buffer[i], &(bool){true});
+                ecs_table_t **elem = ecs_vector_add(tables, &ptr_params);
+                *elem = buffer[i];
+            }
+        }
+    }
+
+    if (ecs_map_has(world->component_tables, entity | ECS_INSTANCEOF, &refs)) {
+        ecs_table_t **buffer = ecs_vector_first(refs);
+        uint32_t i, count = ecs_vector_count(refs);
+
+        for (i = 0; i < count; i ++) {
+            ecs_table_t *table = buffer[i];
+            if (ecs_map_get_ptr(visited, (uintptr_t)table)) {
+                continue;
+            }
+
+            ecs_map_set(visited, (uintptr_t)table, &(bool){true});
+            ecs_table_t **elem = ecs_vector_add(tables, &ptr_params);
+            *elem = table;
+
+            ecs_entity_t *entities = ecs_vector_first(table->columns[0].data);
+            uint32_t e, e_count = ecs_vector_count(table->columns[0].data);
+
+            for (e = 0; e < e_count; e ++) {
+                ecs_row_t *row = ecs_ei_get(
+                    world->main_stage.entity_index, entities[e]);
+
+                if (row && row->index < 0) {
+                    ecs_entity_t *q = ecs_vector_add(queue, &handle_arr_params);
+                    *q = entities[e];
+                }
+            }
+        }
+    }
+}
+
+static
+void rematch_entity_array(
+    ecs_world_t *world,
+    ecs_vector_t *systems,
+    ecs_vector_t *entities,
+    ecs_vector_t *tables)
+{
+    uint32_t i, count = ecs_vector_count(systems);
+    ecs_entity_t *buffer = ecs_vector_first(systems);
+    ecs_entity_t *changed = ecs_vector_first(entities);
+    uint32_t c, changed_count = ecs_vector_count(entities);
+
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t system = buffer[i];
+
+        /* Systems that use a changed entity as source can match with any
+         * table, so they are matched with all tables */
+        for (c = 0; c < changed_count; c ++) {
+            if (ecs_system_refers_to(world, system, changed[c])) {
+                break;
+            }
+        }
+
+        if (c != changed_count) {
+            ecs_rematch_system(world, system);
+        } else {
+            ecs_rematch_system_w_tables(world, system, tables);
+        }
+
+        if (system != buffer[i]) {
+            /* Rematching may have moved the system to another array */
+            i --;
+            count = ecs_vector_count(systems);
+        }
+    }
+}
+
+/** Only rematch the tables that are affected by the watched entities that
+ * changed their type, instead of rematching all systems with all tables */
+static
+void rematch_entities(
+    ecs_world_t *world)
+{
+    ecs_map_t *visited = ecs_map_new(0, sizeof(bool));
+    ecs_map_t *entities = ecs_map_new(0, sizeof(bool));
+    ecs_vector_t *queue = NULL, *changed = NULL, *tables = NULL;
+
+    ecs_vector_t *match_entities = world->match_entities;
+    ecs_entity_t *buffer = ecs_vector_first(match_entities);
+    uint32_t i, count = ecs_vector_count(match_entities);
+
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t *elem = ecs_vector_add(&queue, &handle_arr_params);
+        *elem = buffer[i];
+    }
+
+    /* Queue may grow while tables are being collected */
+    for (i = 0; i < ecs_vector_count(queue); i ++) {
+        ecs_entity_t e = ((ecs_entity_t*)ecs_vector_first(queue))[i];
+
+        if (ecs_map_get_ptr(entities, e)) {
+            continue;
+        }
+
+        ecs_map_set(entities, e, &(bool){true});
+        ecs_entity_t *elem = ecs_vector_add(&changed, &handle_arr_params);
+        *elem = e;
+
+        find_affected_tables(world, e, visited, &queue, &tables);
+    }
+
+    rematch_entity_array(world, world->on_load_systems, changed, tables);
+    rematch_entity_array(world, world->post_load_systems, changed, tables);
+    rematch_entity_array(world, world->pre_update_systems, changed, tables);
+    rematch_entity_array(world, world->on_update_systems, changed, tables);
+    rematch_entity_array(world, world->on_validate_systems, changed, tables);
+    rematch_entity_array(world, world->post_update_systems, changed, tables);
+    rematch_entity_array(world, world->pre_store_systems, changed, tables);
+    rematch_entity_array(world, world->on_store_systems, changed, tables);
+    rematch_entity_array(world, world->inactive_systems, changed, tables);
+
+    ecs_queries_rematch(world, tables);
+
+    ecs_vector_free(queue);
+    ecs_vector_free(changed);
+    ecs_vector_free(tables);
+    ecs_map_free(visited);
+    ecs_map_free(entities);
+}
+
+void ecs_world_rematch(
+    ecs_world_t *world)
+{
+    if (world->should_match) {
+        if (world->should_match_all) {
+            rematch_systems(world);
+        } else {
+            rematch_entities(world);
+        }
+
+        ecs_vector_clear(world->match_entities);
+        world->should_match = false;
+        world->should_match_all = false;
+    }
 }
 
 static
@@ -1116,6 +1351,7 @@ void revalidate_system_refs(
 static
 void run_single_thread_stage(
     ecs_world_t *world,
+    const char *phase,
     ecs_vector_t *systems,
     bool staged)
 {
@@ -1124,6 +1360,12 @@ void run_single_thread_stage(
     if (system_count) {
         ecs_entity_t *buffer = ecs_vector_first(systems);
 
+        ecs_trace_buffer_t *trace = ecs_trace_get_buffer(world);
+        ecs_time_t trace_start;
+        if (trace) {
+            ecs_os_get_time(&trace_start);
+        }
+
         if (staged) {
             world->in_progress = true;
         }
@@ -1143,12 +1385,18 @@ void run_single_thread_stage(
             ecs_merge(world);
             world->in_progress = true;
         }
+
+        if (trace) {
+            ecs_trace_push(
+                trace, EcsTracePhase, phase, trace_start, system_count, 0);
+        }
     }
 }
 
 static
 void run_multi_thread_stage(
     ecs_world_t *world,
+    const char *phase,
     ecs_vector_t *systems)
 {
     /* Run periodic table systems */
@@ -1157,18 +1405,32 @@ void run_multi_thread_stage(
         bool valid_schedule = world->valid_schedule;
         ecs_entity_t *buffer = ecs_vector_first(systems);
 
+        ecs_trace_buffer_t *trace = ecs_trace_get_buffer(world);
+        ecs_time_t trace_start;
+        if (trace) {
+            ecs_os_get_time(&trace_start);
+        }
+
         world->in_progress = true;
 
+        ecs_time_t start;
+        ecs_time_measure(&start);
+
+        /* Systems are added to a batch until a system is found that reads data
+         * written by, or writes data accessed by a system in the batch. Jobs
+         * in the batch are then ran before starting a new batch, so that
+         * conflicting systems never run at the same time. */
         for (i = 0; i < system_count; i ++) {
+            if (ecs_jobs_conflict(world, buffer[i])) {
+                ecs_run_jobs(world);
+            }
+
             if (!valid_schedule) {
                 ecs_schedule_jobs(world, buffer[i]);
             }
             ecs_prepare_jobs(world, buffer[i]);
         }
 
-        ecs_time_t start;
-        ecs_time_measure(&start);
-
         ecs_run_jobs(world);
 
         world->system_time_total += ecs_time_measure(&start);
@@ -1178,6 +1440,11 @@ void run_multi_thread_stage(
             ecs_merge(world);
             world->in_progress = true;
         }
+
+        if (trace) {
+            ecs_trace_push(
+                trace, EcsTracePhase, phase, trace_start, system_count, 0);
+        }
     }
 }
 
@@ -1257,11 +1524,14 @@ bool ecs_progress(
 
     bool has_threads = ecs_vector_count(world->worker_threads) != 0;
 
-    if (world->should_match) {
-        rematch_systems(world);
-        world->should_match = false;
+    ecs_trace_buffer_t *trace = ecs_trace_get_buffer(world);
+    ecs_time_t trace_start;
+    if (trace) {
+        ecs_os_get_time(&trace_start);
     }
 
+    ecs_world_rematch(world);
+
     if (world->should_resolve) {
         revalidate_system_refs(world);
         world->should_resolve = false;
@@ -1269,26 +1539,34 @@ bool ecs_progress(
 
     /* -- System execution starts here -- */
 
-    run_single_thread_stage(world, world->on_load_systems, true);
-    run_single_thread_stage(world, world->post_load_systems, true);
+    run_single_thread_stage(world, "OnLoad", world->on_load_systems, true);
+    run_single_thread_stage(world, "PostLoad", world->post_load_systems, true);
 
     if (has_threads) {
-        run_multi_thread_stage(world, world->pre_update_systems);
-        run_multi_thread_stage(world, world->on_update_systems);
-        run_multi_thread_stage(world, world->on_validate_systems);
-        run_multi_thread_stage(world, world->post_update_systems);
+        run_multi_thread_stage(world, "PreUpdate", world->pre_update_systems);
+        run_multi_thread_stage(world, "OnUpdate", world->on_update_systems);
+        run_multi_thread_stage(world, "OnValidate", world->on_validate_systems);
+        run_multi_thread_stage(world, "PostUpdate", world->post_update_systems);
     } else {
-        run_single_thread_stage(world, world->pre_update_systems, true);
-        run_single_thread_stage(world, world->on_update_systems, true);
-        run_single_thread_stage(world, world->on_validate_systems, true);
-        run_single_thread_stage(world, world->post_update_systems, true);
+        run_single_thread_stage(
+            world, "PreUpdate", world->pre_update_systems, true);
+        run_single_thread_stage(
+            world, "OnUpdate", world->on_update_systems, true);
+        run_single_thread_stage(
+            world, "OnValidate", world->on_validate_systems, true);
+        run_single_thread_stage(
+            world, "PostUpdate", world->post_update_systems, true);
     }
 
-    run_single_thread_stage(world, world->pre_store_systems, true);
-    run_single_thread_stage(world, world->on_store_systems, true);
+    run_single_thread_stage(world, "PreStore", world->pre_store_systems, true);
+    run_single_thread_stage(world, "OnStore", world->on_store_systems, true);
 
     /* -- System execution stops here -- */
 
+    if (trace) {
+        ecs_trace_push(trace, EcsTraceFrame, "frame", trace_start, 0, 0);
+    }
+
     world->frame_count_total ++;
     
     stop_measure_frame(world, delta_time);
@@ -1331,6 +1609,35 @@ void ecs_quit(
     world->should_quit = true;
 }
 
+/** Merge a stage, and keep track of the time spent merging it */
+static
+void merge_stage(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    int32_t stage_index,
+    bool measure_time)
+{
+    ecs_trace_buffer_t *trace = ecs_trace_get_buffer(world);
+    ecs_time_t t_start;
+    if (measure_time || trace) {
+        ecs_os_get_time(&t_start);
+    }
+
+    ecs_stage_merge(world, stage);
+
+    if (trace) {
+        ecs_trace_push(
+            trace, EcsTraceMerge, "merge_stage", t_start, stage_index, 0);
+    }
+
+    if (measure_time) {
+        double t = ecs_time_measure(&t_start);
+        ecs_time_histogram_record(&stage->merge_histogram, t);
+        stage->merge_time_total += t;
+        stage->merge_count_total ++;
+    }
+}
+
 void ecs_merge(
     ecs_world_t *world)
 {
@@ -1341,21 +1648,27 @@ void ecs_merge(
 
     world->is_merging = true;
 
+    ecs_trace_buffer_t *trace = ecs_trace_get_buffer(world);
     ecs_time_t t_start;
-    if (measure_frame_time) {
+    if (measure_frame_time || trace) {
         ecs_os_get_time(&t_start);
     }
 
-    ecs_stage_merge(world, &world->temp_stage);
+    /* Stage 0 is the temporary stage, worker stages start at 1 */
+    merge_stage(world, &world->temp_stage, 0, measure_frame_time);
 
     uint32_t i, count = ecs_vector_count(world->worker_stages);
     if (count) {
         ecs_stage_t *buffer = ecs_vector_first(world->worker_stages);
         for (i = 0; i < count; i ++) {
-            ecs_stage_merge(world, &buffer[i]);
+            merge_stage(world, &buffer[i], i + 1, measure_frame_time);
         }
     }
 
+    if (trace) {
+        ecs_trace_push(trace, EcsTraceMerge, "merge", t_start, -1, 0);
+    }
+
     if (measure_frame_time) {
         world->merge_time_total += ecs_time_measure(&t_start);
     }
@@ -14,23 +14,25 @@ void ecs_name_writer_alloc(
     writer->written = 0;
 }
 
+/** Copy as much of a name as is available in the buffer. Returns the number of
+ * bytes consumed, which includes the padding at the end of the name. */
 static
-bool ecs_name_writer_write(
+size_t ecs_name_writer_write(
     ecs_name_writer_t *writer,
-    const char *buffer)
+    const char *buffer,
+    size_t size)
 {
-    int32_t written = writer->len - writer->written;
+    size_t written = writer->len - writer->written;
     char *name_ptr = ECS_OFFSET(writer->name, writer->written);
 
-    if (written >= sizeof(int32_t)) {
-        *(int32_t*)name_ptr = *(int32_t*)buffer;
-        writer->written += sizeof(int32_t);
-        return writer->written != writer->len;
-    } else {
-        memcpy(name_ptr, buffer, written);
-        writer->written += written;
-        return false;
+    if (written > size) {
+        written = size;
     }
+
+    memcpy(name_ptr, buffer, written);
+    writer->written += written;
+
+    return (((written - 1) / sizeof(int32_t)) + 1) * sizeof(int32_t);
 }
 
 static
@@ -62,9 +64,17 @@ int ecs_component_writer_register_component(
         }
 
         _ecs_add(world, id, world->t_component);
-        ecs_set(world, id, EcsComponent, {writer->size});
+        ecs_set(world, id, EcsComponent, {
+            .size = writer->size, 
+            .alignment = writer->alignment
+        });
         ecs_set(world, id, EcsId, {name});
 
+        /* Make sure new entities don't reuse the component id */
+        if (id >= world->last_handle) {
+            world->last_handle = id + 1;
+        }
+
         /* Don't overwrite component name */
         ecs_name_writer_reset(&writer->name);        
     } else {
@@ -73,7 +83,9 @@ int ecs_component_writer_register_component(
             goto error;
         } else {
             EcsComponent *cdata = ecs_get_ptr(world, id, EcsComponent);
-            if (cdata->size != writer->size) {
+            if (cdata->size != writer->size || 
+                cdata->alignment != writer->alignment) 
+            {
                 stream->error = ECS_DESERIALIZE_COMPONENT_SIZE_CONFLICT;
                 goto error;
             } else {
@@ -98,6 +110,9 @@ void ecs_component_writer_next(
         writer->state = EcsComponentSize;
         break;
     case EcsComponentSize:
+        writer->state = EcsComponentAlignment;
+        break;
+    case EcsComponentAlignment:
         writer->state = EcsComponentNameLength;
         break;
     case EcsComponentNameLength:
@@ -142,6 +157,12 @@ size_t ecs_component_writer(
         ecs_component_writer_next(stream);  
         break;
 
+    case EcsComponentAlignment:
+        writer->alignment = *(int32_t*)buffer;
+        written = sizeof(int32_t);
+        ecs_component_writer_next(stream);  
+        break;
+
     case EcsComponentNameLength:
         ecs_name_writer_alloc(&writer->name, *(int32_t*)buffer);
         written = sizeof(int32_t);
@@ -149,8 +170,8 @@ size_t ecs_component_writer(
         break;
 
     case EcsComponentName: {
-        written = sizeof(int32_t);
-        if (!ecs_name_writer_write(&writer->name, buffer)) {
+        written = ecs_name_writer_write(&writer->name, buffer, size);
+        if (writer->name.written == writer->name.len) {
             if (ecs_component_writer_register_component(stream)) {
                 goto error;
             }
@@ -183,12 +204,7 @@ void ecs_table_writer_register_table(
     writer->table = ecs_world_get_table(world, &world->main_stage, type);
 
     /* Remove any existing entities from entity index */
-    ecs_vector_t *entity_vector = writer->table->columns[0].data;
-    ecs_entity_t *entities = ecs_vector_first(entity_vector);
-    int32_t i, count = ecs_vector_count(entity_vector);
-    for (i = 0; i < count; i ++) {
-        ecs_map_remove(world->main_stage.entity_index, entities[i]);
-    }
+    ecs_table_unregister_entities(world, writer->table);
 
     ecs_assert(writer->table != NULL, ECS_INTERNAL_ERROR, NULL);
 }
@@ -201,33 +217,12 @@ void ecs_table_writer_finalize_table(
     ecs_table_writer_t *writer = &stream->table;
 
     /* Register entities in table in entity index */
-    ecs_vector_t *entity_vector = writer->table->columns[0].data;
-    ecs_entity_t *entities = ecs_vector_first(entity_vector);
-    int32_t i, count = ecs_vector_count(entity_vector);
-
-    for (i = 0; i < count; i ++) {
-        ecs_row_t row;
-        if (ecs_map_has(world->main_stage.entity_index, entities[i], &row)) {
-            if (row.type != writer->table->type) {
-                ecs_table_t *table = ecs_world_get_table(world, &world->main_stage, row.type);
-                ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
-
-                ecs_table_delete(world, &world->main_stage, 
-                    table, table->columns, row.index);
-            }
-        }
+    ecs_table_register_entities(world, writer->table);
 
-        row = (ecs_row_t){
-            .index = i + 1,
-            .type = writer->table->type
-        };
+    /* Columns were resized while writing */
+    ecs_table_update_memory(world, writer->table);
 
-        ecs_map_set(world->main_stage.entity_index, entities[i], &row);
-
-        if (entities[i] >= world->last_handle) {
-            world->last_handle = entities[i] + 1;
-        }
-    }   
+    ecs_name_index_add_table(world->main_stage.name_index, writer->table);
 }
 
 static
@@ -240,8 +235,14 @@ void ecs_table_writer_prepare_column(
     writer->column = &writer->table->columns[writer->column_index];
     writer->column_size = size;
 
+    /* The column may be shared with a snapshot */
+    ecs_table_detach_column(stream->world, writer->column);
+    writer->table->version ++;
+
     if (size) {
-        ecs_vector_params_t params = {.element_size = writer->column_size};
+        ecs_vector_params_t params = {
+            .element_size = writer->column_size,
+            .alignment = writer->column->alignment};
         ecs_vector_set_count(&writer->column->data, &params, writer->row_count);
     }
 
@@ -342,16 +343,22 @@ size_t ecs_table_writer(
         ecs_table_writer_next(stream);
         break;
 
-    case EcsTableType:
-        *(int32_t*)ECS_OFFSET(writer->type_array, writer->type_written) = *(int32_t*)buffer;
-        written = sizeof(int32_t);
+    case EcsTableType: {
+        uint32_t type_bytes = writer->type_count * sizeof(ecs_entity_t);
+        written = type_bytes - writer->type_written;
+        if (written > size) {
+            written = size;
+        }
+
+        memcpy(ECS_OFFSET(writer->type_array, writer->type_written), buffer, written);
         writer->type_written += written;
 
-        if (writer->type_written == writer->type_count * sizeof(ecs_entity_t)) {
+        if (writer->type_written == type_bytes) {
             ecs_table_writer_register_table(stream);
             ecs_table_writer_next(stream);
         }
         break;
+    }
 
     case EcsTableSize:
         writer->row_count = *(int32_t*)buffer;
@@ -413,8 +420,8 @@ size_t ecs_table_writer(
         break;
 
     case EcsTableColumnName: {
-        written = sizeof(int32_t);
-        if (!ecs_name_writer_write(&writer->name, buffer)) {
+        written = ecs_name_writer_write(&writer->name, buffer, size);
+        if (writer->name.written == writer->name.len) {
             ((EcsId*)writer->column_data)[writer->row_index] = writer->name.name;
 
             /* Don't overwrite entity name */
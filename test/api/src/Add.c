@@ -596,3 +596,42 @@ void Add_remove_entity() {
     
     ecs_fini(world);
 }
+
+void Add_add_remove_twice() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e_1 = ecs_set(world, 0, Position, {10, 20});
+    test_assert(e_1 != 0);
+
+    ecs_entity_t e_2 = ecs_set(world, 0, Position, {30, 40});
+    test_assert(e_2 != 0);
+
+    /* Second add and remove should take the same path as the first */
+    ecs_add(world, e_1, Velocity);
+    ecs_add(world, e_2, Velocity);
+    test_assert(ecs_has(world, e_1, Velocity));
+    test_assert(ecs_has(world, e_2, Velocity));
+    test_int(ecs_count(world, Velocity), 2);
+
+    ecs_remove(world, e_1, Velocity);
+    ecs_remove(world, e_2, Velocity);
+    test_assert(!ecs_has(world, e_1, Velocity));
+    test_assert(!ecs_has(world, e_2, Velocity));
+    test_int(ecs_count(world, Velocity), 0);
+    test_int(ecs_count(world, Position), 2);
+
+    Position *p = ecs_get_ptr(world, e_1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    p = ecs_get_ptr(world, e_2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+    
+    ecs_fini(world);
+}
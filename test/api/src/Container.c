@@ -423,3 +423,157 @@ void Container_singleton_as_container() {
 
     ecs_fini(world);
 }
+
+void Container_children_iter() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t parent = ecs_new(world, 0);
+    ecs_entity_t child_1 = ecs_new_child(world, parent, Position);
+    ecs_entity_t child_2 = ecs_new_child(world, parent, Position);
+    ecs_entity_t child_3 = ecs_new_child(world, parent, Velocity);
+    ecs_new(world, Position);
+
+    int32_t table_count = 0, count = 0;
+    bool found_1 = false, found_2 = false, found_3 = false;
+
+    ecs_children_iter_t it = ecs_children_iter(world, parent);
+    while (ecs_children_next(&it)) {
+        int32_t i;
+        for (i = 0; i < it.rows.count; i ++) {
+            ecs_entity_t e = it.rows.entities[i];
+            test_assert(ecs_contains(world, parent, e));
+            found_1 |= e == child_1;
+            found_2 |= e == child_2;
+            found_3 |= e == child_3;
+        }
+
+        table_count ++;
+        count += it.rows.count;
+    }
+
+    test_int(table_count, 2);
+    test_int(count, 3);
+    test_assert(found_1);
+    test_assert(found_2);
+    test_assert(found_3);
+
+    ecs_fini(world);
+}
+
+void Container_children_iter_no_children() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t parent = ecs_new(world, Position);
+    ecs_new(world, Position);
+
+    ecs_children_iter_t it = ecs_children_iter(world, parent);
+    test_assert(!ecs_children_next(&it));
+
+    ecs_fini(world);
+}
+
+void Container_children_iter_after_adopt_orphan() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t parent = ecs_new(world, 0);
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    ecs_entity_t e_2 = ecs_new(world, Position);
+
+    ecs_adopt(world, e_1, parent);
+    ecs_adopt(world, e_2, parent);
+    ecs_orphan(world, e_1, parent);
+
+    int32_t count = 0;
+    ecs_children_iter_t it = ecs_children_iter(world, parent);
+    while (ecs_children_next(&it)) {
+        test_int(it.rows.count, 1);
+        test_int(it.rows.entities[0], e_2);
+        count += it.rows.count;
+    }
+
+    test_int(count, 1);
+
+    /* Tables without children are skipped */
+    ecs_orphan(world, e_2, parent);
+
+    it = ecs_children_iter(world, parent);
+    test_assert(!ecs_children_next(&it));
+
+    ecs_fini(world);
+}
+
+void Container_children_iter_nested() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t parent = ecs_new(world, 0);
+    ecs_entity_t child = ecs_new_child(world, parent, Position);
+    ecs_entity_t grandchild = ecs_new_child(world, child, Position);
+
+    int32_t count = 0;
+    ecs_children_iter_t it = ecs_children_iter(world, parent);
+    while (ecs_children_next(&it)) {
+        test_int(it.rows.count, 1);
+        test_int(it.rows.entities[0], child);
+        count ++;
+    }
+
+    test_int(count, 1);
+
+    count = 0;
+    it = ecs_children_iter(world, child);
+    while (ecs_children_next(&it)) {
+        test_int(it.rows.count, 1);
+        test_int(it.rows.entities[0], grandchild);
+        count ++;
+    }
+
+    test_int(count, 1);
+
+    ecs_fini(world);
+}
+
+static
+void IterChildren(ecs_rows_t *rows) {
+    int32_t *count = rows->param;
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_children_iter_t it = ecs_children_iter(
+            rows->world, rows->entities[i]);
+        while (ecs_children_next(&it)) {
+            *count += it.rows.count;
+        }
+    }
+}
+
+void Container_children_iter_from_system() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Root);
+
+    ECS_SYSTEM(world, IterChildren, EcsOnUpdate, Root);
+
+    ecs_entity_t parent_1 = ecs_new(world, Root);
+    ecs_entity_t parent_2 = ecs_new(world, Root);
+    ecs_new_child_w_count(world, parent_1, Position, 3);
+    ecs_new_child_w_count(world, parent_2, Position, 2);
+
+    int32_t count = 0;
+    ecs_set_system_context(world, IterChildren, &count);
+
+    ecs_progress(world, 1);
+
+    test_int(count, 5);
+
+    ecs_fini(world);
+}
@@ -193,3 +193,140 @@ void Delete_delete_w_on_remove() {
     
     ecs_fini(world);
 }
+
+void Delete_delete_recycle() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    test_assert(e_1 != 0);
+    test_assert(ecs_is_alive(world, e_1));
+
+    ecs_delete(world, e_1);
+    test_assert(!ecs_is_alive(world, e_1));
+
+    ecs_entity_t e_2 = ecs_new(world, Position);
+    test_assert(e_2 != 0);
+    test_assert(e_2 != e_1);
+    test_assert((e_2 & ECS_ENTITY_INDEX_MASK) == e_1);
+    test_int(ECS_GENERATION(e_2), 1);
+
+    test_assert(ecs_is_alive(world, e_2));
+    test_assert(!ecs_is_alive(world, e_1));
+    test_assert(ecs_has(world, e_2, Position));
+
+    ecs_fini(world);
+}
+
+void Delete_delete_recycle_empty() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e_1 = ecs_new(world, 0);
+    test_assert(e_1 != 0);
+    test_assert(ecs_is_alive(world, e_1));
+
+    ecs_delete(world, e_1);
+    test_assert(!ecs_is_alive(world, e_1));
+
+    ecs_entity_t e_2 = ecs_new(world, 0);
+    test_assert((e_2 & ECS_ENTITY_INDEX_MASK) == e_1);
+    test_assert(ecs_is_alive(world, e_2));
+    test_assert(!ecs_is_alive(world, e_1));
+
+    ecs_fini(world);
+}
+
+void Delete_delete_stale_handle() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    ecs_delete(world, e_1);
+
+    ecs_entity_t e_2 = ecs_set(world, 0, Position, {10, 20});
+    test_assert((e_2 & ECS_ENTITY_INDEX_MASK) == e_1);
+
+    /* Deleting the stale handle must not delete the recycled entity */
+    ecs_delete(world, e_1);
+    test_assert(ecs_is_alive(world, e_2));
+    test_assert(ecs_has(world, e_2, Position));
+
+    Position *p = ecs_get_ptr(world, e_2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    /* The id is not recycled twice */
+    ecs_entity_t e_3 = ecs_new(world, 0);
+    test_assert((e_3 & ECS_ENTITY_INDEX_MASK) != e_1);
+
+    ecs_fini(world);
+}
+
+void Delete_get_stale_handle() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e_1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_delete(world, e_1);
+
+    ecs_entity_t e_2 = ecs_set(world, 0, Position, {30, 40});
+    test_assert((e_2 & ECS_ENTITY_INDEX_MASK) == e_1);
+
+    /* The stale handle must not resolve to the recycled entity */
+    test_assert(ecs_get_ptr(world, e_1, Position) == NULL);
+    test_assert(!ecs_has(world, e_1, Position));
+
+    Position *p = ecs_get_ptr(world, e_2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
+
+void Delete_delete_nonexist_is_alive() {
+    ecs_world_t *world = ecs_init();
+
+    test_assert(!ecs_is_alive(world, 0));
+    test_assert(!ecs_is_alive(world, 100000));
+
+    ecs_delete(world, 100000);
+
+    /* Deleting an id that was never issued does not make it recyclable */
+    ecs_entity_t e = ecs_new(world, 0);
+    test_assert(e != 100000);
+    test_int(ECS_GENERATION(e), 0);
+
+    ecs_fini(world);
+}
+
+void Delete_delete_in_progress_recycle() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, DeleteEntity, EcsOnUpdate, Position);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    ecs_entity_t e_2 = ecs_new(world, Position);
+
+    ecs_progress(world, 0);
+
+    test_assert(!ecs_is_alive(world, e_1));
+    test_assert(!ecs_is_alive(world, e_2));
+    test_int(ecs_count(world, Position), 0);
+
+    ecs_entity_t e_3 = ecs_new(world, 0);
+    ecs_entity_t e_4 = ecs_new(world, 0);
+
+    test_assert((e_3 & ECS_ENTITY_INDEX_MASK) == e_2);
+    test_assert((e_4 & ECS_ENTITY_INDEX_MASK) == e_1);
+    test_assert(ecs_is_alive(world, e_3));
+    test_assert(ecs_is_alive(world, e_4));
+
+    ecs_fini(world);
+}
@@ -179,3 +179,104 @@ void Lookup_get_id_from_empty() {
 
     ecs_fini(world);
 }
+
+void Lookup_lookup_after_rename() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsId, {"Foo"});
+    test_assert(ecs_lookup(world, "Foo") == e);
+
+    ecs_set(world, e, EcsId, {"Bar"});
+    test_assert(ecs_lookup(world, "Foo") == 0);
+    test_assert(ecs_lookup(world, "Bar") == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_delete() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsId, {"Foo"});
+    test_assert(ecs_lookup(world, "Foo") == e);
+
+    ecs_delete(world, e);
+    test_assert(ecs_lookup(world, "Foo") == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_remove_id() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsId, {"Foo"});
+    test_assert(ecs_lookup(world, "Foo") == e);
+
+    ecs_remove(world, e, EcsId);
+    test_assert(ecs_lookup(world, "Foo") == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_child_adopt_after_id() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ENTITY(world, Parent, 0);
+
+    ecs_entity_t e = ecs_set(world, 0, EcsId, {"Child"});
+    test_assert(ecs_lookup_child(world, Parent, "Child") == 0);
+
+    ecs_adopt(world, e, Parent);
+    test_assert(ecs_lookup_child(world, Parent, "Child") == e);
+
+    ecs_orphan(world, e, Parent);
+    test_assert(ecs_lookup_child(world, Parent, "Child") == 0);
+    test_assert(ecs_lookup(world, "Child") == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_child_many_parents() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t parents[100];
+    ecs_entity_t children[100];
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        parents[i] = ecs_new(world, 0);
+        children[i] = ecs_new_child(world, parents[i], 0);
+        ecs_set(world, children[i], EcsId, {"Child"});
+    }
+
+    for (i = 0; i < 100; i ++) {
+        test_assert(ecs_lookup_child(world, parents[i], "Child") == children[i]);
+    }
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_prefab() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_PREFAB(world, MyPrefab, 0);
+
+    test_assert(ecs_lookup(world, "MyPrefab") == MyPrefab);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_snapshot_restore() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsId, {"Foo"});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+
+    ecs_delete(world, e);
+    test_assert(ecs_lookup(world, "Foo") == 0);
+
+    ecs_snapshot_restore(world, s);
+    test_assert(ecs_lookup(world, "Foo") == e);
+
+    ecs_fini(world);
+}
@@ -8,6 +8,14 @@ void Progress(ecs_rows_t *rows) {
     }
 }
 
+void Progress_2(ecs_rows_t *rows) {
+    int row;
+    for (row = 0; row < rows->count; row ++) {
+        Position *foo = ecs_field(rows, Position, 1, row);
+        foo->y ++;
+    }
+}
+
 void MultiThread_2_thread_10_entity() {
     ecs_world_t *world = ecs_init();
     ECS_COMPONENT(world, Position);
@@ -1049,3 +1057,218 @@ void MultiThread_reactive_system() {
 
     ecs_fini(world);
 }
+
+void MultiThread_6_thread_1000_entity_2_systems_many_frames() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TYPE(world, Type, Position, Velocity);
+    ECS_SYSTEM(world, Progress, EcsOnUpdate, Position);
+    ECS_SYSTEM(world, Progress_2, EcsOnUpdate, Position, Velocity);
+
+    int i, ENTITIES = 1000, THREADS = 6, FRAMES = 50;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        /* Alternate types so that rows are spread over multiple tables */
+        if (i % 2) {
+            handles[i] = ecs_new(world, Position);
+        } else {
+            handles[i] = ecs_new(world, Type);
+        }
+        ecs_set(world, handles[i], Position, {0});
+    }
+
+    ecs_set_threads(world, THREADS);
+
+    int f;
+    for (f = 0; f < FRAMES; f ++) {
+        ecs_progress(world, 0);
+    }
+
+    /* Each entity must be processed exactly once per system per frame */
+    for (i = 0; i < ENTITIES; i ++) {
+        if (i % 2) {
+            test_int(ecs_get(world, handles[i], Position).x, FRAMES);
+        } else {
+            test_int(ecs_get(world, handles[i], Position).y, FRAMES);
+            test_int(ecs_get(world, handles[i], Position).x, FRAMES);
+        }
+    }
+
+    ecs_fini(world);
+}
+
+static
+void WritePosition(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        p[i].x ++;
+    }
+}
+
+static
+void ReadPosition(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN(rows, Velocity, v, 2);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        v[i].x = p[i].x;
+    }
+}
+
+static
+void WriteVelocity(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Velocity, v, 1);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        v[i].y ++;
+    }
+}
+
+void MultiThread_6_thread_read_after_write() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TYPE(world, Type, Position, Velocity);
+    ECS_SYSTEM(world, WritePosition, EcsOnUpdate, [out] Position);
+    ECS_SYSTEM(world, ReadPosition, EcsOnUpdate, [in] Position, [out] Velocity);
+
+    int i, ENTITIES = 1000, THREADS = 6, FRAMES = 10;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    /* Entities only matched by WritePosition, so that jobs of both systems
+     * cover different entities */
+    ecs_new_w_count(world, Position, ENTITIES * 4);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_new(world, Type);
+        ecs_set(world, handles[i], Position, {0});
+        ecs_set(world, handles[i], Velocity, {0});
+    }
+
+    ecs_set_threads(world, THREADS);
+
+    int f;
+    for (f = 0; f < FRAMES; f ++) {
+        ecs_progress(world, 0);
+
+        /* ReadPosition must see the value written in the same frame */
+        for (i = 0; i < ENTITIES; i ++) {
+            test_int(ecs_get(world, handles[i], Position).x, f + 1);
+            test_int(ecs_get(world, handles[i], Velocity).x, f + 1);
+        }
+    }
+
+    ecs_fini(world);
+}
+
+void MultiThread_6_thread_disjoint_writes() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TYPE(world, Type, Position, Velocity);
+    ECS_SYSTEM(world, WritePosition, EcsOnUpdate, [out] Position);
+    ECS_SYSTEM(world, WriteVelocity, EcsOnUpdate, Velocity);
+
+    int i, ENTITIES = 1000, THREADS = 6, FRAMES = 10;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_new(world, Type);
+        ecs_set(world, handles[i], Position, {0});
+        ecs_set(world, handles[i], Velocity, {0});
+    }
+
+    ecs_set_threads(world, THREADS);
+
+    int f;
+    for (f = 0; f < FRAMES; f ++) {
+        ecs_progress(world, 0);
+    }
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, FRAMES);
+        test_int(ecs_get(world, handles[i], Velocity).y, FRAMES);
+    }
+
+    ecs_fini(world);
+}
+
+static int task_off_main;
+
+static
+void MainThreadTask(ecs_rows_t *rows) {
+    if (ecs_get_thread_index(rows->world)) {
+        task_off_main ++;
+    }
+}
+
+void MultiThread_tasks_on_main_thread() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, MainThreadTask, EcsOnUpdate, 0);
+    ECS_SYSTEM(world, Progress, EcsOnUpdate, Position);
+
+    ecs_new_w_count(world, Position, 100);
+
+    ecs_set_threads(world, 4);
+
+    int i;
+    for (i = 0; i < 200; i ++) {
+        ecs_progress(world, 0);
+    }
+
+    test_int(task_off_main, 0);
+
+    ecs_fini(world);
+}
+
+static int32_t rows_read;
+
+static
+void CountPosition(ecs_rows_t *rows) {
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_os_ainc(&rows_read);
+    }
+}
+
+void MultiThread_periodic_changed_only() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, WritePosition, EcsPreUpdate, [out] Position);
+    ECS_SYSTEM(world, CountPosition, EcsOnUpdate, [in] Position);
+    ecs_set_period(world, WritePosition, 0.5);
+    ecs_set_changed_only(world, CountPosition, true);
+
+    ecs_new_w_count(world, Position, 100);
+
+    ecs_set_threads(world, 2);
+
+    /* First run of the reader sees all tables */
+    ecs_progress(world, 0.25);
+    test_int(rows_read, 100);
+
+    /* Writer runs every other frame */
+    int i;
+    for (i = 0; i < 4; i ++) {
+        rows_read = 0;
+        ecs_progress(world, 0.25);
+        test_int(rows_read, 100);
+
+        rows_read = 0;
+        ecs_progress(world, 0.25);
+        test_int(rows_read, 0);
+    }
+
+    ecs_fini(world);
+}
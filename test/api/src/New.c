@@ -177,3 +177,71 @@ void New_redefine_component() {
     
     ecs_fini(world);
 }
+
+void New_aligned_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ALIGNED_COMPONENT(world, Position, 64);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t first = ecs_set(world, 0, Position, {0, 0});
+    ecs_set(world, first, Velocity, {0, 0});
+
+    /* Column storage is reallocated while the table grows */
+    int i;
+    for (i = 1; i < 1000; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {i, i * 2});
+        ecs_set(world, e, Velocity, {i, 0});
+    }
+
+    Position *p = ecs_get_ptr(world, first, Position);
+    test_assert(p != NULL);
+    test_int((uintptr_t)p % 64, 0);
+
+    ecs_entity_t e = ecs_new_w_count(world, Position, 100);
+    p = ecs_get_ptr(world, e, Position);
+    test_assert(p != NULL);
+    test_int((uintptr_t)p % 64, 0);
+
+    ecs_fini(world);
+}
+
+static
+void CheckAlignment(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+
+    int *invoked = rows->param;
+    test_int((uintptr_t)p % 32, 0);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        test_int(p[i].y, p[i].x * 2);
+    }
+
+    (*invoked) += rows->count;
+}
+
+void New_aligned_component_in_system() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ALIGNED_COMPONENT(world, Position, 32);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, CheckAlignment, EcsManual, Position);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_set(world, 0, Position, {i, i * 2});
+    }
+
+    /* Moves entities to a table that already has aligned columns */
+    for (i = 0; i < 50; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {i, i * 2});
+        ecs_add(world, e, Velocity);
+    }
+
+    int invoked = 0;
+    ecs_run(world, CheckAlignment, 1, &invoked);
+    test_int(invoked, 150);
+
+    ecs_fini(world);
+}
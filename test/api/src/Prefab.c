@@ -2709,3 +2709,205 @@ void Prefab_create_multiple_nested_w_on_add_in_progress() {
 
     ecs_fini(world);
 }
+
+void Prefab_rematch_nested_prefab() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, Dummy, EcsOnUpdate, Position, Velocity);
+
+    ECS_PREFAB(world, Base, Position);
+    ECS_PREFAB(world, Prefab, INSTANCEOF | Base);
+    ECS_ENTITY(world, Entity, INSTANCEOF | Prefab);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 0);
+
+    ecs_add(world, Base, Velocity);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 1);
+    test_int(ctx.e[0], Entity);
+    test_int(ctx.s[0][1], Base);
+
+    ecs_fini(world);
+}
+
+void Prefab_rematch_after_remove_from_base() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, Dummy, EcsOnUpdate, Position, Velocity);
+
+    ECS_PREFAB(world, Prefab, Position, Velocity);
+    ECS_ENTITY(world, Entity_1, INSTANCEOF | Prefab);
+    ECS_ENTITY(world, Entity_2, INSTANCEOF | Prefab, Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 2);
+
+    ecs_remove(world, Prefab, Velocity);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.count, 0);
+
+    ecs_add(world, Prefab, Velocity);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 2);
+
+    ecs_fini(world);
+}
+
+void Prefab_cached_ptr_after_delete_from_prefab_table() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Mass);
+
+    ECS_PREFAB(world, Prefab_1, Mass);
+    ecs_set(world, Prefab_1, Mass, {1});
+
+    ECS_PREFAB(world, Prefab_2, Mass);
+    ecs_set(world, Prefab_2, Mass, {2});
+
+    ECS_ENTITY(world, e_1, Position, INSTANCEOF | Prefab_2);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, Mass, Position);
+
+    ecs_progress(world, 1);
+
+    Position *p = ecs_get_ptr(world, e_1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 20);
+    test_int(p->y, 40);
+
+    /* Moves Prefab_2 to the row of Prefab_1 */
+    ecs_delete(world, Prefab_1);
+    ecs_set(world, Prefab_2, Mass, {3});
+
+    ecs_progress(world, 1);
+
+    p = ecs_get_ptr(world, e_1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 60);
+
+    ecs_fini(world);
+}
+
+void Prefab_prefab_w_children_new_w_count() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_ENTITY(world, Parent, EcsPrefab, Position);
+        ecs_set(world, Parent, Position, {1, 2});
+
+        ECS_ENTITY(world, Child1, EcsPrefab, Position);
+            ecs_set(world, Child1, EcsPrefab, {.parent = Parent});
+            ecs_set(world, Child1, Position, {2, 3});
+
+        ECS_ENTITY(world, Child2, EcsPrefab, Velocity);
+            ecs_set(world, Child2, EcsPrefab, {.parent = Parent});
+            ecs_set(world, Child2, Velocity, {3, 4});
+
+            ECS_ENTITY(world, GrandChild, EcsPrefab, Position);
+                ecs_set(world, GrandChild, EcsPrefab, {.parent = Child2});
+                ecs_set(world, GrandChild, Position, {4, 5});
+
+    ecs_entity_t e = ecs_new_instance_w_count(world, Parent, 0, 100);
+    test_assert(e != 0);
+
+    int end = e + 100;
+    for (; e < end; e ++) {
+        ecs_entity_t child_1 = ecs_lookup_child(world, e, "Child1");
+        test_assert(child_1 != 0);
+        test_assert(ecs_contains(world, e, child_1));
+        test_assert(!ecs_has(world, child_1, EcsPrefab));
+
+        Position *p = ecs_get_ptr(world, child_1, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 2);
+        test_int(p->y, 3);
+
+        ecs_entity_t child_2 = ecs_lookup_child(world, e, "Child2");
+        test_assert(child_2 != 0);
+        test_assert(child_2 != child_1);
+        test_assert(ecs_contains(world, e, child_2));
+
+        Velocity *v = ecs_get_ptr(world, child_2, Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, 3);
+        test_int(v->y, 4);
+
+        ecs_entity_t grandchild = ecs_lookup_child(world, child_2, "GrandChild");
+        test_assert(grandchild != 0);
+        test_assert(ecs_contains(world, child_2, grandchild));
+        test_assert(!ecs_contains(world, e, grandchild));
+
+        p = ecs_get_ptr(world, grandchild, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 4);
+        test_int(p->y, 5);
+
+        int32_t count = 0;
+        ecs_children_iter_t it = ecs_children_iter(world, e);
+        while (ecs_children_next(&it)) {
+            count += it.rows.count;
+        }
+
+        test_int(count, 2);
+    }
+
+    ecs_fini(world);
+}
+
+void Prefab_prefab_w_child_recycle() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_ENTITY(world, Parent, EcsPrefab, Position);
+        ECS_ENTITY(world, Child, EcsPrefab, Position);
+            ecs_set(world, Child, EcsPrefab, {.parent = Parent});
+            ecs_set(world, Child, Position, {2, 3});
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    ecs_entity_t e_2 = ecs_new(world, Position);
+    ecs_delete(world, e_1);
+    ecs_delete(world, e_2);
+
+    /* The instance and its child reuse the ids of the deleted entities */
+    ecs_entity_t e = ecs_new_instance(world, Parent, 0);
+    test_assert(e != 0);
+
+    ecs_entity_t child = ecs_lookup_child(world, e, "Child");
+    test_assert(child != 0);
+    test_assert(ecs_is_alive(world, child));
+    test_assert(ecs_contains(world, e, child));
+    test_int(ECS_GENERATION(child), 1);
+
+    ecs_entity_t index = child & ECS_ENTITY_INDEX_MASK;
+    test_assert(index == e_1 || index == e_2);
+    test_assert(index != (e & ECS_ENTITY_INDEX_MASK));
+
+    Position *p = ecs_get_ptr(world, child, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 2);
+    test_int(p->y, 3);
+
+    ecs_fini(world);
+}
@@ -0,0 +1,393 @@
+#include <api.h>
+
+static
+int query_count(
+    ecs_query_t *query,
+    int *table_count)
+{
+    ecs_query_iter_t it = ecs_query_iter(query);
+    int count = 0, tables = 0;
+
+    while (ecs_query_next(&it)) {
+        count += it.rows.count;
+        tables ++;
+    }
+
+    if (table_count) {
+        *table_count = tables;
+    }
+
+    return count;
+}
+
+void Query_iter_one_table() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e = ecs_new_w_count(world, Position, 3);
+    test_assert(e != 0);
+
+    ecs_new(world, Velocity);
+
+    int i;
+    for (i = 0; i < 3; i ++) {
+        ecs_set(world, e + i, Position, {i, i * 2});
+    }
+
+    ecs_query_t *q = ecs_query_new(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    ecs_query_iter_t it = ecs_query_iter(q);
+
+    int table_count = 0;
+    int entity_count = 0;
+
+    while (ecs_query_next(&it)) {
+        table_count ++;
+        entity_count += it.rows.count;
+
+        test_assert(ecs_table_type(&it.rows) == ecs_type(Position));
+        Position *row = ecs_table_column(&it.rows, 0);
+        test_assert(row != NULL);
+
+        for (i = 0; i < it.rows.count; i ++) {
+            test_int(it.rows.entities[i], e + i);
+            test_int(row[i].x, i);
+            test_int(row[i].y, i * 2);
+        }
+    }
+
+    test_int(table_count, 1);
+    test_int(entity_count, 3);
+
+    ecs_fini(world);
+}
+
+void Query_iter_two_tables() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_TYPE(world, Movable, Position, Velocity);
+
+    ecs_new_w_count(world, Position, 3);
+    ecs_new_w_count(world, Movable, 2);
+    ecs_new_w_count(world, Velocity, 4);
+
+    ecs_query_t *q = ecs_query_new(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    int table_count;
+    test_int(query_count(q, &table_count), 5);
+    test_int(table_count, 2);
+
+    ecs_fini(world);
+}
+
+void Query_iter_w_exclude() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_TYPE(world, Movable, Position, Velocity);
+
+    ecs_new_w_count(world, Position, 3);
+    ecs_new_w_count(world, Movable, 2);
+
+    ecs_query_t *q = ecs_query_new(world, &(ecs_filter_t){
+        .include = ecs_type(Position),
+        .exclude = ecs_type(Velocity)
+    });
+
+    int table_count;
+    test_int(query_count(q, &table_count), 3);
+    test_int(table_count, 1);
+
+    ecs_fini(world);
+}
+
+void Query_match_new_table() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_query_t *q = ecs_query_new(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    test_int(query_count(q, NULL), 0);
+
+    ecs_new_w_count(world, Position, 3);
+    test_int(query_count(q, NULL), 3);
+
+    ecs_entity_t e = ecs_new(world, Position);
+    ecs_add(world, e, Velocity);
+
+    int table_count;
+    test_int(query_count(q, &table_count), 4);
+    test_int(table_count, 2);
+
+    ecs_fini(world);
+}
+
+static
+void AddVelocity(ecs_rows_t *rows) {
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_add(rows->world, rows->entities[i], Velocity);
+    }
+}
+
+void Query_match_new_table_after_merge() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, AddVelocity, EcsOnUpdate, Position, .Velocity);
+
+    ecs_new(world, Position);
+
+    ecs_query_t *q = ecs_query_new(world, &(ecs_filter_t){
+        .include = ecs_type(Velocity)
+    });
+
+    test_int(query_count(q, NULL), 0);
+
+    /* Table is created in the stage, and matched when it is merged */
+    ecs_progress(world, 1);
+
+    int table_count;
+    test_int(query_count(q, &table_count), 1);
+    test_int(table_count, 1);
+
+    ecs_fini(world);
+}
+
+void Query_skip_empty_table() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_TYPE(world, Movable, Position, Velocity);
+
+    ecs_entity_t e = ecs_new(world, Position);
+    ecs_new_w_count(world, Movable, 2);
+
+    ecs_query_t *q = ecs_query_new(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    int table_count;
+    test_int(query_count(q, &table_count), 3);
+    test_int(table_count, 2);
+
+    ecs_delete(world, e);
+
+    test_int(query_count(q, &table_count), 2);
+    test_int(table_count, 1);
+
+    /* Table is no longer visited after it was skipped once */
+    test_int(query_count(q, &table_count), 2);
+    test_int(table_count, 1);
+
+    ecs_fini(world);
+}
+
+void Query_reactivate_table() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_new(world, Position);
+
+    ecs_query_t *q = ecs_query_new(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    test_int(query_count(q, NULL), 1);
+
+    ecs_delete(world, e);
+    test_int(query_count(q, NULL), 0);
+
+    e = ecs_new(world, Position);
+    test_int(query_count(q, NULL), 1);
+
+    ecs_delete(world, e);
+    e = ecs_new(world, Position);
+    test_int(query_count(q, NULL), 1);
+
+    ecs_fini(world);
+}
+
+void Query_delete_while_iterating() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+
+    ECS_TYPE(world, Movable, Position, Velocity);
+    ECS_TYPE(world, Heavy, Position, Mass);
+
+    ecs_new_w_count(world, Position, 2);
+    ecs_new_w_count(world, Movable, 3);
+    ecs_new_w_count(world, Heavy, 4);
+
+    ecs_query_t *q = ecs_query_new(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    ecs_query_iter_t it = ecs_query_iter(q);
+
+    int table_count = 0, entity_count = 0;
+    while (ecs_query_next(&it)) {
+        table_count ++;
+        entity_count += it.rows.count;
+
+        int i;
+        for (i = it.rows.count - 1; i >= 0; i --) {
+            ecs_delete(world, it.rows.entities[i]);
+        }
+    }
+
+    test_int(table_count, 3);
+    test_int(entity_count, 9);
+
+    test_int(query_count(q, NULL), 0);
+
+    ecs_fini(world);
+}
+
+void Query_match_after_prefab_add() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t prefab = ecs_new(world, EcsPrefab);
+    ecs_entity_t e = ecs_new_instance(world, prefab, Velocity);
+    test_assert(e != 0);
+
+    ecs_query_t *q = ecs_query_new(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    test_int(query_count(q, NULL), 0);
+
+    ecs_add(world, prefab, Position);
+
+    int table_count;
+    test_int(query_count(q, &table_count), 2);
+    test_int(table_count, 2);
+
+    ecs_remove(world, prefab, Position);
+    test_int(query_count(q, NULL), 0);
+
+    ecs_fini(world);
+}
+
+static
+void QuerySystem(ecs_rows_t *rows) {
+    ecs_query_t *q = rows->param;
+    ecs_query_iter_t it = ecs_query_iter(q);
+
+    while (ecs_query_next(&it)) {
+        Position *p = ecs_table_column(&it.rows, 0);
+
+        int i;
+        for (i = 0; i < it.rows.count; i ++) {
+            p[i].x ++;
+        }
+    }
+}
+
+void Query_iter_from_system() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_query_t *q = ecs_query_new(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    ECS_SYSTEM(world, QuerySystem, EcsManual, 0);
+
+    ecs_run(world, QuerySystem, 0, q);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 11);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Query_iter_after_snapshot_restore() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_new_w_count(world, Position, 3);
+
+    ecs_query_t *q = ecs_query_new(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+
+    ecs_delete_w_filter(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    test_int(query_count(q, NULL), 0);
+
+    ecs_snapshot_restore(world, s);
+
+    test_int(query_count(q, NULL), 3);
+
+    ecs_fini(world);
+}
+
+void Query_free() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_new(world, Position);
+
+    ecs_query_t *q_1 = ecs_query_new(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    ecs_query_t *q_2 = ecs_query_new(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    ecs_query_free(q_1);
+
+    /* Remaining query is still matched with new tables */
+    ecs_entity_t e = ecs_new(world, Position);
+    ecs_add(world, e, Velocity);
+
+    int table_count;
+    test_int(query_count(q_2, &table_count), 2);
+    test_int(table_count, 2);
+
+    ecs_query_free(q_2);
+
+    ecs_fini(world);
+}
@@ -1314,6 +1314,35 @@ void ReaderWriter_component_size_conflict() {
     ecs_vector_free(v);
 }
 
+void ReaderWriter_aligned_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ALIGNED_COMPONENT(world, Position, 64);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {1, 2});
+
+    ecs_vector_t *v = serialize_to_vector(world, 36);
+
+    ecs_fini(world);
+
+    world = deserialize_from_vector(v, 36);
+
+    EcsComponent *cdata = ecs_get_ptr(world, ecs_entity(Position), EcsComponent);
+    test_assert(cdata != NULL);
+    test_int(cdata->size, sizeof(Position));
+    test_int(cdata->alignment, 64);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+    test_assert(((uintptr_t)p % 64) == 0);
+
+    ecs_fini(world);
+
+    ecs_vector_free(v);
+}
+
 void ReaderWriter_read_zero_size() {
     ecs_world_t *world = ecs_init();
 
@@ -1347,3 +1376,361 @@ void ReaderWriter_invalid_header() {
 
     ecs_fini(world);
 }
+
+static
+int long_name_test(int buffer_size) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    /* Names that are longer than the buffer are copied in multiple chunks */
+    char name[64];
+    ecs_entity_t entities[48];
+    int i;
+    for (i = 0; i < 48; i ++) {
+        memset(name, 'a' + (i % 26), i + 1);
+        name[i + 1] = '\0';
+        entities[i] = ecs_set(world, 0, EcsId, {ecs_os_strdup(name)});
+        ecs_set(world, entities[i], Position, {i, i * 2});
+    }
+
+    ecs_vector_t *v = serialize_to_vector(world, buffer_size);
+
+    /* Names are not owned by the world */
+    for (i = 0; i < 48; i ++) {
+        ecs_os_free((char*)ecs_get_id(world, entities[i]));
+    }
+
+    ecs_fini(world);
+
+    world = deserialize_from_vector(v, buffer_size);
+
+    test_int( ecs_count(world, Position), 48);
+
+    for (i = 0; i < 48; i ++) {
+        memset(name, 'a' + (i % 26), i + 1);
+        name[i + 1] = '\0';
+        test_str(ecs_get_id(world, entities[i]), name);
+        test_assert(ecs_lookup(world, name) == entities[i]);
+
+        Position *p = ecs_get_ptr(world, entities[i], Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+        test_int(p->y, i * 2);
+    }
+
+    ecs_fini(world);
+
+    int total = ecs_vector_count(v);
+    ecs_vector_free(v);
+    return total;
+}
+
+void ReaderWriter_long_names() {
+    int i, total = long_name_test(4);
+
+    test_assert(total > 4);
+    test_assert(total % 4 == 0);
+
+    for (i = 8; i < 128; i += 4) {
+        long_name_test(i);
+    }
+
+    long_name_test(total);
+    long_name_test(total * 2);
+}
+
+void ReaderWriter_same_output_for_buffer_sizes() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_ENTITY(world, Parent, 0);
+    ECS_ENTITY(world, Child, CHILDOF | Parent, Position);
+
+    ecs_set(world, Child, Position, {1, 2});
+    ecs_new_w_count(world, Velocity, 100);
+
+    ecs_vector_t *expect = serialize_to_vector(world, 4);
+    int total = ecs_vector_count(expect);
+    void *expect_ptr = ecs_vector_first(expect);
+
+    int i;
+    for (i = 8; i <= total + 4; i += 4) {
+        ecs_vector_t *v = serialize_to_vector(world, i);
+        test_int(ecs_vector_count(v), total);
+        test_assert(!memcmp(ecs_vector_first(v), expect_ptr, total));
+        ecs_vector_free(v);
+    }
+
+    ecs_vector_free(expect);
+
+    ecs_fini(world);
+}
+
+void ReaderWriter_deserialize_after_snapshot() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {1, 2});
+
+    ecs_vector_t *v = serialize_to_vector(world, 64);
+
+    ecs_set(world, e, Position, {3, 4});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+
+    /* The writer overwrites columns that are shared with the snapshot */
+    deserialize_from_vector_to_existing(v, 64, world);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    ecs_snapshot_restore(world, s);
+
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 3);
+    test_int(p->y, 4);
+
+    ecs_vector_free(v);
+
+    ecs_fini(world);
+}
+
+#define IMAGE_FILE "reader_writer_test.image"
+
+void ReaderWriter_image_simple() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Tag);
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {3, 4});
+    ecs_set(world, e2, Velocity, {5, 6});
+    ecs_entity_t e3 = ecs_new(world, Tag);
+    ecs_set(world, e3, Position, {7, 8});
+    ecs_entity_t e4 = ecs_set(world, 0, EcsId, {"E4"});
+    ecs_set(world, e4, Velocity, {9, 10});
+
+    test_int( ecs_world_save_image(world, IMAGE_FILE), 0);
+
+    ecs_fini(world);
+
+    world = ecs_init();
+
+    test_int( ecs_world_load_image(world, IMAGE_FILE), 0);
+
+    test_int( ecs_count(world, Position), 3);
+    test_int( ecs_count(world, Velocity), 2);
+
+    test_assert( ecs_has(world, e1, Position));
+    test_assert( ecs_has(world, e2, Position));
+    test_assert( ecs_has(world, e2, Velocity));
+    test_assert( ecs_has(world, e3, Tag));
+    test_assert( ecs_has(world, e3, Position));
+    test_assert( ecs_has(world, e4, Velocity));
+
+    Position *
+    p = ecs_get_ptr(world, e1, Position);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    p = ecs_get_ptr(world, e2, Position);
+    test_int(p->x, 3);
+    test_int(p->y, 4);
+
+    p = ecs_get_ptr(world, e3, Position);
+    test_int(p->x, 7);
+    test_int(p->y, 8);
+
+    Velocity *v = ecs_get_ptr(world, e2, Velocity);
+    test_int(v->x, 5);
+    test_int(v->y, 6);
+
+    test_str( ecs_get_id(world, e4), "E4");
+    test_assert( ecs_lookup(world, "E4") == e4);
+
+    ECS_SYSTEM(world, Dummy, EcsOnUpdate, Position);
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);      
+    ecs_progress(world, 0);
+    test_int(ctx.count, 3);
+
+    /* New entities don't reuse ids from the image */
+    ecs_entity_t e5 = ecs_new(world, 0);
+    test_assert(e5 != e1 && e5 != e2 && e5 != e3 && e5 != e4);
+
+    ecs_fini(world);
+
+    remove(IMAGE_FILE);
+}
+
+void ReaderWriter_image_modify_after_load() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {3, 4});
+    ecs_entity_t e3 = ecs_set(world, 0, Position, {5, 6});
+
+    test_int( ecs_world_save_image(world, IMAGE_FILE), 0);
+
+    ecs_fini(world);
+
+    world = ecs_init();
+
+    test_int( ecs_world_load_image(world, IMAGE_FILE), 0);
+
+    /* Columns are copied before they are modified */
+    ecs_set(world, e1, Position, {10, 20});
+    ecs_entity_t e4 = ecs_set(world, 0, Position, {7, 8});
+    ecs_add(world, e2, Velocity);
+    ecs_delete(world, e3);
+
+    test_int( ecs_count(world, Position), 3);
+
+    Position *
+    p = ecs_get_ptr(world, e1, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    p = ecs_get_ptr(world, e2, Position);
+    test_int(p->x, 3);
+    test_int(p->y, 4);
+
+    p = ecs_get_ptr(world, e4, Position);
+    test_int(p->x, 7);
+    test_int(p->y, 8);
+
+    test_assert( ecs_is_empty(world, e3));
+
+    ecs_fini(world);
+
+    remove(IMAGE_FILE);
+}
+
+void ReaderWriter_image_snapshot() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {1, 2});
+
+    test_int( ecs_world_save_image(world, IMAGE_FILE), 0);
+
+    ecs_fini(world);
+
+    world = ecs_init();
+
+    test_int( ecs_world_load_image(world, IMAGE_FILE), 0);
+
+    /* Snapshot shares the column that is borrowed from the image */
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+
+    ecs_set(world, e, Position, {3, 4});
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 3);
+    test_int(p->y, 4);
+
+    ecs_snapshot_restore(world, s);
+
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    ecs_fini(world);
+
+    remove(IMAGE_FILE);
+}
+
+void ReaderWriter_image_component_size_conflict() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ecs_set(world, 0, Position, {1, 2});
+
+    test_int( ecs_world_save_image(world, IMAGE_FILE), 0);
+
+    ecs_fini(world);
+
+    world = ecs_init();
+
+    /* Same name and id, but different size */
+    ecs_new_component(world, "Position", sizeof(Color));
+
+    test_assert( ecs_world_load_image(world, IMAGE_FILE) != 0);
+
+    ecs_fini(world);
+
+    remove(IMAGE_FILE);
+}
+
+void ReaderWriter_image_unterminated_name() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_set(world, 0, EcsId, {"Unterminated"});
+
+    test_int( ecs_world_save_image(world, IMAGE_FILE), 0);
+
+    ecs_fini(world);
+
+    /* Overwrite the name and everything after it, including the terminating
+     * 0 of the name */
+    FILE *f = fopen(IMAGE_FILE, "rb+");
+    test_assert(f != NULL);
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    test_assert(size > 0);
+
+    char *data = ecs_os_malloc(size);
+    fseek(f, 0, SEEK_SET);
+    test_int(fread(data, 1, size, f), size);
+
+    char *name = NULL;
+    long i;
+    for (i = 0; i < size - 12; i ++) {
+        if (!memcmp(&data[i], "Unterminated", 12)) {
+            name = &data[i];
+            break;
+        }
+    }
+    test_assert(name != NULL);
+
+    memset(name, 'x', size - i);
+    fseek(f, 0, SEEK_SET);
+    test_int(fwrite(data, 1, size, f), size);
+    fclose(f);
+    ecs_os_free(data);
+
+    world = ecs_init();
+
+    test_assert( ecs_world_load_image(world, IMAGE_FILE) != 0);
+
+    ecs_fini(world);
+
+    remove(IMAGE_FILE);
+}
+
+void ReaderWriter_image_invalid_file() {
+    ecs_world_t *world = ecs_init();
+
+    test_assert( ecs_world_load_image(world, IMAGE_FILE) != 0);
+
+    FILE *f = fopen(IMAGE_FILE, "wb");
+    test_assert(f != NULL);
+    fputs("not an image", f);
+    fclose(f);
+
+    test_assert( ecs_world_load_image(world, IMAGE_FILE) != 0);
+
+    ecs_fini(world);
+
+    remove(IMAGE_FILE);
+}
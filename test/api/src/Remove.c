@@ -261,3 +261,25 @@ void Remove_not_added() {
 
     ecs_fini(world);
 }
+
+void Remove_last_twice() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    test_assert(e_1 != 0);
+
+    ecs_entity_t e_2 = ecs_new(world, Position);
+    test_assert(e_2 != 0);
+
+    ecs_remove(world, e_1, Position);
+    test_assert(!ecs_has(world, e_1, Position));
+    test_assert(ecs_get_type(world, e_1) == NULL);
+
+    ecs_remove(world, e_2, Position);
+    test_assert(!ecs_has(world, e_2, Position));
+    test_assert(ecs_get_type(world, e_2) == NULL);
+
+    ecs_fini(world);
+}
@@ -320,3 +320,34 @@ void Set_set_null() {
 
     ecs_fini(world);
 }
+
+void Set_set_w_large_id() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e_1 = 5000;
+    ecs_entity_t e_2 = (ecs_entity_t)UINT32_MAX + 10;
+
+    ecs_set(world, e_1, Position, {10, 20});
+    ecs_set(world, e_2, Position, {30, 40});
+
+    Position *p = ecs_get_ptr(world, e_1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    p = ecs_get_ptr(world, e_2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_delete(world, e_1);
+    test_assert(!ecs_has(world, e_1, Position));
+    test_assert(ecs_has(world, e_2, Position));
+
+    ecs_delete(world, e_2);
+    test_assert(!ecs_has(world, e_2, Position));
+    
+    ecs_fini(world);
+}
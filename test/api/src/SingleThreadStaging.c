@@ -2529,9 +2529,9 @@ void SingleThreadStaging_match_table_created_in_progress() {
     test_int(ctx.column_count, 2);
     test_null(ctx.param);
 
-    test_int(ctx.e[0], e_3);
-    test_int(ctx.e[1], e_1);
-    test_int(ctx.e[2], e_2);
+    test_int(ctx.e[0], e_1);
+    test_int(ctx.e[1], e_2);
+    test_int(ctx.e[2], e_3);
     test_int(ctx.c[0][0], ecs_entity(Position));
     test_int(ctx.s[0][0], 0);
     test_int(ctx.c[0][1], ecs_entity(Velocity));
@@ -2967,3 +2967,124 @@ void SingleThreadStaging_get_parent_in_progress() {
 
     ecs_fini(world);
 }
+
+static
+void AddVelocityToEven(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN_COMPONENT(rows, Position, 1);
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        if ((int)p[i].x % 2) {
+            ecs_set(rows->world, rows->entities[i], Position, {p[i].x, 100});
+        } else {
+            ecs_set(rows->world, rows->entities[i], Velocity, {p[i].x, 200});
+        }
+    }
+}
+
+void SingleThreadStaging_merge_interleaved_add_and_set() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, AddVelocityToEven, EcsOnUpdate, Position, .Velocity);
+
+    ecs_entity_t e[8];
+    int i;
+    for (i = 0; i < 8; i ++) {
+        e[i] = ecs_set(world, 0, Position, {i, 0});
+    }
+
+    ecs_progress(world, 1);
+
+    for (i = 0; i < 8; i ++) {
+        Position *p = ecs_get_ptr(world, e[i], Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+
+        if (i % 2) {
+            test_assert( !ecs_has(world, e[i], Velocity));
+            test_int(p->y, 100);
+        } else {
+            test_assert( ecs_has(world, e[i], Velocity));
+            test_int(p->y, 0);
+
+            Velocity *v = ecs_get_ptr(world, e[i], Velocity);
+            test_assert(v != NULL);
+            test_int(v->x, i);
+            test_int(v->y, 200);
+        }
+    }
+
+    test_int(ecs_count(world, Position), 8);
+    test_int(ecs_count(world, Velocity), 4);
+
+    ecs_fini(world);
+}
+
+static
+void AddNextComponent(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+    ECS_COLUMN_COMPONENT(rows, Mass, 3);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        if (ecs_has(rows->world, rows->entities[i], Velocity)) {
+            ecs_set(rows->world, rows->entities[i], Mass, {p[i].x});
+        } else {
+            ecs_set(rows->world, rows->entities[i], Velocity, {p[i].x, 0});
+        }
+    }
+}
+
+void SingleThreadStaging_merge_move_to_table_being_moved_from() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+
+    ECS_SYSTEM(world, AddNextComponent, EcsOnUpdate, Position, .Velocity, .Mass);
+
+    /* Entities in [Position] move to [Position, Velocity], while entities in
+     * [Position, Velocity] move to [Position, Velocity, Mass] */
+    ecs_entity_t e[8];
+    int i;
+    for (i = 0; i < 8; i ++) {
+        e[i] = ecs_set(world, 0, Position, {i, i * 2});
+        if (i % 2) {
+            ecs_set(world, e[i], Velocity, {i, 0});
+        }
+    }
+
+    ecs_progress(world, 1);
+
+    for (i = 0; i < 8; i ++) {
+        Position *p = ecs_get_ptr(world, e[i], Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+        test_int(p->y, i * 2);
+
+        Velocity *v = ecs_get_ptr(world, e[i], Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, i);
+
+        if (i % 2) {
+            Mass *m = ecs_get_ptr(world, e[i], Mass);
+            test_assert(m != NULL);
+            test_int(*m, i);
+        } else {
+            test_assert( !ecs_has(world, e[i], Mass));
+        }
+    }
+
+    test_int(ecs_count(world, Position), 8);
+    test_int(ecs_count(world, Velocity), 8);
+    test_int(ecs_count(world, Mass), 4);
+
+    ecs_fini(world);
+}
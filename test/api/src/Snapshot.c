@@ -574,3 +574,368 @@ void Snapshot_snapshot_copy_w_filter() {
 
     ecs_fini(world);
 }
+
+static
+void Move(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        p[i].x ++;
+        p[i].y ++;
+    }
+}
+
+void Snapshot_snapshot_unchanged_after_system() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, Move, EcsOnUpdate, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    test_assert(e != 0);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+
+    ecs_progress(world, 0);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 11);
+    test_int(p->y, 21);
+
+    ecs_snapshot_restore(world, s);
+
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_progress(world, 0);
+
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 11);
+    test_int(p->y, 21);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_unchanged_after_set() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    test_assert(e != 0);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+
+    ecs_set(world, e, Position, {30, 40});
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_snapshot_restore(world, s);
+
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_unchanged_after_new_w_count() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    test_assert(e != 0);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+
+    ecs_new_w_count(world, Position, 100);
+    test_int(ecs_count(world, Position), 101);
+
+    ecs_snapshot_restore(world, s);
+
+    test_int(ecs_count(world, Position), 1);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_restore_twice() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    test_assert(e != 0);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+    ecs_snapshot_t *s_copy = ecs_snapshot_copy(world, s, NULL);
+
+    ecs_set(world, e, Position, {30, 40});
+    ecs_snapshot_restore(world, s);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_set(world, e, Position, {50, 60});
+    ecs_snapshot_restore(world, s_copy);
+
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_unchanged_after_delete_many() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_new_w_count(world, Position, 10);
+    test_assert(e != 0);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+
+    int i;
+    for (i = 0; i < 10; i ++) {
+        ecs_delete(world, e + i);
+    }
+
+    test_int(ecs_count(world, Position), 0);
+    test_assert(ecs_new(world, 0) != e);
+
+    ecs_snapshot_restore(world, s);
+
+    test_int(ecs_count(world, Position), 10);
+    for (i = 0; i < 10; i ++) {
+        test_assert(ecs_has(world, e + i, Position));
+    }
+
+    ecs_fini(world);
+}
+
+void Snapshot_delta_restore_chain() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    test_assert(e != 0);
+
+    ecs_snapshot_t *base = ecs_snapshot_take(world, NULL);
+
+    ecs_set(world, e, Position, {11, 21});
+    ecs_snapshot_t *d1 = ecs_snapshot_take_delta(world, base);
+
+    ecs_set(world, e, Position, {12, 22});
+    ecs_snapshot_t *d2 = ecs_snapshot_take_delta(world, d1);
+
+    ecs_set(world, e, Position, {13, 23});
+
+    ecs_snapshot_t *deltas[] = {d1, d2};
+
+    ecs_snapshot_restore_delta(world, base, deltas, 1);
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 11);
+    test_int(p->y, 21);
+
+    ecs_snapshot_restore_delta(world, base, deltas, 2);
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 12);
+    test_int(p->y, 22);
+
+    ecs_snapshot_restore_delta(world, base, deltas, 0);
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_snapshot_free(world, d2);
+    ecs_snapshot_free(world, d1);
+    ecs_snapshot_free(world, base);
+
+    ecs_fini(world);
+}
+
+void Snapshot_delta_only_changed_tables() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Velocity, {1, 2});
+
+    ecs_snapshot_t *base = ecs_snapshot_take(world, NULL);
+
+    ecs_set(world, e2, Velocity, {3, 4});
+
+    ecs_snapshot_t *d1 = ecs_snapshot_take_delta(world, base);
+
+    /* No changes since previous delta */
+    ecs_snapshot_t *d2 = ecs_snapshot_take_delta(world, d1);
+
+    ecs_filter_iter_t it = ecs_snapshot_filter_iter(world, d1, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+    test_assert(!ecs_filter_next(&it));
+
+    it = ecs_snapshot_filter_iter(world, d1, &(ecs_filter_t){
+        .include = ecs_type(Velocity)
+    });
+    test_assert(ecs_filter_next(&it));
+    test_int(it.rows.count, 1);
+
+    Velocity *v = ecs_table_column(&it.rows, 0);
+    test_int(v->x, 3);
+    test_int(v->y, 4);
+
+    it = ecs_snapshot_filter_iter(world, d2, &(ecs_filter_t){
+        .include = ecs_type(Velocity)
+    });
+    test_assert(!ecs_filter_next(&it));
+
+    ecs_snapshot_free(world, d2);
+    ecs_snapshot_free(world, d1);
+    ecs_snapshot_free(world, base);
+
+    ecs_fini(world);
+}
+
+static
+void ReadPosition(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        test_int(p[i].x, 10);
+        test_int(p[i].y, 20);
+    }
+}
+
+void Snapshot_delta_skip_read_tables() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, ReadPosition, EcsOnUpdate, [in] Position);
+
+    ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *base = ecs_snapshot_take(world, NULL);
+
+    /* Reading a component does not change the table */
+    ecs_progress(world, 1);
+
+    ecs_snapshot_t *d1 = ecs_snapshot_take_delta(world, base);
+
+    ecs_filter_iter_t it = ecs_snapshot_filter_iter(world, d1, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+    test_assert(!ecs_filter_next(&it));
+
+    ecs_snapshot_free(world, d1);
+    ecs_snapshot_free(world, base);
+
+    ecs_fini(world);
+}
+
+void Snapshot_delta_restore_new_and_delete() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *base = ecs_snapshot_take(world, NULL);
+
+    ecs_entity_t e2 = ecs_set(world, 0, Velocity, {1, 2});
+    ecs_snapshot_t *d1 = ecs_snapshot_take_delta(world, base);
+
+    ecs_delete(world, e1);
+    ecs_snapshot_t *d2 = ecs_snapshot_take_delta(world, d1);
+
+    ecs_snapshot_t *deltas[] = {d1, d2};
+
+    ecs_snapshot_restore_delta(world, base, deltas, 1);
+    test_assert(ecs_has(world, e1, Position));
+    test_assert(ecs_has(world, e2, Velocity));
+    test_int(ecs_count(world, Position), 1);
+    test_int(ecs_count(world, Velocity), 1);
+
+    ecs_snapshot_restore_delta(world, base, deltas, 2);
+    test_assert(!ecs_has(world, e1, Position));
+    test_assert(ecs_has(world, e2, Velocity));
+    test_int(ecs_count(world, Position), 0);
+    test_int(ecs_count(world, Velocity), 1);
+
+    ecs_snapshot_restore_delta(world, base, deltas, 0);
+    test_assert(ecs_has(world, e1, Position));
+    test_assert(!ecs_has(world, e2, Velocity));
+    test_int(ecs_count(world, Position), 1);
+    test_int(ecs_count(world, Velocity), 0);
+
+    ecs_snapshot_free(world, d2);
+    ecs_snapshot_free(world, d1);
+    ecs_snapshot_free(world, base);
+
+    ecs_fini(world);
+}
+
+void Snapshot_delta_after_system() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, Move, EcsOnUpdate, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *history[8];
+    history[0] = ecs_snapshot_take(world, NULL);
+
+    int i;
+    for (i = 1; i < 8; i ++) {
+        ecs_progress(world, 0);
+        history[i] = ecs_snapshot_take_delta(world, history[i - 1]);
+    }
+
+    /* Roll back, and simulate again from the restored frame */
+    ecs_snapshot_restore_delta(world, history[0], &history[1], 3);
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 13);
+    test_int(p->y, 23);
+
+    ecs_progress(world, 0);
+    ecs_snapshot_t *d = ecs_snapshot_take_delta(world, history[3]);
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 14);
+    test_int(p->y, 24);
+
+    ecs_snapshot_restore_delta(world, history[0], &history[1], 7);
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 17);
+    test_int(p->y, 27);
+
+    ecs_snapshot_t *chain[] = {history[1], history[2], history[3], d};
+    ecs_snapshot_restore_delta(world, history[0], chain, 4);
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 14);
+    test_int(p->y, 24);
+
+    ecs_snapshot_free(world, d);
+    for (i = 7; i >= 0; i --) {
+        ecs_snapshot_free(world, history[i]);
+    }
+
+    ecs_fini(world);
+}
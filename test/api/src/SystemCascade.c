@@ -315,3 +315,205 @@ void SystemCascade_adopt_after_match() {
 
     ecs_fini(world);
 }
+
+void SystemCascade_adopt_parent_after_match() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_ENTITY(world, e_1, Position);
+    ECS_ENTITY(world, e_2, Position);
+    ECS_ENTITY(world, e_3, Position);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, Position, CASCADE.Position);
+
+    ecs_adopt(world, e_3, e_2);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+
+    test_int(ctx.count, 3);
+    test_int(ctx.e[2], e_3);
+
+    /* Moving the parent one level down must also move its child down */
+    ecs_adopt(world, e_2, e_1);
+
+    ecs_set(world, e_1, Position, {1, 2});
+    ecs_set(world, e_2, Position, {1, 2});
+    ecs_set(world, e_3, Position, {1, 2});
+
+    ctx = (SysTestData){0};
+
+    ecs_progress(world, 1);
+
+    test_int(ctx.count, 3);
+    test_int(ctx.invoked, 3);
+    test_int(ctx.e[0], e_1);
+    test_int(ctx.e[1], e_2);
+    test_int(ctx.e[2], e_3);
+
+    Position *p = ecs_get_ptr(world, e_1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 2);
+    test_int(p->y, 3);
+
+    p = ecs_get_ptr(world, e_2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 4);
+    test_int(p->y, 6);
+
+    p = ecs_get_ptr(world, e_3, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 6);
+    test_int(p->y, 9);
+
+    ecs_fini(world);
+}
+
+void SystemCascade_adopt_parent_w_filter_after_match() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ECS_ENTITY(world, e_1, Position);
+    ECS_ENTITY(world, e_2, Position);
+    ECS_ENTITY(world, e_3, Position, Tag);
+    ECS_ENTITY(world, e_4, Position);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, Position, CASCADE.Position);
+
+    ecs_adopt(world, e_2, e_1);
+    ecs_adopt(world, e_4, e_3);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+
+    test_int(ctx.count, 4);
+
+    /* Moving the parent two levels down with a filter must also move its child
+     * down */
+    ecs_type_t to_add = ecs_type_find(
+        world, &(ecs_entity_t){e_2 | ECS_CHILDOF}, 1);
+    _ecs_add_remove_w_filter(world, to_add, 0, &(ecs_filter_t){
+        .include = ecs_type(Tag)
+    });
+
+    test_assert(ecs_contains(world, e_2, e_3));
+
+    ecs_set(world, e_1, Position, {1, 2});
+    ecs_set(world, e_2, Position, {1, 2});
+    ecs_set(world, e_3, Position, {1, 2});
+    ecs_set(world, e_4, Position, {1, 2});
+
+    ctx = (SysTestData){0};
+
+    ecs_progress(world, 1);
+
+    test_int(ctx.count, 4);
+    test_int(ctx.invoked, 4);
+    test_int(ctx.e[0], e_1);
+    test_int(ctx.e[1], e_2);
+    test_int(ctx.e[2], e_3);
+    test_int(ctx.e[3], e_4);
+
+    Position *p = ecs_get_ptr(world, e_3, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 6);
+    test_int(p->y, 9);
+
+    p = ecs_get_ptr(world, e_4, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 8);
+    test_int(p->y, 12);
+
+    ecs_fini(world);
+}
+
+/* Test that each entity is iterated exactly once, in depth order */
+static
+void test_cascade_order(
+    SysTestData *ctx,
+    ecs_entity_t *entities,
+    int32_t *depths,
+    int32_t count)
+{
+    test_int(ctx->count, count);
+
+    int32_t i, j, prev_depth = 0;
+    for (i = 0; i < count; i ++) {
+        int32_t found = 0, depth = -1;
+        for (j = 0; j < count; j ++) {
+            if (ctx->e[i] == entities[j]) {
+                depth = depths[j];
+                found ++;
+            }
+        }
+
+        test_int(found, 1);
+        test_assert(depth >= prev_depth);
+        prev_depth = depth;
+    }
+
+    for (i = 0; i < count; i ++) {
+        for (j = i + 1; j < count; j ++) {
+            test_assert(ctx->e[i] != ctx->e[j]);
+        }
+    }
+}
+
+void SystemCascade_toggle_table_w_matched_tables() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, Position, CASCADE.Position);
+
+    ECS_ENTITY(world, r_1, Position);
+    ECS_ENTITY(world, r_2, Position, Velocity);
+    ECS_ENTITY(world, c_1, Position, CHILDOF | r_1);
+    ECS_ENTITY(world, c_2, Position, CHILDOF | r_2);
+    ECS_ENTITY(world, c_3, Position, Velocity, CHILDOF | r_1);
+    ECS_ENTITY(world, g_1, Position, CHILDOF | c_1);
+    ECS_ENTITY(world, g_2, Position, CHILDOF | c_3);
+
+    ecs_entity_t entities[] = {r_1, r_2, c_1, c_2, c_3, g_1, g_2};
+    int32_t depths[] = {0, 0, 1, 1, 1, 2, 2};
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 7);
+    test_cascade_order(&ctx, entities, depths, 7);
+
+    /* Toggle the table of c_2 between empty and non-empty, while the tables
+     * of the other entities stay active */
+    int i;
+    for (i = 0; i < 4; i ++) {
+        ecs_delete(world, c_2);
+
+        ctx = (SysTestData){0};
+        ecs_progress(world, 1);
+        test_int(ctx.invoked, 6);
+        ecs_entity_t without_c_2[] = {r_1, r_2, c_1, c_3, g_1, g_2};
+        int32_t without_c_2_depths[] = {0, 0, 1, 1, 2, 2};
+        test_cascade_order(&ctx, without_c_2, without_c_2_depths, 6);
+
+        c_2 = ecs_new(world, Position);
+        ecs_adopt(world, c_2, r_2);
+        entities[3] = c_2;
+
+        ctx = (SysTestData){0};
+        ecs_progress(world, 1);
+        test_int(ctx.invoked, 7);
+        test_cascade_order(&ctx, entities, depths, 7);
+    }
+
+    ecs_fini(world);
+}
@@ -2014,3 +2014,203 @@ void SystemOnFrame_is_in_readonly() {
 
     ecs_fini(world);
 }
+
+void SystemOnFrame_changed_only_skip_unchanged() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_ENTITY(world, e_1, Position);
+    ECS_ENTITY(world, e_2, Position);
+    ECS_ENTITY(world, e_3, Position, Velocity);
+
+    ECS_SYSTEM(world, ProbeSystem, EcsOnUpdate, [in] Position);
+    ecs_set_changed_only(world, ProbeSystem, true);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 2);
+    test_int(ctx.count, 3);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 0);
+    test_int(ctx.count, 0);
+
+    ecs_fini(world);
+}
+
+void SystemOnFrame_changed_only_after_set() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_ENTITY(world, e_1, Position);
+    ECS_ENTITY(world, e_2, Position);
+    ECS_ENTITY(world, e_3, Position, Velocity);
+
+    ECS_SYSTEM(world, ProbeSystem, EcsOnUpdate, [in] Position);
+    ecs_set_changed_only(world, ProbeSystem, true);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 3);
+
+    /* Only the table of e_3 changed */
+    ecs_set(world, e_3, Position, {10, 20});
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.count, 1);
+    test_int(ctx.e[0], e_3);
+
+    /* Changing a column the system doesn't read doesn't trigger the system */
+    ecs_set(world, e_3, Velocity, {1, 2});
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 0);
+
+    ecs_fini(world);
+}
+
+void SystemOnFrame_changed_only_after_add() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_ENTITY(world, e_1, Position);
+    ECS_ENTITY(world, e_2, Position);
+    ECS_ENTITY(world, e_3, Position, Velocity);
+
+    ECS_SYSTEM(world, ProbeSystem, EcsOnUpdate, [in] Position);
+    ecs_set_changed_only(world, ProbeSystem, true);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 3);
+
+    /* Moving e_2 changes both the source and the destination table */
+    ecs_add(world, e_2, Velocity);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 2);
+    test_int(ctx.count, 3);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 0);
+
+    ecs_fini(world);
+}
+
+static
+void WritePosition(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        p[i].x ++;
+    }
+}
+
+void SystemOnFrame_changed_only_after_out_system() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_ENTITY(world, e_1, Position);
+    ECS_ENTITY(world, e_2, Position);
+    ECS_ENTITY(world, e_3, Position, Velocity);
+
+    ECS_SYSTEM(world, WritePosition, EcsPreUpdate, [out] Position, Velocity);
+    ECS_SYSTEM(world, ProbeSystem, EcsOnUpdate, [in] Position);
+    ecs_set_changed_only(world, ProbeSystem, true);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 3);
+
+    /* The [out] system writes the table of e_3 every frame */
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.count, 1);
+    test_int(ctx.e[0], e_3);
+
+    ecs_enable(world, WritePosition, false);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 0);
+
+    ecs_fini(world);
+}
+
+void SystemOnFrame_changed_only_ignore_own_writes() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_ENTITY(world, e_1, Position);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, Position);
+    ecs_set_changed_only(world, Iter, true);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 0);
+
+    ecs_set(world, e_1, Position, {1, 2});
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+
+    ecs_fini(world);
+}
+
+void SystemOnFrame_changed_only_disable() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_ENTITY(world, e_1, Position);
+
+    ECS_SYSTEM(world, ProbeSystem, EcsOnUpdate, [in] Position);
+    ecs_set_changed_only(world, ProbeSystem, true);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+
+    ecs_set_changed_only(world, ProbeSystem, false);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+
+    ecs_fini(world);
+}
@@ -737,3 +737,93 @@ void SystemOnSet_disabled_system() {
 
     ecs_fini(world);
 }
+
+static Velocity shared_velocity;
+
+static
+void OnSetSharedVelocity(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Velocity, v, 2);
+
+    ProbeSystem(rows);
+
+    test_assert(ecs_is_shared(rows, 2));
+    shared_velocity = *v;
+}
+
+void SystemOnSet_set_w_from_entity_after_moved() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+
+    ECS_PREFAB(world, Prefab, Velocity);
+    ecs_set(world, Prefab, Velocity, {1, 2});
+
+    ECS_SYSTEM(world, OnSetSharedVelocity, EcsOnSet, Position, Prefab.Velocity);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_entity_t e = ecs_new(world, 0);
+    ecs_set(world, e, Position, {10, 20});
+    test_int(ctx.invoked, 1);
+    test_int(shared_velocity.x, 1);
+    test_int(shared_velocity.y, 2);
+
+    /* Moves the prefab to another table, which invalidates the reference */
+    ecs_add(world, Prefab, Mass);
+    ecs_set(world, Prefab, Velocity, {3, 4});
+
+    ecs_set(world, e, Position, {10, 20});
+    test_int(ctx.invoked, 2);
+    test_int(shared_velocity.x, 3);
+    test_int(shared_velocity.y, 4);
+
+    ecs_set(world, Prefab, Velocity, {5, 6});
+
+    ecs_set(world, e, Position, {10, 20});
+    test_int(ctx.invoked, 3);
+    test_int(shared_velocity.x, 5);
+    test_int(shared_velocity.y, 6);
+
+    ecs_fini(world);
+}
+
+void SystemOnSet_set_multiple_tables_again() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, OnSet, EcsOnSet, Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_entity_t e1 = ecs_new(world, Position);
+    ecs_entity_t e2 = ecs_new(world, Position);
+    ecs_add(world, e2, Velocity);
+
+    int i;
+    for (i = 0; i < 3; i ++) {
+        ecs_set(world, e1, Position, {10, 20});
+        ecs_set(world, e2, Position, {30, 40});
+    }
+
+    test_int(ctx.invoked, 6);
+    test_int(ctx.column_count, 1);
+    test_int(ctx.c[0][0], ecs_entity(Position));
+
+    Position *p = ecs_get_ptr(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 11);
+    test_int(p->y, 20);
+
+    p = ecs_get_ptr(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 31);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
@@ -139,3 +139,35 @@ void System_w_FromEntity_task_not_from_entity() {
 
     ecs_fini(world);
 }
+
+void System_w_FromEntity_add_component_to_source_after_match() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Mass);
+
+    ECS_ENTITY(world, e_1, Position);
+    ECS_ENTITY(world, e_2, Position);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, e_1.Mass, Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 0);
+
+    ecs_set(world, e_1, Mass, {5});
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 2);
+    test_int(ctx.invoked, 2);
+    test_int(ctx.s[0][0], e_1);
+
+    Position *p = ecs_get_ptr(world, e_2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 50);
+    test_int(p->y, 100);
+
+    ecs_fini(world);
+}
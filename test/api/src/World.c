@@ -329,13 +329,13 @@ void World_dim_type() {
 
     ecs_new_w_count(world, Position, 500);
 
-    test_int(malloc_count, 2);
+    test_int(malloc_count, 1);
 
     malloc_count = 0;
 
     ecs_new_w_count(world, Position, 400);
 
-    test_int(malloc_count, 2);
+    test_int(malloc_count, 1);
 
     ecs_fini(world);
 }
@@ -1082,3 +1082,319 @@ void World_is_entity_enabled() {
 
     ecs_fini(world);
 }
+
+void World_time_histogram() {
+    ecs_time_histogram_t hist = {{0}};
+
+    test_flt(ecs_time_histogram_percentile(&hist, 0.5), 0);
+
+    /* 90 samples of ~2us, 10 samples of 1ms */
+    int i;
+    for (i = 0; i < 90; i ++) {
+        ecs_time_histogram_record(&hist, 0.000002);
+    }
+    for (i = 0; i < 10; i ++) {
+        ecs_time_histogram_record(&hist, 0.001);
+    }
+
+    float p50 = ecs_time_histogram_percentile(&hist, 0.5);
+    float p99 = ecs_time_histogram_percentile(&hist, 0.99);
+    float max = ecs_time_histogram_percentile(&hist, 1.0);
+
+    test_assert(p50 >= 0.000002);
+    test_assert(p50 < 0.00001);
+    test_assert(p99 >= 0.0005);
+    test_assert(p99 <= max);
+    test_flt(max, 0.001);
+
+    /* Histogram decays after a window, but keeps the previous max */
+    for (i = 0; i < ECS_HISTOGRAM_WINDOW * 4; i ++) {
+        ecs_time_histogram_record(&hist, 0.000002);
+    }
+
+    test_assert(hist.count <= ECS_HISTOGRAM_WINDOW);
+    p99 = ecs_time_histogram_percentile(&hist, 0.99);
+    test_assert(p99 < 0.00001);
+
+    max = ecs_time_histogram_percentile(&hist, 1.0);
+    test_assert(max < 0.00001);
+}
+
+void World_system_time_stats() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsStats, 0);
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_new_system(world, "CollectSystemStats", EcsManual, "[in] EcsSystemStats", NULL);
+
+    ECS_SYSTEM(world, Move, EcsOnUpdate, Position, Velocity);
+    ECS_ENTITY(world, e, Position, Velocity);
+
+    int i;
+    for (i = 0; i < 10; i ++) {
+        ecs_progress(world, 1);
+    }
+
+    EcsSystemStats stats = ecs_get(world, Move, EcsSystemStats);
+    test_assert(stats.invoke_count_total != 0);
+    test_assert(stats.invoke_seconds.max_seconds > 0);
+    test_assert(stats.invoke_seconds.p50_seconds <= stats.invoke_seconds.p99_seconds);
+    test_assert(stats.invoke_seconds.p99_seconds <= stats.invoke_seconds.max_seconds);
+
+    ecs_fini(world);
+}
+
+void World_thread_stats() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsStats, 0);
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_new_system(world, "CollectThreadStats", EcsManual, "[in] EcsThreadStats", NULL);
+
+    ECS_SYSTEM(world, Move, EcsOnUpdate, Position, Velocity);
+
+    int i;
+    ECS_TYPE(world, Type, Position, Velocity);
+    ecs_new_w_count(world, Type, 100);
+
+    ecs_set_threads(world, 2);
+
+    for (i = 0; i < 10; i ++) {
+        ecs_progress(world, 1);
+    }
+
+    EcsThreadStats stats = ecs_get(world, EcsWorld, EcsThreadStats);
+    test_int(stats.threads_count, 2);
+
+    uint64_t jobs = 0;
+    for (i = 0; i < 2; i ++) {
+        jobs += stats.threads[i].jobs_count_total;
+        test_assert(stats.threads[i].merges_count_total != 0);
+        test_assert(stats.threads[i].job_seconds.p50_seconds <= 
+            stats.threads[i].job_seconds.max_seconds);
+    }
+
+    test_assert(jobs != 0);
+    test_assert(stats.main_thread.merges_count_total != 0);
+
+    ecs_fini(world);
+}
+
+void World_memory_stats() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsStats, 0);
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_new_system(world, "CollectMemoryStats", EcsManual, "[in] EcsMemoryStats", NULL);
+
+    ecs_new_w_count(world, Position, 1000);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_new(world, Position);
+    }
+
+    /* Let the stats module create its components */
+    for (i = 0; i < 3; i ++) {
+        ecs_progress(world, 1);
+    }
+
+    EcsMemoryStats stats = ecs_get(world, EcsWorld, EcsMemoryStats);
+    uint64_t components_used = stats.components_memory.used_bytes;
+    uint64_t entities_used = stats.entities_memory.used_bytes;
+    test_assert(components_used >= 1100 * sizeof(Position));
+    test_assert(entities_used >= 1100 * sizeof(ecs_entity_t));
+    test_assert(stats.components_memory.allocd_bytes >= components_used);
+    test_assert(stats.entities_memory.allocd_bytes >= entities_used);
+    test_assert(stats.total_memory.allocd_bytes >= stats.total_memory.used_bytes);
+
+    ecs_delete_w_filter(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    ecs_progress(world, 1);
+
+    stats = ecs_get(world, EcsWorld, EcsMemoryStats);
+    test_int(components_used - stats.components_memory.used_bytes, 
+        1100 * sizeof(Position));
+    test_assert(entities_used - stats.entities_memory.used_bytes >= 
+        1100 * sizeof(ecs_entity_t));
+
+    ecs_fini(world);
+}
+
+static
+char* read_file(
+    const char *filename)
+{
+    FILE *f = fopen(filename, "r");
+    test_assert(f != NULL);
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    char *result = ecs_os_malloc(size + 1);
+    test_assert(fread(result, 1, size, f) == (size_t)size);
+    result[size] = '\0';
+    fclose(f);
+
+    return result;
+}
+
+static
+int count_str(
+    const char *str,
+    const char *sub)
+{
+    int result = 0;
+    while ((str = strstr(str, sub))) {
+        result ++;
+        str ++;
+    }
+    return result;
+}
+
+void World_trace_write() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, Move, EcsOnUpdate, Position, Velocity);
+    ECS_TYPE(world, Type, Position, Velocity);
+    ecs_new_w_count(world, Type, 10);
+
+    ecs_trace_start(world, 0);
+
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+
+    ecs_trace_stop(world);
+
+    /* Frames after stopping the trace are not recorded */
+    ecs_progress(world, 1);
+
+    const char *filename = "trace_write.json";
+    test_int(ecs_trace_write(world, filename), 0);
+
+    char *json = read_file(filename);
+    test_assert(!strncmp(json, "{\"traceEvents\":[", 16));
+    test_int(count_str(json, "\"cat\":\"frame\""), 3);
+    test_int(count_str(json, "\"name\":\"OnUpdate\",\"cat\":\"phase\""), 3);
+    test_int(count_str(json, "\"name\":\"Move\",\"cat\":\"system\""), 3);
+    test_int(count_str(json, "\"args\":{\"tables\":1,\"rows\":10}"), 3);
+    test_assert(count_str(json, "\"cat\":\"merge\"") != 0);
+
+    ecs_os_free(json);
+    remove(filename);
+
+    ecs_fini(world);
+}
+
+void World_trace_renamed_system() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, Dummy, EcsOnUpdate, Position);
+    ecs_new(world, Position);
+
+    char *name = ecs_os_strdup("Traced");
+    ecs_set(world, Dummy, EcsId, {name});
+
+    ecs_trace_start(world, 0);
+    ecs_progress(world, 1);
+    ecs_trace_stop(world);
+
+    /* The trace must not use the name the system had while it was traced */
+    ecs_set(world, Dummy, EcsId, {"Renamed"});
+    ecs_os_free(name);
+
+    const char *filename = "trace_renamed_system.json";
+    test_int(ecs_trace_write(world, filename), 0);
+
+    char *json = read_file(filename);
+    test_int(count_str(json, "\"name\":\"Renamed\",\"cat\":\"system\""), 1);
+
+    ecs_os_free(json);
+    remove(filename);
+
+    ecs_fini(world);
+}
+
+void World_trace_ring_buffer() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, Dummy, EcsOnUpdate, Position);
+    ecs_new(world, Position);
+
+    /* Capacity is rounded up to a power of 2 */
+    ecs_trace_start(world, 3);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_progress(world, 1);
+    }
+
+    ecs_trace_stop(world);
+
+    const char *filename = "trace_ring_buffer.json";
+    test_int(ecs_trace_write(world, filename), 0);
+
+    /* Only the most recent events are kept */
+    char *json = read_file(filename);
+    test_int(count_str(json, "\"ph\":\"X\""), 4);
+    test_int(count_str(json, "\"cat\":\"frame\""), 1);
+
+    ecs_os_free(json);
+    remove(filename);
+
+    ecs_fini(world);
+}
+
+void World_trace_threads() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, Move, EcsOnUpdate, Position, Velocity);
+    ECS_TYPE(world, Type, Position, Velocity);
+    ecs_new_w_count(world, Type, 100);
+
+    ecs_set_threads(world, 2);
+    ecs_trace_start(world, 0);
+
+    ecs_progress(world, 1);
+
+    ecs_trace_stop(world);
+
+    const char *filename = "trace_threads.json";
+    test_int(ecs_trace_write(world, filename), 0);
+
+    char *json = read_file(filename);
+    test_int(count_str(json, "\"name\":\"worker 1\""), 1);
+
+    /* Jobs may be ran by any thread, depending on which thread claims them */
+    int job_count = count_str(json, "\"cat\":\"job\"");
+    test_assert(job_count >= 2);
+    test_int(count_str(json, "\"name\":\"Move\",\"cat\":\"system\""), job_count);
+    test_int(count_str(json, "\"name\":\"merge_stage\""), 3);
+
+    ecs_os_free(json);
+    remove(filename);
+
+    ecs_fini(world);
+}
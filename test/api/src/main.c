@@ -21,6 +21,8 @@ void New_type_w_tag(void);
 void New_type_w_2_tags(void);
 void New_type_w_tag_mixed(void);
 void New_redefine_component(void);
+void New_aligned_component(void);
+void New_aligned_component_in_system(void);
 
 // Testsuite 'New_w_Count'
 void New_w_Count_empty(void);
@@ -103,6 +105,7 @@ void Add_add_2_remove(void);
 void Add_on_add_after_new_type_in_progress(void);
 void Add_add_entity(void);
 void Add_remove_entity(void);
+void Add_add_remove_twice(void);
 
 // Testsuite 'Remove'
 void Remove_zero(void);
@@ -120,6 +123,7 @@ void Remove_type_of_2_of_3(void);
 void Remove_1_from_empty(void);
 void Remove_type_from_empty(void);
 void Remove_not_added(void);
+void Remove_last_twice(void);
 
 // Testsuite 'Add_remove_w_filter'
 void Add_remove_w_filter_remove_1_no_filter(void);
@@ -199,6 +203,12 @@ void Delete_delete_2nd_of_3(void);
 void Delete_delete_2_of_3(void);
 void Delete_delete_3_of_3(void);
 void Delete_delete_w_on_remove(void);
+void Delete_delete_recycle(void);
+void Delete_delete_recycle_empty(void);
+void Delete_delete_stale_handle(void);
+void Delete_get_stale_handle(void);
+void Delete_delete_nonexist_is_alive(void);
+void Delete_delete_in_progress_recycle(void);
 
 // Testsuite 'Delete_w_filter'
 void Delete_w_filter_delete_1(void);
@@ -228,6 +238,7 @@ void Set_set_remove_other(void);
 void Set_set_remove_twice(void);
 void Set_set_and_new(void);
 void Set_set_null(void);
+void Set_set_w_large_id(void);
 
 // Testsuite 'Lookup'
 void Lookup_lookup(void);
@@ -241,6 +252,13 @@ void Lookup_lookup_w_null_id(void);
 void Lookup_get_id(void);
 void Lookup_get_id_no_id(void);
 void Lookup_get_id_from_empty(void);
+void Lookup_lookup_after_rename(void);
+void Lookup_lookup_after_delete(void);
+void Lookup_lookup_after_remove_id(void);
+void Lookup_lookup_child_adopt_after_id(void);
+void Lookup_lookup_child_many_parents(void);
+void Lookup_lookup_prefab(void);
+void Lookup_lookup_after_snapshot_restore(void);
 
 // Testsuite 'Singleton'
 void Singleton_set(void);
@@ -389,6 +407,8 @@ void SystemOnSet_on_set_after_override_w_new(void);
 void SystemOnSet_on_set_after_override_w_new_w_count(void);
 void SystemOnSet_on_set_after_override_1_of_2_overridden(void);
 void SystemOnSet_disabled_system(void);
+void SystemOnSet_set_w_from_entity_after_moved(void);
+void SystemOnSet_set_multiple_tables_again(void);
 
 // Testsuite 'SystemOnFrame'
 void SystemOnFrame_1_type_1_component(void);
@@ -439,6 +459,12 @@ void SystemOnFrame_use_field_w_0_size(void);
 void SystemOnFrame_owned_only(void);
 void SystemOnFrame_shared_only(void);
 void SystemOnFrame_is_in_readonly(void);
+void SystemOnFrame_changed_only_skip_unchanged(void);
+void SystemOnFrame_changed_only_after_set(void);
+void SystemOnFrame_changed_only_after_add(void);
+void SystemOnFrame_changed_only_after_out_system(void);
+void SystemOnFrame_changed_only_ignore_own_writes(void);
+void SystemOnFrame_changed_only_disable(void);
 
 // Testsuite 'SystemOnDemand'
 void SystemOnDemand_enable_out_after_in(void);
@@ -474,6 +500,9 @@ void SystemCascade_cascade_depth_1(void);
 void SystemCascade_cascade_depth_2(void);
 void SystemCascade_add_after_match(void);
 void SystemCascade_adopt_after_match(void);
+void SystemCascade_adopt_parent_after_match(void);
+void SystemCascade_adopt_parent_w_filter_after_match(void);
+void SystemCascade_toggle_table_w_matched_tables(void);
 
 // Testsuite 'SystemManual'
 void SystemManual_1_type_1_component(void);
@@ -518,6 +547,11 @@ void Container_get_parent_no_matching_comp(void);
 void Container_get_parent_two_parents(void);
 void Container_get_parent_no_parent(void);
 void Container_singleton_as_container(void);
+void Container_children_iter(void);
+void Container_children_iter_no_children(void);
+void Container_children_iter_after_adopt_orphan(void);
+void Container_children_iter_nested(void);
+void Container_children_iter_from_system(void);
 
 // Testsuite 'Prefab'
 void Prefab_new_w_prefab(void);
@@ -583,6 +617,11 @@ void Prefab_clone_after_inherit_in_on_add(void);
 void Prefab_override_from_nested(void);
 void Prefab_create_multiple_nested_w_on_add(void);
 void Prefab_create_multiple_nested_w_on_add_in_progress(void);
+void Prefab_rematch_nested_prefab(void);
+void Prefab_rematch_after_remove_from_base(void);
+void Prefab_cached_ptr_after_delete_from_prefab_table(void);
+void Prefab_prefab_w_children_new_w_count(void);
+void Prefab_prefab_w_child_recycle(void);
 
 // Testsuite 'System_w_FromContainer'
 void System_w_FromContainer_1_column_from_container(void);
@@ -623,6 +662,7 @@ void System_w_FromSystem_auto_add_tag(void);
 void System_w_FromEntity_2_column_1_from_entity(void);
 void System_w_FromEntity_task_from_entity(void);
 void System_w_FromEntity_task_not_from_entity(void);
+void System_w_FromEntity_add_component_to_source_after_match(void);
 
 // Testsuite 'World'
 void World_progress_w_0(void);
@@ -658,6 +698,14 @@ void World_init_w_args_enable_dbg(void);
 void World_no_threading(void);
 void World_no_time(void);
 void World_is_entity_enabled(void);
+void World_time_histogram(void);
+void World_system_time_stats(void);
+void World_thread_stats(void);
+void World_memory_stats(void);
+void World_trace_write(void);
+void World_trace_renamed_system(void);
+void World_trace_ring_buffer(void);
+void World_trace_threads(void);
 
 // Testsuite 'Type'
 void Type_type_of_1_tostr(void);
@@ -770,6 +818,11 @@ void MultiThread_change_thread_count(void);
 void MultiThread_multithread_quit(void);
 void MultiThread_schedule_w_tasks(void);
 void MultiThread_reactive_system(void);
+void MultiThread_6_thread_1000_entity_2_systems_many_frames(void);
+void MultiThread_6_thread_read_after_write(void);
+void MultiThread_6_thread_disjoint_writes(void);
+void MultiThread_tasks_on_main_thread(void);
+void MultiThread_periodic_changed_only(void);
 
 // Testsuite 'SingleThreadStaging'
 void SingleThreadStaging_new_empty(void);
@@ -837,6 +890,8 @@ void SingleThreadStaging_merge_table_w_container_added_on_set_reverse(void);
 void SingleThreadStaging_merge_after_tasks(void);
 void SingleThreadStaging_override_after_remove_in_progress(void);
 void SingleThreadStaging_get_parent_in_progress(void);
+void SingleThreadStaging_merge_interleaved_add_and_set(void);
+void SingleThreadStaging_merge_move_to_table_being_moved_from(void);
 
 // Testsuite 'MultiThreadStaging'
 void MultiThreadStaging_2_threads_add_to_current(void);
@@ -867,6 +922,16 @@ void Snapshot_snapshot_activate_table_w_filter(void);
 void Snapshot_snapshot_copy(void);
 void Snapshot_snapshot_copy_filtered(void);
 void Snapshot_snapshot_copy_w_filter(void);
+void Snapshot_snapshot_unchanged_after_system(void);
+void Snapshot_snapshot_unchanged_after_set(void);
+void Snapshot_snapshot_unchanged_after_new_w_count(void);
+void Snapshot_snapshot_restore_twice(void);
+void Snapshot_snapshot_unchanged_after_delete_many(void);
+void Snapshot_delta_restore_chain(void);
+void Snapshot_delta_only_changed_tables(void);
+void Snapshot_delta_skip_read_tables(void);
+void Snapshot_delta_restore_new_and_delete(void);
+void Snapshot_delta_after_system(void);
 
 // Testsuite 'ReaderWriter'
 void ReaderWriter_simple(void);
@@ -889,9 +954,19 @@ void ReaderWriter_snapshot_reader_id(void);
 void ReaderWriter_component_id_conflict_w_component(void);
 void ReaderWriter_component_id_conflict_w_entity(void);
 void ReaderWriter_component_size_conflict(void);
+void ReaderWriter_aligned_component(void);
 void ReaderWriter_read_zero_size(void);
 void ReaderWriter_write_zero_size(void);
 void ReaderWriter_invalid_header(void);
+void ReaderWriter_long_names(void);
+void ReaderWriter_same_output_for_buffer_sizes(void);
+void ReaderWriter_deserialize_after_snapshot(void);
+void ReaderWriter_image_simple(void);
+void ReaderWriter_image_modify_after_load(void);
+void ReaderWriter_image_snapshot(void);
+void ReaderWriter_image_component_size_conflict(void);
+void ReaderWriter_image_invalid_file(void);
+void ReaderWriter_image_unterminated_name(void);
 
 // Testsuite 'FilterIter'
 void FilterIter_iter_one_table(void);
@@ -902,6 +977,20 @@ void FilterIter_iter_snapshot_two_tables(void);
 void FilterIter_iter_snapshot_two_comps(void);
 void FilterIter_iter_snapshot_filtered_table(void);
 
+// Testsuite 'Query'
+void Query_iter_one_table(void);
+void Query_iter_two_tables(void);
+void Query_iter_w_exclude(void);
+void Query_match_new_table(void);
+void Query_match_new_table_after_merge(void);
+void Query_skip_empty_table(void);
+void Query_reactivate_table(void);
+void Query_delete_while_iterating(void);
+void Query_match_after_prefab_add(void);
+void Query_iter_from_system(void);
+void Query_iter_after_snapshot_restore(void);
+void Query_free(void);
+
 // Testsuite 'Modules'
 void Modules_simple_module(void);
 void Modules_import_module_from_system(void);
@@ -934,7 +1023,7 @@ void Error_log_error(void);
 static bake_test_suite suites[] = {
     {
         .id = "New",
-        .testcase_count = 12,
+        .testcase_count = 14,
         .testcases = (bake_test_case[]){
             {
                 .id = "empty",
@@ -983,6 +1072,14 @@ static bake_test_suite suites[] = {
             {
                 .id = "redefine_component",
                 .function = New_redefine_component
+            },
+            {
+                .id = "aligned_component",
+                .function = New_aligned_component
+            },
+            {
+                .id = "aligned_component_in_system",
+                .function = New_aligned_component_in_system
             }
         }
     },
@@ -1180,7 +1277,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "Add",
-        .testcase_count = 31,
+        .testcase_count = 32,
         .testcases = (bake_test_case[]){
             {
                 .id = "zero",
@@ -1305,12 +1402,16 @@ static bake_test_suite suites[] = {
             {
                 .id = "remove_entity",
                 .function = Add_remove_entity
+            },
+            {
+                .id = "add_remove_twice",
+                .function = Add_add_remove_twice
             }
         }
     },
     {
         .id = "Remove",
-        .testcase_count = 15,
+        .testcase_count = 16,
         .testcases = (bake_test_case[]){
             {
                 .id = "zero",
@@ -1371,6 +1472,10 @@ static bake_test_suite suites[] = {
             {
                 .id = "not_added",
                 .function = Remove_not_added
+            },
+            {
+                .id = "last_twice",
+                .function = Remove_last_twice
             }
         }
     },
@@ -1640,7 +1745,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "Delete",
-        .testcase_count = 9,
+        .testcase_count = 15,
         .testcases = (bake_test_case[]){
             {
                 .id = "delete_1",
@@ -1677,6 +1782,30 @@ static bake_test_suite suites[] = {
             {
                 .id = "delete_w_on_remove",
                 .function = Delete_delete_w_on_remove
+            },
+            {
+                .id = "delete_recycle",
+                .function = Delete_delete_recycle
+            },
+            {
+                .id = "delete_recycle_empty",
+                .function = Delete_delete_recycle_empty
+            },
+            {
+                .id = "delete_stale_handle",
+                .function = Delete_delete_stale_handle
+            },
+            {
+                .id = "get_stale_handle",
+                .function = Delete_get_stale_handle
+            },
+            {
+                .id = "delete_nonexist_is_alive",
+                .function = Delete_delete_nonexist_is_alive
+            },
+            {
+                .id = "delete_in_progress_recycle",
+                .function = Delete_delete_in_progress_recycle
             }
         }
     },
@@ -1736,7 +1865,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "Set",
-        .testcase_count = 13,
+        .testcase_count = 14,
         .testcases = (bake_test_case[]){
             {
                 .id = "set_empty",
@@ -1789,12 +1918,16 @@ static bake_test_suite suites[] = {
             {
                 .id = "set_null",
                 .function = Set_set_null
+            },
+            {
+                .id = "set_w_large_id",
+                .function = Set_set_w_large_id
             }
         }
     },
     {
         .id = "Lookup",
-        .testcase_count = 11,
+        .testcase_count = 18,
         .testcases = (bake_test_case[]){
             {
                 .id = "lookup",
@@ -1839,6 +1972,34 @@ static bake_test_suite suites[] = {
             {
                 .id = "get_id_from_empty",
                 .function = Lookup_get_id_from_empty
+            },
+            {
+                .id = "lookup_after_rename",
+                .function = Lookup_lookup_after_rename
+            },
+            {
+                .id = "lookup_after_delete",
+                .function = Lookup_lookup_after_delete
+            },
+            {
+                .id = "lookup_after_remove_id",
+                .function = Lookup_lookup_after_remove_id
+            },
+            {
+                .id = "lookup_child_adopt_after_id",
+                .function = Lookup_lookup_child_adopt_after_id
+            },
+            {
+                .id = "lookup_child_many_parents",
+                .function = Lookup_lookup_child_many_parents
+            },
+            {
+                .id = "lookup_prefab",
+                .function = Lookup_lookup_prefab
+            },
+            {
+                .id = "lookup_after_snapshot_restore",
+                .function = Lookup_lookup_after_snapshot_restore
             }
         }
     },
@@ -2354,7 +2515,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "SystemOnSet",
-        .testcase_count = 16,
+        .testcase_count = 18,
         .testcases = (bake_test_case[]){
             {
                 .id = "set",
@@ -2419,12 +2580,20 @@ static bake_test_suite suites[] = {
             {
                 .id = "disabled_system",
                 .function = SystemOnSet_disabled_system
+            },
+            {
+                .id = "set_w_from_entity_after_moved",
+                .function = SystemOnSet_set_w_from_entity_after_moved
+            },
+            {
+                .id = "set_multiple_tables_again",
+                .function = SystemOnSet_set_multiple_tables_again
             }
         }
     },
     {
         .id = "SystemOnFrame",
-        .testcase_count = 48,
+        .testcase_count = 54,
         .testcases = (bake_test_case[]){
             {
                 .id = "1_type_1_component",
@@ -2617,6 +2786,30 @@ static bake_test_suite suites[] = {
             {
                 .id = "is_in_readonly",
                 .function = SystemOnFrame_is_in_readonly
+            },
+            {
+                .id = "changed_only_skip_unchanged",
+                .function = SystemOnFrame_changed_only_skip_unchanged
+            },
+            {
+                .id = "changed_only_after_set",
+                .function = SystemOnFrame_changed_only_after_set
+            },
+            {
+                .id = "changed_only_after_add",
+                .function = SystemOnFrame_changed_only_after_add
+            },
+            {
+                .id = "changed_only_after_out_system",
+                .function = SystemOnFrame_changed_only_after_out_system
+            },
+            {
+                .id = "changed_only_ignore_own_writes",
+                .function = SystemOnFrame_changed_only_ignore_own_writes
+            },
+            {
+                .id = "changed_only_disable",
+                .function = SystemOnFrame_changed_only_disable
             }
         }
     },
@@ -2736,7 +2929,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "SystemCascade",
-        .testcase_count = 4,
+        .testcase_count = 7,
         .testcases = (bake_test_case[]){
             {
                 .id = "cascade_depth_1",
@@ -2753,6 +2946,18 @@ static bake_test_suite suites[] = {
             {
                 .id = "adopt_after_match",
                 .function = SystemCascade_adopt_after_match
+            },
+            {
+                .id = "adopt_parent_after_match",
+                .function = SystemCascade_adopt_parent_after_match
+            },
+            {
+                .id = "adopt_parent_w_filter_after_match",
+                .function = SystemCascade_adopt_parent_w_filter_after_match
+            },
+            {
+                .id = "toggle_table_w_matched_tables",
+                .function = SystemCascade_toggle_table_w_matched_tables
             }
         }
     },
@@ -2814,7 +3019,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "Container",
-        .testcase_count = 27,
+        .testcase_count = 32,
         .testcases = (bake_test_case[]){
             {
                 .id = "child",
@@ -2923,12 +3128,32 @@ static bake_test_suite suites[] = {
             {
                 .id = "singleton_as_container",
                 .function = Container_singleton_as_container
+            },
+            {
+                .id = "children_iter",
+                .function = Container_children_iter
+            },
+            {
+                .id = "children_iter_no_children",
+                .function = Container_children_iter_no_children
+            },
+            {
+                .id = "children_iter_after_adopt_orphan",
+                .function = Container_children_iter_after_adopt_orphan
+            },
+            {
+                .id = "children_iter_nested",
+                .function = Container_children_iter_nested
+            },
+            {
+                .id = "children_iter_from_system",
+                .function = Container_children_iter_from_system
             }
         }
     },
     {
         .id = "Prefab",
-        .testcase_count = 63,
+        .testcase_count = 68,
         .testcases = (bake_test_case[]){
             {
                 .id = "new_w_prefab",
@@ -3181,6 +3406,26 @@ static bake_test_suite suites[] = {
             {
                 .id = "create_multiple_nested_w_on_add_in_progress",
                 .function = Prefab_create_multiple_nested_w_on_add_in_progress
+            },
+            {
+                .id = "rematch_nested_prefab",
+                .function = Prefab_rematch_nested_prefab
+            },
+            {
+                .id = "rematch_after_remove_from_base",
+                .function = Prefab_rematch_after_remove_from_base
+            },
+            {
+                .id = "cached_ptr_after_delete_from_prefab_table",
+                .function = Prefab_cached_ptr_after_delete_from_prefab_table
+            },
+            {
+                .id = "prefab_w_children_new_w_count",
+                .function = Prefab_prefab_w_children_new_w_count
+            },
+            {
+                .id = "prefab_w_child_recycle",
+                .function = Prefab_prefab_w_child_recycle
             }
         }
     },
@@ -3320,7 +3565,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "System_w_FromEntity",
-        .testcase_count = 3,
+        .testcase_count = 4,
         .testcases = (bake_test_case[]){
             {
                 .id = "2_column_1_from_entity",
@@ -3333,12 +3578,16 @@ static bake_test_suite suites[] = {
             {
                 .id = "task_not_from_entity",
                 .function = System_w_FromEntity_task_not_from_entity
+            },
+            {
+                .id = "add_component_to_source_after_match",
+                .function = System_w_FromEntity_add_component_to_source_after_match
             }
         }
     },
     {
         .id = "World",
-        .testcase_count = 33,
+        .testcase_count = 41,
         .testcases = (bake_test_case[]){
             {
                 .id = "progress_w_0",
@@ -3471,6 +3720,38 @@ static bake_test_suite suites[] = {
             {
                 .id = "is_entity_enabled",
                 .function = World_is_entity_enabled
+            },
+            {
+                .id = "time_histogram",
+                .function = World_time_histogram
+            },
+            {
+                .id = "system_time_stats",
+                .function = World_system_time_stats
+            },
+            {
+                .id = "thread_stats",
+                .function = World_thread_stats
+            },
+            {
+                .id = "memory_stats",
+                .function = World_memory_stats
+            },
+            {
+                .id = "trace_write",
+                .function = World_trace_write
+            },
+            {
+                .id = "trace_renamed_system",
+                .function = World_trace_renamed_system
+            },
+            {
+                .id = "trace_ring_buffer",
+                .function = World_trace_ring_buffer
+            },
+            {
+                .id = "trace_threads",
+                .function = World_trace_threads
             }
         }
     },
@@ -3776,7 +4057,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "MultiThread",
-        .testcase_count = 34,
+        .testcase_count = 39,
         .testcases = (bake_test_case[]){
             {
                 .id = "2_thread_1_entity",
@@ -3913,12 +4194,32 @@ static bake_test_suite suites[] = {
             {
                 .id = "reactive_system",
                 .function = MultiThread_reactive_system
+            },
+            {
+                .id = "6_thread_1000_entity_2_systems_many_frames",
+                .function = MultiThread_6_thread_1000_entity_2_systems_many_frames
+            },
+            {
+                .id = "6_thread_read_after_write",
+                .function = MultiThread_6_thread_read_after_write
+            },
+            {
+                .id = "6_thread_disjoint_writes",
+                .function = MultiThread_6_thread_disjoint_writes
+            },
+            {
+                .id = "tasks_on_main_thread",
+                .function = MultiThread_tasks_on_main_thread
+            },
+            {
+                .id = "periodic_changed_only",
+                .function = MultiThread_periodic_changed_only
             }
         }
     },
     {
         .id = "SingleThreadStaging",
-        .testcase_count = 65,
+        .testcase_count = 67,
         .testcases = (bake_test_case[]){
             {
                 .id = "new_empty",
@@ -4179,6 +4480,14 @@ static bake_test_suite suites[] = {
             {
                 .id = "get_parent_in_progress",
                 .function = SingleThreadStaging_get_parent_in_progress
+            },
+            {
+                .id = "merge_interleaved_add_and_set",
+                .function = SingleThreadStaging_merge_interleaved_add_and_set
+            },
+            {
+                .id = "merge_move_to_table_being_moved_from",
+                .function = SingleThreadStaging_merge_move_to_table_being_moved_from
             }
         }
     },
@@ -4226,7 +4535,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "Snapshot",
-        .testcase_count = 17,
+        .testcase_count = 27,
         .testcases = (bake_test_case[]){
             {
                 .id = "simple_snapshot",
@@ -4295,12 +4604,52 @@ static bake_test_suite suites[] = {
             {
                 .id = "snapshot_copy_w_filter",
                 .function = Snapshot_snapshot_copy_w_filter
+            },
+            {
+                .id = "snapshot_unchanged_after_system",
+                .function = Snapshot_snapshot_unchanged_after_system
+            },
+            {
+                .id = "snapshot_unchanged_after_set",
+                .function = Snapshot_snapshot_unchanged_after_set
+            },
+            {
+                .id = "snapshot_unchanged_after_new_w_count",
+                .function = Snapshot_snapshot_unchanged_after_new_w_count
+            },
+            {
+                .id = "snapshot_restore_twice",
+                .function = Snapshot_snapshot_restore_twice
+            },
+            {
+                .id = "snapshot_unchanged_after_delete_many",
+                .function = Snapshot_snapshot_unchanged_after_delete_many
+            },
+            {
+                .id = "delta_restore_chain",
+                .function = Snapshot_delta_restore_chain
+            },
+            {
+                .id = "delta_only_changed_tables",
+                .function = Snapshot_delta_only_changed_tables
+            },
+            {
+                .id = "delta_skip_read_tables",
+                .function = Snapshot_delta_skip_read_tables
+            },
+            {
+                .id = "delta_restore_new_and_delete",
+                .function = Snapshot_delta_restore_new_and_delete
+            },
+            {
+                .id = "delta_after_system",
+                .function = Snapshot_delta_after_system
             }
         }
     },
     {
         .id = "ReaderWriter",
-        .testcase_count = 23,
+        .testcase_count = 33,
         .testcases = (bake_test_case[]){
             {
                 .id = "simple",
@@ -4382,6 +4731,10 @@ static bake_test_suite suites[] = {
                 .id = "component_size_conflict",
                 .function = ReaderWriter_component_size_conflict
             },
+            {
+                .id = "aligned_component",
+                .function = ReaderWriter_aligned_component
+            },
             {
                 .id = "read_zero_size",
                 .function = ReaderWriter_read_zero_size
@@ -4393,6 +4746,42 @@ static bake_test_suite suites[] = {
             {
                 .id = "invalid_header",
                 .function = ReaderWriter_invalid_header
+            },
+            {
+                .id = "long_names",
+                .function = ReaderWriter_long_names
+            },
+            {
+                .id = "same_output_for_buffer_sizes",
+                .function = ReaderWriter_same_output_for_buffer_sizes
+            },
+            {
+                .id = "deserialize_after_snapshot",
+                .function = ReaderWriter_deserialize_after_snapshot
+            },
+            {
+                .id = "image_simple",
+                .function = ReaderWriter_image_simple
+            },
+            {
+                .id = "image_modify_after_load",
+                .function = ReaderWriter_image_modify_after_load
+            },
+            {
+                .id = "image_snapshot",
+                .function = ReaderWriter_image_snapshot
+            },
+            {
+                .id = "image_component_size_conflict",
+                .function = ReaderWriter_image_component_size_conflict
+            },
+            {
+                .id = "image_invalid_file",
+                .function = ReaderWriter_image_invalid_file
+            },
+            {
+                .id = "image_unterminated_name",
+                .function = ReaderWriter_image_unterminated_name
             }
         }
     },
@@ -4430,6 +4819,60 @@ static bake_test_suite suites[] = {
             }
         }
     },
+    {
+        .id = "Query",
+        .testcase_count = 12,
+        .testcases = (bake_test_case[]){
+            {
+                .id = "iter_one_table",
+                .function = Query_iter_one_table
+            },
+            {
+                .id = "iter_two_tables",
+                .function = Query_iter_two_tables
+            },
+            {
+                .id = "iter_w_exclude",
+                .function = Query_iter_w_exclude
+            },
+            {
+                .id = "match_new_table",
+                .function = Query_match_new_table
+            },
+            {
+                .id = "match_new_table_after_merge",
+                .function = Query_match_new_table_after_merge
+            },
+            {
+                .id = "skip_empty_table",
+                .function = Query_skip_empty_table
+            },
+            {
+                .id = "reactivate_table",
+                .function = Query_reactivate_table
+            },
+            {
+                .id = "delete_while_iterating",
+                .function = Query_delete_while_iterating
+            },
+            {
+                .id = "match_after_prefab_add",
+                .function = Query_match_after_prefab_add
+            },
+            {
+                .id = "iter_from_system",
+                .function = Query_iter_from_system
+            },
+            {
+                .id = "iter_after_snapshot_restore",
+                .function = Query_iter_after_snapshot_restore
+            },
+            {
+                .id = "free",
+                .function = Query_free
+            }
+        }
+    },
     {
         .id = "Modules",
         .testcase_count = 5,
@@ -4541,5 +4984,5 @@ static bake_test_suite suites[] = {
 
 int main(int argc, char *argv[]) {
     ut_init(argv[0]);
-    return bake_test_run("api", argc, argv, suites, 42);
+    return bake_test_run("api", argc, argv, suites, 43);
 }
@@ -0,0 +1,44 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+/* This generated file contains includes for project dependencies */
+#include "bench/bake_config.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of times each benchmark repeats its workload */
+#define BENCH_ITERATIONS (10)
+
+/* Print result of a benchmark as operations per second and latency */
+void bench_report(
+    const char *id,
+    double seconds,
+    uint64_t ops);
+
+/* -- Benchmarks -- */
+
+void AddRemove(void);
+void ChangedOnly(void);
+void Children(void);
+void GetSet(void);
+void Map(void);
+void MemoryStats(void);
+void MergeStaged(void);
+void MoveSimd(void);
+void NewDelete(void);
+void PrefabChildren(void);
+void Query(void);
+void SaveToFile(void);
+void StageAlloc(void);
+void TableActivation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
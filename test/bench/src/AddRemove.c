@@ -0,0 +1,105 @@
+#include <bench.h>
+
+#define ENTITY_COUNT (100000)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+/* Add and remove a single tag to every entity. After the first iteration each
+ * transition is resolved through the cached table edges. */
+static
+void add_remove_tag(
+    ecs_world_t *world,
+    ecs_entity_t first,
+    ecs_type_t tag)
+{
+    ecs_time_t start;
+    uint32_t i, e;
+
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < BENCH_ITERATIONS; i ++) {
+        for (e = 0; e < ENTITY_COUNT; e ++) {
+            _ecs_add(world, first + e, tag);
+        }
+        for (e = 0; e < ENTITY_COUNT; e ++) {
+            _ecs_remove(world, first + e, tag);
+        }
+    }
+
+    bench_report("add_remove_1_tag", ecs_time_measure(&start), 
+        (uint64_t)ENTITY_COUNT * BENCH_ITERATIONS * 2);
+}
+
+/* Add and remove a type with two tags. Types with more than one element do not
+ * use the table edges, and merge the type on each operation. */
+static
+void add_remove_type(
+    ecs_world_t *world,
+    ecs_entity_t first,
+    ecs_type_t type)
+{
+    ecs_time_t start;
+    uint32_t i, e;
+
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < BENCH_ITERATIONS; i ++) {
+        for (e = 0; e < ENTITY_COUNT; e ++) {
+            _ecs_add(world, first + e, type);
+        }
+        for (e = 0; e < ENTITY_COUNT; e ++) {
+            _ecs_remove(world, first + e, type);
+        }
+    }
+
+    bench_report("add_remove_type_of_2_tags", ecs_time_measure(&start), 
+        (uint64_t)ENTITY_COUNT * BENCH_ITERATIONS * 2);
+}
+
+/* Cycle entities through four tables by toggling tags one at a time */
+static
+void toggle_tags(
+    ecs_world_t *world,
+    ecs_entity_t first,
+    ecs_type_t tag_a,
+    ecs_type_t tag_b)
+{
+    ecs_time_t start;
+    uint32_t i, e;
+
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < BENCH_ITERATIONS; i ++) {
+        for (e = 0; e < ENTITY_COUNT; e ++) {
+            ecs_entity_t entity = first + e;
+            _ecs_add(world, entity, tag_a);
+            _ecs_add(world, entity, tag_b);
+            _ecs_remove(world, entity, tag_a);
+            _ecs_remove(world, entity, tag_b);
+        }
+    }
+
+    bench_report("toggle_2_tags", ecs_time_measure(&start), 
+        (uint64_t)ENTITY_COUNT * BENCH_ITERATIONS * 4);
+}
+
+void AddRemove(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, TagA);
+    ECS_TAG(world, TagB);
+    ECS_TYPE(world, TagAB, TagA, TagB);
+
+    ecs_dim_type(world, Position, ENTITY_COUNT);
+    ecs_entity_t first = ecs_new_w_count(world, Position, ENTITY_COUNT);
+
+    add_remove_tag(world, first, ecs_type(TagA));
+    add_remove_type(world, first, ecs_type(TagAB));
+    toggle_tags(world, first, ecs_type(TagA), ecs_type(TagB));
+
+    ecs_fini(world);
+}
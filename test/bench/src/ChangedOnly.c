@@ -0,0 +1,69 @@
+#include <bench.h>
+
+#define TABLE_COUNT (256)
+#define ENTITY_COUNT (64)
+#define FRAME_COUNT (1000)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+static float sum;
+
+static
+void Sum(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        sum += p[i].x + p[i].y;
+    }
+}
+
+/* Progress the world while setting a component on a single entity per frame,
+ * so that only one of the tables the system reads from changes each frame */
+static
+void run_frames(
+    const char *id,
+    bool changed_only)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, Sum, EcsOnUpdate, [in] Position);
+    ecs_set_changed_only(world, Sum, changed_only);
+
+    ecs_entity_t *entities = ecs_os_malloc(sizeof(ecs_entity_t) * TABLE_COUNT);
+
+    uint32_t i, t;
+    for (t = 0; t < TABLE_COUNT; t ++) {
+        ecs_entity_t tag = ecs_new(world, 0);
+        ecs_type_t type = ecs_type_from_entity(world, tag);
+        for (i = 0; i < ENTITY_COUNT; i ++) {
+            ecs_entity_t e = ecs_set(world, 0, Position, {i, t});
+            _ecs_add(world, e, type);
+            entities[t] = e;
+        }
+    }
+
+    ecs_progress(world, 0);
+
+    ecs_time_t start;
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < FRAME_COUNT; i ++) {
+        ecs_set(world, entities[i % TABLE_COUNT], Position, {i, i});
+        ecs_progress(world, 0);
+    }
+
+    bench_report(id, ecs_time_measure(&start), FRAME_COUNT);
+
+    ecs_os_free(entities);
+    ecs_fini(world);
+}
+
+void ChangedOnly(void) {
+    run_frames("all_tables", false);
+    run_frames("changed_only", true);
+}
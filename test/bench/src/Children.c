@@ -0,0 +1,82 @@
+#include <bench.h>
+
+#define PARENT_COUNT (1000)
+#define CHILD_COUNT (16)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+static ecs_entity_t parents[PARENT_COUNT];
+
+static
+ecs_world_t* create_hierarchy(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    uint32_t i;
+    for (i = 0; i < PARENT_COUNT; i ++) {
+        parents[i] = ecs_set(world, 0, Position, {i, i});
+        ecs_new_child_w_count(world, parents[i], Position, CHILD_COUNT);
+    }
+
+    return world;
+}
+
+/* Find children of each parent by matching all tables with a filter */
+static
+void children_filter(void) {
+    ecs_world_t *world = create_hierarchy();
+    uint64_t count = 0;
+
+    ecs_time_t start;
+    ecs_os_get_time(&start);
+
+    uint32_t i, p;
+    for (i = 0; i < BENCH_ITERATIONS; i ++) {
+        for (p = 0; p < PARENT_COUNT; p ++) {
+            ecs_type_t type = ecs_type_find(
+                world, &(ecs_entity_t){parents[p] | ECS_CHILDOF}, 1);
+            ecs_filter_t filter = {.include = type};
+            ecs_filter_iter_t it = ecs_filter_iter(world, &filter);
+            while (ecs_filter_next(&it)) {
+                count += it.rows.count;
+            }
+        }
+    }
+
+    bench_report("filter", ecs_time_measure(&start), count);
+
+    ecs_fini(world);
+}
+
+/* Find children of each parent with the parent to child tables index */
+static
+void children_iter(void) {
+    ecs_world_t *world = create_hierarchy();
+    uint64_t count = 0;
+
+    ecs_time_t start;
+    ecs_os_get_time(&start);
+
+    uint32_t i, p;
+    for (i = 0; i < BENCH_ITERATIONS; i ++) {
+        for (p = 0; p < PARENT_COUNT; p ++) {
+            ecs_children_iter_t it = ecs_children_iter(world, parents[p]);
+            while (ecs_children_next(&it)) {
+                count += it.rows.count;
+            }
+        }
+    }
+
+    bench_report("children_iter", ecs_time_measure(&start), count);
+
+    ecs_fini(world);
+}
+
+void Children(void) {
+    children_filter();
+    children_iter();
+}
@@ -0,0 +1,100 @@
+#include <bench.h>
+
+#define ENTITY_COUNT (100000)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+/* Get a component from every entity. Each call looks up the entity in the
+ * entity index before it can access the component data. */
+static
+void get_component(
+    ecs_world_t *world,
+    ecs_entity_t first,
+    ecs_type_t ecs_type(Position))
+{
+    ecs_time_t start;
+    uint32_t i, e;
+    float sum = 0;
+
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < BENCH_ITERATIONS; i ++) {
+        for (e = 0; e < ENTITY_COUNT; e ++) {
+            Position *p = ecs_get_ptr(world, first + e, Position);
+            sum += p->x;
+        }
+    }
+
+    bench_report("get_1_component", ecs_time_measure(&start), 
+        (uint64_t)ENTITY_COUNT * BENCH_ITERATIONS);
+
+    /* Prevent the loop from being optimized away */
+    if (sum < 0) {
+        printf("%f\n", sum);
+    }
+}
+
+/* Set an existing component on every entity */
+static
+void set_component(
+    ecs_world_t *world,
+    ecs_entity_t first,
+    ecs_entity_t ecs_entity(Position))
+{
+    ecs_time_t start;
+    uint32_t i, e;
+
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < BENCH_ITERATIONS; i ++) {
+        for (e = 0; e < ENTITY_COUNT; e ++) {
+            ecs_set(world, first + e, Position, {e, i});
+        }
+    }
+
+    bench_report("set_1_component", ecs_time_measure(&start), 
+        (uint64_t)ENTITY_COUNT * BENCH_ITERATIONS);
+}
+
+/* Test whether every entity has a component */
+static
+void has_component(
+    ecs_world_t *world,
+    ecs_entity_t first,
+    ecs_type_t ecs_type(Position))
+{
+    ecs_time_t start;
+    uint32_t i, e, count = 0;
+
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < BENCH_ITERATIONS; i ++) {
+        for (e = 0; e < ENTITY_COUNT; e ++) {
+            count += ecs_has(world, first + e, Position);
+        }
+    }
+
+    bench_report("has_1_component", ecs_time_measure(&start), 
+        (uint64_t)ENTITY_COUNT * BENCH_ITERATIONS);
+
+    if (count != ENTITY_COUNT * BENCH_ITERATIONS) {
+        printf("unexpected count %u\n", count);
+    }
+}
+
+void GetSet(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t first = ecs_new_w_count(world, Position, ENTITY_COUNT);
+
+    get_component(world, first, ecs_type(Position));
+    set_component(world, first, ecs_entity(Position));
+    has_component(world, first, ecs_type(Position));
+
+    ecs_fini(world);
+}
@@ -0,0 +1,175 @@
+#include <bench.h>
+
+#define MIN_KEY_COUNT (1000)
+#define MAX_KEY_COUNT (10000000)
+
+/* Total number of operations per measurement, so that small maps are
+ * measured as accurately as large maps */
+#define OPS_PER_MEASUREMENT (10000000)
+
+/* Keys are spread out like entity ids and pointers would be */
+static
+uint64_t key_at(
+    uint64_t i)
+{
+    uint64_t z = i + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    return (z ^ (z >> 27)) >> 16;
+}
+
+static
+void report(
+    const char *op,
+    uint32_t key_count,
+    double seconds,
+    uint64_t ops)
+{
+    char id[64];
+    sprintf(id, "%s_%u", op, key_count);
+    bench_report(id, seconds, ops);
+}
+
+static
+void fill(
+    ecs_map_t *map,
+    uint64_t *keys,
+    uint32_t key_count)
+{
+    uint32_t i;
+    for (i = 0; i < key_count; i ++) {
+        ecs_map_set(map, keys[i], &keys[i]);
+    }
+}
+
+static
+void map_insert(
+    uint64_t *keys,
+    uint32_t key_count,
+    uint32_t repeat)
+{
+    ecs_time_t start;
+    ecs_os_get_time(&start);
+
+    uint32_t r;
+    for (r = 0; r < repeat; r ++) {
+        ecs_map_t *map = ecs_map_new(0, sizeof(uint64_t));
+        fill(map, keys, key_count);
+        ecs_map_free(map);
+    }
+
+    report("insert", key_count, ecs_time_measure(&start), 
+        (uint64_t)key_count * repeat);
+}
+
+static
+void map_lookup(
+    ecs_map_t *map,
+    uint64_t *keys,
+    uint32_t key_count,
+    uint32_t repeat)
+{
+    uint64_t sum = 0;
+
+    ecs_time_t start;
+    ecs_os_get_time(&start);
+
+    uint32_t r, i;
+    for (r = 0; r < repeat; r ++) {
+        for (i = 0; i < key_count; i ++) {
+            sum += *(uint64_t*)ecs_map_get_ptr(map, keys[i]);
+        }
+    }
+
+    report("lookup", key_count, ecs_time_measure(&start), 
+        (uint64_t)key_count * repeat);
+
+    if (!sum) {
+        printf("unexpected sum\n");
+    }
+}
+
+static
+void map_iterate(
+    ecs_map_t *map,
+    uint32_t key_count,
+    uint32_t repeat)
+{
+    uint64_t sum = 0;
+
+    ecs_time_t start;
+    ecs_os_get_time(&start);
+
+    uint32_t r;
+    for (r = 0; r < repeat; r ++) {
+        ecs_map_iter_t it = ecs_map_iter(map);
+        while (ecs_map_hasnext(&it)) {
+            sum += ecs_map_next64(&it);
+        }
+    }
+
+    report("iterate", key_count, ecs_time_measure(&start), 
+        (uint64_t)key_count * repeat);
+
+    if (!sum) {
+        printf("unexpected sum\n");
+    }
+}
+
+static
+void map_remove(
+    uint64_t *keys,
+    uint32_t key_count,
+    uint32_t repeat)
+{
+    double seconds = 0;
+
+    uint32_t r, i;
+    for (r = 0; r < repeat; r ++) {
+        ecs_map_t *map = ecs_map_new(0, sizeof(uint64_t));
+        fill(map, keys, key_count);
+
+        ecs_time_t start;
+        ecs_os_get_time(&start);
+
+        for (i = 0; i < key_count; i ++) {
+            ecs_map_remove(map, keys[i]);
+        }
+
+        seconds += ecs_time_measure(&start);
+        ecs_map_free(map);
+    }
+
+    report("remove", key_count, seconds, (uint64_t)key_count * repeat);
+}
+
+void Map(void) {
+    /* Maps only need the OS API, which is set when a world is created */
+    ecs_world_t *world = ecs_init();
+
+    uint64_t *keys = ecs_os_malloc(sizeof(uint64_t) * MAX_KEY_COUNT);
+
+    uint32_t i;
+    for (i = 0; i < MAX_KEY_COUNT; i ++) {
+        keys[i] = key_at(i);
+    }
+
+    uint32_t key_count;
+    for (key_count = MIN_KEY_COUNT; key_count <= MAX_KEY_COUNT; 
+        key_count *= 10) 
+    {
+        uint32_t repeat = OPS_PER_MEASUREMENT / key_count;
+
+        map_insert(keys, key_count, repeat);
+
+        ecs_map_t *map = ecs_map_new(0, sizeof(uint64_t));
+        fill(map, keys, key_count);
+        map_lookup(map, keys, key_count, repeat);
+        map_iterate(map, key_count, repeat);
+        ecs_map_free(map);
+
+        map_remove(keys, key_count, repeat);
+    }
+
+    ecs_os_free(keys);
+    ecs_fini(world);
+}
@@ -0,0 +1,79 @@
+#include <bench.h>
+
+#define MIN_TABLE_COUNT (100)
+#define MAX_TABLE_COUNT (10000)
+#define ENTITY_COUNT (100)
+#define COLLECT_COUNT (10000)
+#define FRAME_COUNT (100)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+/* Collect memory stats in worlds with an increasing number of tables. Memory
+ * of table columns is kept up to date by the tables, so the time it takes to
+ * collect stats should not depend on the number of tables. */
+static
+void collect_memory_stats(
+    uint32_t table_count)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsStats, 0);
+
+    ECS_COMPONENT(world, Position);
+
+    /* Give each table a unique tag */
+    uint32_t i;
+    for (i = 0; i < table_count; i ++) {
+        ecs_entity_t tag = ecs_new(world, 0);
+        ecs_entity_t e = ecs_new_w_count(world, Position, ENTITY_COUNT);
+        ecs_type_t type = ecs_type_from_entity(world, tag);
+
+        uint32_t j;
+        for (j = 0; j < ENTITY_COUNT; j ++) {
+            _ecs_add(world, e + j, type);
+        }
+    }
+
+    ecs_new_system(world, "CollectMemoryStats", EcsManual, 
+        "[in] EcsMemoryStats", NULL);
+
+    /* Adds EcsMemoryStats to the world */
+    ecs_progress(world, 1);
+
+    ecs_entity_t system = ecs_lookup(world, "StatsCollectMemoryStats");
+
+    ecs_time_t start;
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < COLLECT_COUNT; i ++) {
+        ecs_run(world, system, 0, NULL);
+    }
+
+    char id[64];
+    sprintf(id, "collect_memory_stats_%u", table_count);
+    bench_report(id, ecs_time_measure(&start), COLLECT_COUNT);
+
+    /* Frames collect all stats of the module, including table stats */
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < FRAME_COUNT; i ++) {
+        ecs_progress(world, 1);
+    }
+
+    sprintf(id, "stats_frame_%u", table_count);
+    bench_report(id, ecs_time_measure(&start), FRAME_COUNT);
+
+    ecs_fini(world);
+}
+
+void MemoryStats(void) {
+    uint32_t table_count;
+    for (table_count = MIN_TABLE_COUNT; table_count <= MAX_TABLE_COUNT; 
+        table_count *= 10) 
+    {
+        collect_memory_stats(table_count);
+    }
+}
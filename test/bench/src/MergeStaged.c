@@ -0,0 +1,101 @@
+#include <bench.h>
+
+#define ENTITY_COUNT (100000)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+typedef struct Velocity {
+    float x;
+    float y;
+} Velocity;
+
+static
+void Spawn(ecs_rows_t *rows) {
+    ECS_COLUMN_COMPONENT(rows, Position, 2);
+
+    uint32_t i;
+    for (i = 0; i < ENTITY_COUNT; i ++) {
+        ecs_set(rows->world, 0, Position, {i, i});
+    }
+}
+
+static
+void AddVelocity(ecs_rows_t *rows) {
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_set(rows->world, rows->entities[i], Velocity, {i, i});
+    }
+}
+
+/* Run a frame without merging, and measure the time spent merging the staged
+ * changes of the frame. */
+static
+double measure_merge(
+    ecs_world_t *world)
+{
+    ecs_time_t start;
+
+    ecs_set_automerge(world, false);
+    ecs_progress(world, 0);
+
+    ecs_os_get_time(&start);
+    ecs_merge(world);
+    return ecs_time_measure(&start);
+}
+
+/* Create entities in a system, so that they are all created in the stage */
+static
+void merge_new(void) {
+    double seconds = 0;
+    uint32_t i;
+
+    for (i = 0; i < BENCH_ITERATIONS; i ++) {
+        ecs_world_t *world = ecs_init();
+
+        ECS_COMPONENT(world, Position);
+        ECS_SYSTEM(world, Spawn, EcsOnUpdate, SYSTEM.EcsHidden, .Position);
+
+        seconds += measure_merge(world);
+
+        ecs_fini(world);
+    }
+
+    bench_report("merge_new", seconds, 
+        (uint64_t)ENTITY_COUNT * BENCH_ITERATIONS);
+}
+
+/* Add a component to existing entities in a system, so that all entities move
+ * to another table when the stage is merged */
+static
+void merge_add(void) {
+    double seconds = 0;
+    uint32_t i;
+
+    for (i = 0; i < BENCH_ITERATIONS; i ++) {
+        ecs_world_t *world = ecs_init();
+
+        ECS_COMPONENT(world, Position);
+        ECS_COMPONENT(world, Velocity);
+        ECS_SYSTEM(world, AddVelocity, EcsOnUpdate, Position, .Velocity, 
+            !Velocity);
+
+        ecs_new_w_count(world, Position, ENTITY_COUNT);
+
+        seconds += measure_merge(world);
+
+        ecs_fini(world);
+    }
+
+    bench_report("merge_add", seconds, 
+        (uint64_t)ENTITY_COUNT * BENCH_ITERATIONS);
+}
+
+void MergeStaged(void) {
+    merge_new();
+    merge_add();
+}
@@ -0,0 +1,97 @@
+#include <bench.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BENCH_AVX2
+#endif
+
+#define ENTITY_COUNT (1000000)
+#define FRAME_COUNT (100)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+typedef struct Velocity {
+    float x;
+    float y;
+} Velocity;
+
+/* Same system as the 03_move_system example */
+static
+void Move(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN(rows, Velocity, v, 2);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        p[i].x += v[i].x;
+        p[i].y += v[i].y;
+    }
+}
+
+#ifdef BENCH_AVX2
+/* Processes 4 entities per instruction. Columns are 32 byte aligned and
+ * padded to a multiple of 32 bytes, so the last (partial) lane is loaded and
+ * stored without a scalar remainder loop. */
+__attribute__((target("avx2")))
+static
+void MoveAvx2(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN(rows, Velocity, v, 2);
+
+    float *p_ptr = (float*)p;
+    float *v_ptr = (float*)v;
+    uint32_t i, count = rows->count * 2;
+
+    for (i = 0; i < count; i += 8) {
+        __m256 p_lane = _mm256_load_ps(&p_ptr[i]);
+        __m256 v_lane = _mm256_load_ps(&v_ptr[i]);
+        _mm256_store_ps(&p_ptr[i], _mm256_add_ps(p_lane, v_lane));
+    }
+}
+#endif
+
+static
+void run_move(
+    ecs_world_t *world,
+    const char *id,
+    ecs_entity_t system)
+{
+    ecs_time_t start;
+    uint32_t i;
+
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < FRAME_COUNT; i ++) {
+        ecs_run(world, system, 0, NULL);
+    }
+
+    bench_report(id, ecs_time_measure(&start), 
+        (uint64_t)ENTITY_COUNT * FRAME_COUNT);
+}
+
+void MoveSimd(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ALIGNED_COMPONENT(world, Position, 32);
+    ECS_ALIGNED_COMPONENT(world, Velocity, 32);
+    ECS_TYPE(world, Movable, Position, Velocity);
+
+    ECS_SYSTEM(world, Move, EcsManual, Position, Velocity);
+    ecs_new_w_count(world, Movable, ENTITY_COUNT);
+
+    run_move(world, "move_scalar", Move);
+
+#ifdef BENCH_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        ECS_SYSTEM(world, MoveAvx2, EcsManual, Position, Velocity);
+        run_move(world, "move_avx2", MoveAvx2);
+    } else {
+        printf("%-40s\n", "  move_avx2: AVX2 not supported");
+    }
+#endif
+
+    ecs_fini(world);
+}
@@ -0,0 +1,55 @@
+#include <bench.h>
+
+#define ENTITY_COUNT (10000)
+#define FRAME_COUNT (100)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+/* Spawn and despawn short-lived entities. Ids of deleted entities are
+ * recycled, so the largest id stays bounded by the number of live entities. */
+static
+void spawn_despawn(
+    ecs_world_t *world,
+    ecs_entity_t ecs_entity(Position))
+{
+    ecs_entity_t *entities = ecs_os_malloc(sizeof(ecs_entity_t) * ENTITY_COUNT);
+    ecs_entity_t max_index = 0;
+    ecs_time_t start;
+    uint32_t i, e;
+
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < FRAME_COUNT; i ++) {
+        for (e = 0; e < ENTITY_COUNT; e ++) {
+            entities[e] = ecs_set(world, 0, Position, {e, i});
+
+            ecs_entity_t index = entities[e] & ECS_ENTITY_INDEX_MASK;
+            if (index > max_index) {
+                max_index = index;
+            }
+        }
+        for (e = 0; e < ENTITY_COUNT; e ++) {
+            ecs_delete(world, entities[e]);
+        }
+    }
+
+    bench_report("spawn_despawn", ecs_time_measure(&start), 
+        (uint64_t)ENTITY_COUNT * FRAME_COUNT * 2);
+
+    printf("%-40s %10u\n", "  largest entity id", (uint32_t)max_index);
+
+    ecs_os_free(entities);
+}
+
+void NewDelete(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    spawn_despawn(world, ecs_entity(Position));
+
+    ecs_fini(world);
+}
@@ -0,0 +1,47 @@
+#include <bench.h>
+
+#define INSTANCE_COUNT (10000)
+#define CHILD_COUNT (12)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+/* Instantiate a prefab with children, which creates a child entity for each
+ * child of the prefab for each instance */
+static
+void instantiate(
+    const char *id,
+    uint32_t batch)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_PREFAB(world, Tank, Position);
+
+    char name[16];
+    uint32_t i;
+    for (i = 0; i < CHILD_COUNT; i ++) {
+        sprintf(name, "Part%u", i);
+        ecs_entity_t child = ecs_new_prefab(world, name, "Position");
+        ecs_set(world, child, EcsPrefab, {.parent = Tank});
+        ecs_set(world, child, Position, {i, i});
+    }
+
+    ecs_time_t start;
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < INSTANCE_COUNT; i += batch) {
+        ecs_new_instance_w_count(world, Tank, 0, batch);
+    }
+
+    bench_report(id, ecs_time_measure(&start), INSTANCE_COUNT * CHILD_COUNT);
+
+    ecs_fini(world);
+}
+
+void PrefabChildren(void) {
+    instantiate("new_instance", 1);
+    instantiate("new_instance_w_count", 100);
+}
@@ -0,0 +1,105 @@
+#include <bench.h>
+
+#define TABLE_COUNT (1000)
+#define ACTIVE_COUNT (10)
+#define ENTITY_COUNT (100)
+#define QUERY_ITERATIONS (1000)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+typedef struct Velocity {
+    float x;
+    float y;
+} Velocity;
+
+/* Create TABLE_COUNT tables with Position and a unique tag, of which only
+ * ACTIVE_COUNT tables have entities, and TABLE_COUNT tables without Position */
+static
+ecs_world_t* create_tables(
+    ecs_type_t *type_out)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    uint32_t i;
+    for (i = 0; i < TABLE_COUNT; i ++) {
+        ecs_type_t tag = ecs_type_from_entity(world, ecs_new(world, 0));
+
+        ecs_entity_t e = ecs_new(world, Velocity);
+        _ecs_add(world, e, tag);
+
+        e = ecs_new(world, Position);
+        _ecs_add(world, e, tag);
+
+        if (i % (TABLE_COUNT / ACTIVE_COUNT)) {
+            ecs_delete(world, e);
+        } else {
+            _ecs_new_w_count(world, ecs_get_type(world, e), ENTITY_COUNT - 1);
+        }
+    }
+
+    *type_out = ecs_type(Position);
+
+    return world;
+}
+
+/* Evaluate the filter against every table in the world for each iteration */
+static
+void query_filter(void) {
+    ecs_type_t type;
+    ecs_world_t *world = create_tables(&type);
+    ecs_filter_t filter = {.include = type};
+    uint64_t count = 0;
+
+    ecs_time_t start;
+    ecs_os_get_time(&start);
+
+    uint32_t i;
+    for (i = 0; i < QUERY_ITERATIONS; i ++) {
+        ecs_filter_iter_t it = ecs_filter_iter(world, &filter);
+        while (ecs_filter_next(&it)) {
+            count += it.rows.count;
+        }
+    }
+
+    bench_report("filter", ecs_time_measure(&start), count);
+
+    ecs_fini(world);
+}
+
+/* Iterate the non-empty tables cached by a query */
+static
+void query_cached(void) {
+    ecs_type_t type;
+    ecs_world_t *world = create_tables(&type);
+    ecs_query_t *query = ecs_query_new(world, &(ecs_filter_t){
+        .include = type
+    });
+
+    uint64_t count = 0;
+
+    ecs_time_t start;
+    ecs_os_get_time(&start);
+
+    uint32_t i;
+    for (i = 0; i < QUERY_ITERATIONS; i ++) {
+        ecs_query_iter_t it = ecs_query_iter(query);
+        while (ecs_query_next(&it)) {
+            count += it.rows.count;
+        }
+    }
+
+    bench_report("query", ecs_time_measure(&start), count);
+
+    ecs_fini(world);
+}
+
+void Query(void) {
+    query_filter();
+    query_cached();
+}
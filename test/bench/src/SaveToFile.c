@@ -0,0 +1,133 @@
+#include <bench.h>
+
+#define ENTITY_COUNT (500000)
+#define NAMED_COUNT (10000)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+typedef struct Velocity {
+    float x;
+    float y;
+} Velocity;
+
+/* Names are not owned by the world */
+static char names[NAMED_COUNT][32];
+
+static
+ecs_world_t* create_world(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TYPE(world, Movable, Position, Velocity);
+
+    ecs_new_w_count(world, Movable, ENTITY_COUNT);
+    ecs_new_w_count(world, Position, ENTITY_COUNT);
+
+    /* Named entities are serialized one name at a time */
+    uint32_t i;
+    for (i = 0; i < NAMED_COUNT; i ++) {
+        sprintf(names[i], "NamedEntity_%u", i);
+        ecs_entity_t e = ecs_set(world, 0, EcsId, {names[i]});
+        ecs_set(world, e, Position, {i, i});
+    }
+
+    return world;
+}
+
+/* Same as the save_to_file example, with a configurable buffer size */
+static
+size_t save_to_file(
+    ecs_world_t *world,
+    FILE *file,
+    char *buffer,
+    size_t buffer_size)
+{
+    ecs_reader_t reader = ecs_reader_init(world);
+    size_t read, total = 0;
+
+    while ((read = ecs_reader_read(buffer, buffer_size, &reader))) {
+        fwrite(buffer, 1, read, file);
+        total += read;
+    }
+
+    return total;
+}
+
+static
+void load_from_file(
+    ecs_world_t *world,
+    FILE *file,
+    char *buffer,
+    size_t buffer_size)
+{
+    ecs_writer_t writer = ecs_writer_init(world);
+    size_t read;
+
+    while ((read = fread(buffer, 1, buffer_size, file))) {
+        if (ecs_writer_write(buffer, read, &writer)) {
+            printf("error: %s\n", ecs_strerror(writer.error));
+            break;
+        }
+    }
+}
+
+/* Measure save and load throughput in bytes per second */
+static
+void save_load(
+    ecs_world_t *world,
+    const char *id,
+    size_t buffer_size)
+{
+    char *buffer = ecs_os_malloc(buffer_size);
+    char save_id[64], load_id[64];
+    double save_time = 0, load_time = 0;
+    size_t total = 0;
+    ecs_time_t start;
+    uint32_t i;
+
+    sprintf(save_id, "save_%s", id);
+    sprintf(load_id, "load_%s", id);
+
+    for (i = 0; i < BENCH_ITERATIONS; i ++) {
+        FILE *file = tmpfile();
+        if (!file) {
+            printf("error: failed to create temporary file\n");
+            break;
+        }
+
+        ecs_os_get_time(&start);
+        total = save_to_file(world, file, buffer, buffer_size);
+        save_time += ecs_time_measure(&start);
+
+        rewind(file);
+
+        ecs_world_t *loaded = ecs_init();
+        ecs_os_get_time(&start);
+        load_from_file(loaded, file, buffer, buffer_size);
+        load_time += ecs_time_measure(&start);
+        ecs_fini(loaded);
+
+        fclose(file);
+    }
+
+    /* Ops are bytes, so Mops/s is MB/s */
+    bench_report(save_id, save_time, (uint64_t)total * BENCH_ITERATIONS);
+    bench_report(load_id, load_time, (uint64_t)total * BENCH_ITERATIONS);
+
+    ecs_os_free(buffer);
+}
+
+void SaveToFile(void) {
+    ecs_world_t *world = create_world();
+
+    /* Buffer size used by the save_to_file example */
+    save_load(world, "36b_buffer", 36);
+    save_load(world, "4kb_buffer", 4096);
+    save_load(world, "64kb_buffer", 65536);
+
+    ecs_fini(world);
+}
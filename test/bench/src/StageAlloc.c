@@ -0,0 +1,73 @@
+#include <bench.h>
+
+#define ENTITY_COUNT (10000)
+#define FRAME_COUNT (100)
+#define WARMUP_FRAMES (10)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+typedef struct Velocity {
+    float x;
+    float y;
+} Velocity;
+
+static
+void Move(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN_COMPONENT(rows, Position, 1);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_set(rows->world, rows->entities[i], Position, {
+            p[i].x + 1, p[i].y + 1});
+    }
+}
+
+static
+uint64_t alloc_count(void) {
+    return ecs_os_api_malloc_count + ecs_os_api_calloc_count + 
+        ecs_os_api_realloc_count;
+}
+
+/* Set components from a system every frame, so that all values are staged and
+ * merged at the end of each frame. Once the stage has been used for a few
+ * frames, staging should not have to allocate memory. */
+static
+void set_in_progress(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, Move, EcsOnUpdate, Position);
+
+    ecs_new_w_count(world, Position, ENTITY_COUNT);
+    ecs_new_w_count(world, Velocity, ENTITY_COUNT);
+
+    uint32_t i;
+    for (i = 0; i < WARMUP_FRAMES; i ++) {
+        ecs_progress(world, 0);
+    }
+
+    uint64_t allocs = alloc_count();
+    ecs_time_t start;
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < FRAME_COUNT; i ++) {
+        ecs_progress(world, 0);
+    }
+
+    bench_report("set_in_progress", ecs_time_measure(&start), 
+        (uint64_t)ENTITY_COUNT * FRAME_COUNT);
+
+    printf("%-40s %10.2f\n", "  allocations per frame", 
+        (double)(alloc_count() - allocs) / FRAME_COUNT);
+
+    ecs_fini(world);
+}
+
+void StageAlloc(void) {
+    set_in_progress();
+}
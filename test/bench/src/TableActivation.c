@@ -0,0 +1,70 @@
+#include <bench.h>
+
+#define TABLE_COUNT (1000)
+#define SYSTEM_COUNT (8)
+#define FRAME_COUNT (100)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+static
+void Move(ecs_rows_t *rows) { }
+
+/* Create and delete one entity in each table. Every table flips between empty
+ * and non-empty twice per frame, which (de)activates it in all systems. */
+static
+void oscillate_tables(
+    ecs_world_t *world,
+    ecs_type_t *types)
+{
+    ecs_time_t start;
+    uint32_t i, t;
+
+    ecs_os_get_time(&start);
+
+    for (i = 0; i < FRAME_COUNT; i ++) {
+        for (t = 0; t < TABLE_COUNT; t ++) {
+            ecs_entity_t e = _ecs_new(world, types[t]);
+            ecs_delete(world, e);
+        }
+    }
+
+    bench_report("oscillate_tables", ecs_time_measure(&start), 
+        (uint64_t)TABLE_COUNT * FRAME_COUNT * 2 * SYSTEM_COUNT);
+}
+
+void TableActivation(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    static const char *names[SYSTEM_COUNT] = {
+        "Move_1", "Move_2", "Move_3", "Move_4", 
+        "Move_5", "Move_6", "Move_7", "Move_8"
+    };
+
+    uint32_t i;
+    for (i = 0; i < SYSTEM_COUNT; i ++) {
+        ecs_new_system(world, names[i], EcsOnUpdate, "Position", Move);
+    }
+
+    /* Give each table a unique tag, so that all tables match the systems */
+    ecs_type_t *types = ecs_os_malloc(sizeof(ecs_type_t) * TABLE_COUNT);
+    for (i = 0; i < TABLE_COUNT; i ++) {
+        ecs_entity_t tag = ecs_new(world, 0);
+        ecs_entity_t e = ecs_new(world, Position);
+        _ecs_add(world, e, ecs_type_from_entity(world, tag));
+        types[i] = ecs_get_type(world, e);
+        ecs_delete(world, e);
+    }
+
+    /* Keep one table non-empty, so that systems stay active */
+    ecs_new(world, Position);
+
+    oscillate_tables(world, types);
+
+    ecs_os_free(types);
+    ecs_fini(world);
+}
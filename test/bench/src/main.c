@@ -0,0 +1,58 @@
+#include <bench.h>
+
+typedef struct bench_t {
+    const char *id;
+    void (*function)(void);
+} bench_t;
+
+static bench_t benchmarks[] = {
+    {"AddRemove", AddRemove},
+    {"ChangedOnly", ChangedOnly},
+    {"Children", Children},
+    {"GetSet", GetSet},
+    {"Map", Map},
+    {"MemoryStats", MemoryStats},
+    {"MergeStaged", MergeStaged},
+    {"MoveSimd", MoveSimd},
+    {"NewDelete", NewDelete},
+    {"PrefabChildren", PrefabChildren},
+    {"Query", Query},
+    {"SaveToFile", SaveToFile},
+    {"StageAlloc", StageAlloc},
+    {"TableActivation", TableActivation}
+};
+
+void bench_report(
+    const char *id,
+    double seconds,
+    uint64_t ops)
+{
+    printf("%-40s %10.2f Mops/s %8.2f ns/op  (%.3fs)\n", 
+        id, ((double)ops / seconds) / 1000000.0, 
+        (seconds * 1000000000.0) / (double)ops, seconds);
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t i, count = sizeof(benchmarks) / sizeof(bench_t);
+
+    for (i = 0; i < count; i ++) {
+        /* Run all benchmarks, or only the ones passed on the command line */
+        if (argc > 1) {
+            int a;
+            for (a = 1; a < argc; a ++) {
+                if (!strcmp(argv[a], benchmarks[i].id)) {
+                    break;
+                }
+            }
+
+            if (a == argc) {
+                continue;
+            }
+        }
+
+        printf("-- %s\n", benchmarks[i].id);
+        benchmarks[i].function();
+    }
+
+    return 0;
+}
@@ -282,7 +282,7 @@ void Chunked_clear_n_chunks() {
 }
 
 void Chunked_memory_null() {
-    uint32_t allocd = 0, used = 0; 
+    uint64_t allocd = 0, used = 0; 
     ecs_chunked_memory(NULL, &allocd, &used);
     test_int(allocd, 0);
     test_int(used, 0);
@@ -75,21 +75,22 @@ void Map_set_rehash() {
     ecs_map_t *map = ecs_map_new(8, sizeof(char*));
     fill_map(map);
 
-    test_int(ecs_map_bucket_count(map), 10);
+    /* Bucket count is a power of 2 with room for 8 elements */
+    test_int(ecs_map_bucket_count(map), 16);
 
     int i;
-    for (i = 5; i < 10; i ++) {
+    for (i = 5; i < 20; i ++) {
         ecs_map_set(map, i, &(char*){"zzz"});
     }
 
-    test_int(ecs_map_bucket_count(map), 20);
+    test_int(ecs_map_bucket_count(map), 32);
     test_str(*(char**)ecs_map_get_ptr(map, 1), "hello");
     test_str(*(char**)ecs_map_get_ptr(map, 2), "world");
     test_str(*(char**)ecs_map_get_ptr(map, 3), "foo");
     test_str(*(char**)ecs_map_get_ptr(map, 4), "bar");
     test_str(*(char**)ecs_map_get_ptr(map, 5), "zzz");
     test_str(*(char**)ecs_map_get_ptr(map, 6), "zzz");
-    test_str(*(char**)ecs_map_get_ptr(map, 7), "zzz");
+    test_str(*(char**)ecs_map_get_ptr(map, 19), "zzz");
 
     ecs_map_free(map);
 }
@@ -149,20 +150,25 @@ void Map_iter() {
     ecs_map_t *map = ecs_map_new(16, sizeof(char*));
     fill_map(map);
 
-    ecs_map_iter_t it = ecs_map_iter(map);
-    test_assert(ecs_map_hasnext(&it) == true);
-    test_str(*(char**)ecs_map_next(&it), "hello");
-
-    test_assert(ecs_map_hasnext(&it) == true);
-    test_str(*(char**)ecs_map_next(&it), "world");
-
-    test_assert(ecs_map_hasnext(&it) == true);
-    test_str(*(char**)ecs_map_next(&it), "foo");
+    /* Elements are not iterated in insertion order */
+    bool found[5] = {false};
+    int count = 0;
 
-    test_assert(ecs_map_hasnext(&it) == true);
-    test_str(*(char**)ecs_map_next(&it), "bar");
+    ecs_map_iter_t it = ecs_map_iter(map);
+    while (ecs_map_hasnext(&it)) {
+        uint64_t key;
+        char *value = *(char**)ecs_map_next_w_key(&it, &key);
+        test_assert(key >= 1 && key <= 4);
+        test_assert(!found[key]);
+        test_str(value, elems[key - 1].value);
+        found[key] = true;
+        count ++;
+    }
 
+    test_int(count, 4);
     test_assert(ecs_map_hasnext(&it) == false);
+
+    ecs_map_free(map);
 }
 
 void Map_iter_empty() {
@@ -222,7 +228,108 @@ void Map_grow() {
 
     test_int(malloc_count, 0);
 
+    /* Fill up remaining slots until the map has to grow */
+    int count = ecs_map_bucket_count(map) - ecs_map_bucket_count(map) / 8;
+    for(; i < count; i ++) {
+        ecs_map_set(map, i, &v);
+    }
+
+    test_int(malloc_count, 0);
+
     ecs_map_set(map, i, &v);
 
-    test_int(malloc_count, 2);
+    test_int(malloc_count, 1);
+
+    ecs_map_free(map);
+}
+
+void Map_remove_reinsert() {
+    ecs_map_t *map = ecs_map_new(16, sizeof(char*));
+    fill_map(map);
+
+    /* Removing and adding keys should reuse slots instead of growing */
+    uint32_t bucket_count = ecs_map_bucket_count(map);
+
+    int i;
+    for (i = 0; i < 1000; i ++) {
+        ecs_map_set(map, 100 + i, &(char*){"zzz"});
+        test_assert(ecs_map_remove(map, 100 + i) == 0);
+    }
+
+    test_int(ecs_map_bucket_count(map), bucket_count);
+    test_int(ecs_map_count(map), 4);
+    test_str(*(char**)ecs_map_get_ptr(map, 1), "hello");
+    test_str(*(char**)ecs_map_get_ptr(map, 4), "bar");
+    test_assert(ecs_map_get_ptr(map, 100) == NULL);
+
+    ecs_map_free(map);
+}
+
+void Map_iter_after_remove() {
+    ecs_map_t *map = ecs_map_new(16, sizeof(char*));
+    fill_map(map);
+
+    test_assert(ecs_map_remove(map, 2) == 0);
+    test_assert(ecs_map_remove(map, 4) == 0);
+
+    int count = 0;
+    ecs_map_iter_t it = ecs_map_iter(map);
+    while (ecs_map_hasnext(&it)) {
+        uint64_t key;
+        ecs_map_next_w_key(&it, &key);
+        test_assert(key == 1 || key == 3);
+        count ++;
+    }
+
+    test_int(count, 2);
+
+    ecs_map_free(map);
+}
+
+void Map_set_remove_many() {
+    ecs_map_t *map = ecs_map_new(0, sizeof(uint64_t));
+
+    uint64_t i;
+    for (i = 0; i < 10000; i ++) {
+        uint64_t value = i * 2;
+        ecs_map_set(map, i << 4, &value);
+    }
+
+    test_int(ecs_map_count(map), 10000);
+
+    for (i = 0; i < 10000; i += 2) {
+        test_assert(ecs_map_remove(map, i << 4) == 0);
+    }
+
+    test_int(ecs_map_count(map), 5000);
+
+    for (i = 0; i < 10000; i ++) {
+        uint64_t *value = ecs_map_get_ptr(map, i << 4);
+        if (i % 2) {
+            test_assert(value != NULL);
+            test_int(*value, i * 2);
+        } else {
+            test_assert(value == NULL);
+        }
+    }
+
+    ecs_map_free(map);
+}
+
+void Map_clear() {
+    ecs_map_t *map = ecs_map_new(16, sizeof(char*));
+    fill_map(map);
+
+    ecs_map_clear(map);
+    test_int(ecs_map_count(map), 0);
+    test_assert(ecs_map_get_ptr(map, 1) == NULL);
+
+    ecs_map_iter_t it = ecs_map_iter(map);
+    test_assert(!ecs_map_hasnext(&it));
+
+    fill_map(map);
+    test_int(ecs_map_count(map), 4);
+    test_str(*(char**)ecs_map_get_ptr(map, 3), "foo");
+
+    ecs_map_free(map);
 }
@@ -328,3 +328,54 @@ void Vector_pop_elements() {
 
     ecs_vector_free(array);
 }
+
+static
+ecs_vector_params_t aligned_params = {
+    .element_size = sizeof(int),
+    .alignment = 64
+};
+
+void Vector_add_aligned() {
+    ecs_vector_t *array = NULL;
+
+    int i;
+    for (i = 0; i < 1000; i ++) {
+        int *elem = ecs_vector_add(&array, &aligned_params);
+        *elem = i;
+        test_int((uintptr_t)ecs_vector_first(array) % 64, 0);
+    }
+
+    int *elems = ecs_vector_first(array);
+    for (i = 0; i < 1000; i ++) {
+        test_int(elems[i], i);
+    }
+
+    ecs_vector_reclaim(&array, &aligned_params);
+    test_int((uintptr_t)ecs_vector_first(array) % 64, 0);
+    test_int(ecs_vector_count(array), 1000);
+
+    ecs_vector_free(array);
+}
+
+void Vector_copy_aligned() {
+    ecs_vector_t *array = NULL;
+
+    int i;
+    for (i = 0; i < 10; i ++) {
+        int *elem = ecs_vector_add(&array, &aligned_params);
+        *elem = i;
+    }
+
+    /* Copy keeps the alignment of the source */
+    ecs_vector_t *copy = ecs_vector_copy(array, &arr_params);
+    test_int((uintptr_t)ecs_vector_first(copy) % 64, 0);
+    test_int(ecs_vector_count(copy), 10);
+
+    int *elems = ecs_vector_first(copy);
+    for (i = 0; i < 10; i ++) {
+        test_int(elems[i], i);
+    }
+
+    ecs_vector_free(array);
+    ecs_vector_free(copy);
+}
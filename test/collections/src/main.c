@@ -33,6 +33,8 @@ void Vector_size_of_null(void);
 void Vector_remove_index_w_move(void);
 void Vector_set_size_smaller_than_count(void);
 void Vector_pop_elements(void);
+void Vector_add_aligned(void);
+void Vector_copy_aligned(void);
 
 // Testsuite 'Map'
 void Map_setup(void);
@@ -52,6 +54,10 @@ void Map_remove(void);
 void Map_remove_empty(void);
 void Map_remove_unknown(void);
 void Map_grow(void);
+void Map_remove_reinsert(void);
+void Map_iter_after_remove(void);
+void Map_set_remove_many(void);
+void Map_clear(void);
 
 // Testsuite 'Chunked'
 void Chunked_setup(void);
@@ -74,7 +80,7 @@ void Chunked_memory_null(void);
 static bake_test_suite suites[] = {
     {
         .id = "Vector",
-        .testcase_count = 23,
+        .testcase_count = 25,
         .setup = Vector_setup,
         .testcases = (bake_test_case[]){
             {
@@ -168,12 +174,20 @@ static bake_test_suite suites[] = {
             {
                 .id = "pop_elements",
                 .function = Vector_pop_elements
+            },
+            {
+                .id = "add_aligned",
+                .function = Vector_add_aligned
+            },
+            {
+                .id = "copy_aligned",
+                .function = Vector_copy_aligned
             }
         }
     },
     {
         .id = "Map",
-        .testcase_count = 16,
+        .testcase_count = 20,
         .setup = Map_setup,
         .testcases = (bake_test_case[]){
             {
@@ -239,6 +253,22 @@ static bake_test_suite suites[] = {
             {
                 .id = "grow",
                 .function = Map_grow
+            },
+            {
+                .id = "remove_reinsert",
+                .function = Map_remove_reinsert
+            },
+            {
+                .id = "iter_after_remove",
+                .function = Map_iter_after_remove
+            },
+            {
+                .id = "set_remove_many",
+                .function = Map_set_remove_many
+            },
+            {
+                .id = "clear",
+                .function = Map_clear
             }
         }
     },